@@ -20,6 +20,72 @@
  */
 #include "xelf.h"
 
+static constexpr XBINARY_DEF::STRUCT_FIELD _FIELDS_ELF32_SHDR[] = {
+    XBINARY_STRUCT_FIELD(XELF_DEF::Elf32_Shdr, sh_name),
+    XBINARY_STRUCT_FIELD(XELF_DEF::Elf32_Shdr, sh_type),
+    XBINARY_STRUCT_FIELD(XELF_DEF::Elf32_Shdr, sh_flags),
+    XBINARY_STRUCT_FIELD(XELF_DEF::Elf32_Shdr, sh_addr),
+    XBINARY_STRUCT_FIELD(XELF_DEF::Elf32_Shdr, sh_offset),
+    XBINARY_STRUCT_FIELD(XELF_DEF::Elf32_Shdr, sh_size),
+    XBINARY_STRUCT_FIELD(XELF_DEF::Elf32_Shdr, sh_link),
+    XBINARY_STRUCT_FIELD(XELF_DEF::Elf32_Shdr, sh_info),
+    XBINARY_STRUCT_FIELD(XELF_DEF::Elf32_Shdr, sh_addralign),
+    XBINARY_STRUCT_FIELD(XELF_DEF::Elf32_Shdr, sh_entsize),
+};
+
+static constexpr XBINARY_DEF::STRUCT_FIELD _FIELDS_ELF64_SHDR[] = {
+    XBINARY_STRUCT_FIELD(XELF_DEF::Elf64_Shdr, sh_name),
+    XBINARY_STRUCT_FIELD(XELF_DEF::Elf64_Shdr, sh_type),
+    XBINARY_STRUCT_FIELD(XELF_DEF::Elf64_Shdr, sh_flags),
+    XBINARY_STRUCT_FIELD(XELF_DEF::Elf64_Shdr, sh_addr),
+    XBINARY_STRUCT_FIELD(XELF_DEF::Elf64_Shdr, sh_offset),
+    XBINARY_STRUCT_FIELD(XELF_DEF::Elf64_Shdr, sh_size),
+    XBINARY_STRUCT_FIELD(XELF_DEF::Elf64_Shdr, sh_link),
+    XBINARY_STRUCT_FIELD(XELF_DEF::Elf64_Shdr, sh_info),
+    XBINARY_STRUCT_FIELD(XELF_DEF::Elf64_Shdr, sh_addralign),
+    XBINARY_STRUCT_FIELD(XELF_DEF::Elf64_Shdr, sh_entsize),
+};
+
+static constexpr XBINARY_DEF::STRUCT_FIELD _FIELDS_ELF32_PHDR[] = {
+    XBINARY_STRUCT_FIELD(XELF_DEF::Elf32_Phdr, p_type),
+    XBINARY_STRUCT_FIELD(XELF_DEF::Elf32_Phdr, p_offset),
+    XBINARY_STRUCT_FIELD(XELF_DEF::Elf32_Phdr, p_vaddr),
+    XBINARY_STRUCT_FIELD(XELF_DEF::Elf32_Phdr, p_paddr),
+    XBINARY_STRUCT_FIELD(XELF_DEF::Elf32_Phdr, p_filesz),
+    XBINARY_STRUCT_FIELD(XELF_DEF::Elf32_Phdr, p_memsz),
+    XBINARY_STRUCT_FIELD(XELF_DEF::Elf32_Phdr, p_flags),
+    XBINARY_STRUCT_FIELD(XELF_DEF::Elf32_Phdr, p_align),
+};
+
+static constexpr XBINARY_DEF::STRUCT_FIELD _FIELDS_ELF64_PHDR[] = {
+    XBINARY_STRUCT_FIELD(XELF_DEF::Elf64_Phdr, p_type),
+    XBINARY_STRUCT_FIELD(XELF_DEF::Elf64_Phdr, p_flags),
+    XBINARY_STRUCT_FIELD(XELF_DEF::Elf64_Phdr, p_offset),
+    XBINARY_STRUCT_FIELD(XELF_DEF::Elf64_Phdr, p_vaddr),
+    XBINARY_STRUCT_FIELD(XELF_DEF::Elf64_Phdr, p_paddr),
+    XBINARY_STRUCT_FIELD(XELF_DEF::Elf64_Phdr, p_filesz),
+    XBINARY_STRUCT_FIELD(XELF_DEF::Elf64_Phdr, p_memsz),
+    XBINARY_STRUCT_FIELD(XELF_DEF::Elf64_Phdr, p_align),
+};
+
+static constexpr XBINARY_DEF::STRUCT_FIELD _FIELDS_ELF32_SYM[] = {
+    XBINARY_STRUCT_FIELD(XELF_DEF::Elf32_Sym, st_name),
+    XBINARY_STRUCT_FIELD(XELF_DEF::Elf32_Sym, st_value),
+    XBINARY_STRUCT_FIELD(XELF_DEF::Elf32_Sym, st_size),
+    XBINARY_STRUCT_FIELD(XELF_DEF::Elf32_Sym, st_info),
+    XBINARY_STRUCT_FIELD(XELF_DEF::Elf32_Sym, st_other),
+    XBINARY_STRUCT_FIELD(XELF_DEF::Elf32_Sym, st_shndx),
+};
+
+static constexpr XBINARY_DEF::STRUCT_FIELD _FIELDS_ELF64_SYM[] = {
+    XBINARY_STRUCT_FIELD(XELF_DEF::Elf64_Sym, st_name),
+    XBINARY_STRUCT_FIELD(XELF_DEF::Elf64_Sym, st_info),
+    XBINARY_STRUCT_FIELD(XELF_DEF::Elf64_Sym, st_other),
+    XBINARY_STRUCT_FIELD(XELF_DEF::Elf64_Sym, st_shndx),
+    XBINARY_STRUCT_FIELD(XELF_DEF::Elf64_Sym, st_value),
+    XBINARY_STRUCT_FIELD(XELF_DEF::Elf64_Sym, st_size),
+};
+
 XELF::XELF(QIODevice *pDevice, bool bIsImage, XADDR nModuleAddress) : XBinary(pDevice, bIsImage, nModuleAddress)
 {
 }
@@ -1469,12 +1535,18 @@ QList<XELF_DEF::Elf32_Shdr> XELF::getElf32_ShdrList(qint32 nLimit)
             nNumberOfSections = qMin((quint32)nLimit, nNumberOfSections);
         }
 
-        for (quint32 i = 0; i < nNumberOfSections; i++) {
-            XELF_DEF::Elf32_Shdr record = _readElf32_Shdr(nOffset, bIsBigEndian);
+        // The number can come from sh_size of section 0; no more headers than the file holds
+        qint64 nSize = getSize();
+        qint64 nMaxNumberOfSections = ((quint64)nOffset < (quint64)nSize) ? ((nSize - (qint64)nOffset) / (qint64)sizeof(XELF_DEF::Elf32_Shdr)) : 0;
 
-            listResult.append(record);
+        nNumberOfSections = (quint32)qMin((qint64)nNumberOfSections, nMaxNumberOfSections);
+
+        QVector<XELF_DEF::Elf32_Shdr> listRecords(nNumberOfSections);
 
-            nOffset += sizeof(XELF_DEF::Elf32_Shdr);
+        read_records(nOffset, listRecords.data(), nNumberOfSections, _FIELDS_ELF32_SHDR, bIsBigEndian);
+
+        for (quint32 i = 0; i < nNumberOfSections; i++) {
+            listResult.append(listRecords.at(i));
         }
     }
 
@@ -1496,12 +1568,18 @@ QList<XELF_DEF::Elf64_Shdr> XELF::getElf64_ShdrList(qint32 nLimit)
             nNumberOfSections = qMin((quint32)nLimit, nNumberOfSections);
         }
 
-        for (quint32 i = 0; i < nNumberOfSections; i++) {
-            XELF_DEF::Elf64_Shdr record = _readElf64_Shdr(nOffset, bIsBigEndian);
+        // The number can come from sh_size of section 0; no more headers than the file holds
+        qint64 nSize = getSize();
+        qint64 nMaxNumberOfSections = ((quint64)nOffset < (quint64)nSize) ? ((nSize - (qint64)nOffset) / (qint64)sizeof(XELF_DEF::Elf64_Shdr)) : 0;
 
-            listResult.append(record);
+        nNumberOfSections = (quint32)qMin((qint64)nNumberOfSections, nMaxNumberOfSections);
 
-            nOffset += sizeof(XELF_DEF::Elf64_Shdr);
+        QVector<XELF_DEF::Elf64_Shdr> listRecords(nNumberOfSections);
+
+        read_records(nOffset, listRecords.data(), nNumberOfSections, _FIELDS_ELF64_SHDR, bIsBigEndian);
+
+        for (quint32 i = 0; i < nNumberOfSections; i++) {
+            listResult.append(listRecords.at(i));
         }
     }
 
@@ -1595,38 +1673,12 @@ XELF_DEF::Elf64_Shdr XELF::getElf64_Shdr(quint32 nIndex)
 
 XELF_DEF::Elf32_Shdr XELF::_readElf32_Shdr(qint64 nOffset, bool bIsBigEndian)
 {
-    XELF_DEF::Elf32_Shdr result = {};
-
-    result.sh_name = read_uint32(nOffset + offsetof(XELF_DEF::Elf32_Shdr, sh_name), bIsBigEndian);
-    result.sh_type = read_uint32(nOffset + offsetof(XELF_DEF::Elf32_Shdr, sh_type), bIsBigEndian);
-    result.sh_flags = read_uint32(nOffset + offsetof(XELF_DEF::Elf32_Shdr, sh_flags), bIsBigEndian);
-    result.sh_addr = read_uint32(nOffset + offsetof(XELF_DEF::Elf32_Shdr, sh_addr), bIsBigEndian);
-    result.sh_offset = read_uint32(nOffset + offsetof(XELF_DEF::Elf32_Shdr, sh_offset), bIsBigEndian);
-    result.sh_size = read_uint32(nOffset + offsetof(XELF_DEF::Elf32_Shdr, sh_size), bIsBigEndian);
-    result.sh_link = read_uint32(nOffset + offsetof(XELF_DEF::Elf32_Shdr, sh_link), bIsBigEndian);
-    result.sh_info = read_uint32(nOffset + offsetof(XELF_DEF::Elf32_Shdr, sh_info), bIsBigEndian);
-    result.sh_addralign = read_uint32(nOffset + offsetof(XELF_DEF::Elf32_Shdr, sh_addralign), bIsBigEndian);
-    result.sh_entsize = read_uint32(nOffset + offsetof(XELF_DEF::Elf32_Shdr, sh_entsize), bIsBigEndian);
-
-    return result;
+    return read_record<XELF_DEF::Elf32_Shdr>(nOffset, _FIELDS_ELF32_SHDR, bIsBigEndian);
 }
 
 XELF_DEF::Elf64_Shdr XELF::_readElf64_Shdr(qint64 nOffset, bool bIsBigEndian)
 {
-    XELF_DEF::Elf64_Shdr result = {};
-
-    result.sh_name = read_uint32(nOffset + offsetof(XELF_DEF::Elf64_Shdr, sh_name), bIsBigEndian);
-    result.sh_type = read_uint32(nOffset + offsetof(XELF_DEF::Elf64_Shdr, sh_type), bIsBigEndian);
-    result.sh_flags = read_uint64(nOffset + offsetof(XELF_DEF::Elf64_Shdr, sh_flags), bIsBigEndian);
-    result.sh_addr = read_uint64(nOffset + offsetof(XELF_DEF::Elf64_Shdr, sh_addr), bIsBigEndian);
-    result.sh_offset = read_uint64(nOffset + offsetof(XELF_DEF::Elf64_Shdr, sh_offset), bIsBigEndian);
-    result.sh_size = read_uint64(nOffset + offsetof(XELF_DEF::Elf64_Shdr, sh_size), bIsBigEndian);
-    result.sh_link = read_uint32(nOffset + offsetof(XELF_DEF::Elf64_Shdr, sh_link), bIsBigEndian);
-    result.sh_info = read_uint32(nOffset + offsetof(XELF_DEF::Elf64_Shdr, sh_info), bIsBigEndian);
-    result.sh_addralign = read_uint64(nOffset + offsetof(XELF_DEF::Elf64_Shdr, sh_addralign), bIsBigEndian);
-    result.sh_entsize = read_uint64(nOffset + offsetof(XELF_DEF::Elf64_Shdr, sh_entsize), bIsBigEndian);
-
-    return result;
+    return read_record<XELF_DEF::Elf64_Shdr>(nOffset, _FIELDS_ELF64_SHDR, bIsBigEndian);
 }
 
 quint32 XELF::getElf32_Shdr_name(quint32 nIndex)
@@ -2351,12 +2403,12 @@ QList<XELF_DEF::Elf32_Phdr> XELF::getElf32_PhdrList(qint32 nLimit)
     quint32 nOffset = getHdr32_phoff();
     bool bIsBigEndian = isBigEndian();
 
-    for (quint32 i = 0; i < nNumberOfProgramms; i++) {
-        XELF_DEF::Elf32_Phdr record = _readElf32_Phdr(nOffset, bIsBigEndian);
+    QVector<XELF_DEF::Elf32_Phdr> listRecords(nNumberOfProgramms);
 
-        result.append(record);
+    read_records(nOffset, listRecords.data(), nNumberOfProgramms, _FIELDS_ELF32_PHDR, bIsBigEndian);
 
-        nOffset += sizeof(XELF_DEF::Elf32_Phdr);
+    for (quint32 i = 0; i < nNumberOfProgramms; i++) {
+        result.append(listRecords.at(i));
     }
 
     return result;
@@ -2375,12 +2427,12 @@ QList<XELF_DEF::Elf64_Phdr> XELF::getElf64_PhdrList(qint32 nLimit)
     quint64 nOffset = getHdr64_phoff();
     bool bIsBigEndian = isBigEndian();
 
-    for (quint32 i = 0; i < nNumberOfProgramms; i++) {
-        XELF_DEF::Elf64_Phdr record = _readElf64_Phdr(nOffset, bIsBigEndian);
+    QVector<XELF_DEF::Elf64_Phdr> listRecords(nNumberOfProgramms);
 
-        result.append(record);
+    read_records(nOffset, listRecords.data(), nNumberOfProgramms, _FIELDS_ELF64_PHDR, bIsBigEndian);
 
-        nOffset += sizeof(XELF_DEF::Elf64_Phdr);
+    for (quint32 i = 0; i < nNumberOfProgramms; i++) {
+        result.append(listRecords.at(i));
     }
 
     return result;
@@ -2469,34 +2521,12 @@ XELF_DEF::Elf64_Phdr XELF::getElf64_Phdr(quint32 nIndex)
 
 XELF_DEF::Elf32_Phdr XELF::_readElf32_Phdr(qint64 nOffset, bool bIsBigEndian)
 {
-    XELF_DEF::Elf32_Phdr result = {};
-
-    result.p_type = read_uint32(nOffset + offsetof(XELF_DEF::Elf32_Phdr, p_type), bIsBigEndian);
-    result.p_offset = read_uint32(nOffset + offsetof(XELF_DEF::Elf32_Phdr, p_offset), bIsBigEndian);
-    result.p_vaddr = read_uint32(nOffset + offsetof(XELF_DEF::Elf32_Phdr, p_vaddr), bIsBigEndian);
-    result.p_paddr = read_uint32(nOffset + offsetof(XELF_DEF::Elf32_Phdr, p_paddr), bIsBigEndian);
-    result.p_filesz = read_uint32(nOffset + offsetof(XELF_DEF::Elf32_Phdr, p_filesz), bIsBigEndian);
-    result.p_memsz = read_uint32(nOffset + offsetof(XELF_DEF::Elf32_Phdr, p_memsz), bIsBigEndian);
-    result.p_flags = read_uint32(nOffset + offsetof(XELF_DEF::Elf32_Phdr, p_flags), bIsBigEndian);
-    result.p_align = read_uint32(nOffset + offsetof(XELF_DEF::Elf32_Phdr, p_align), bIsBigEndian);
-
-    return result;
+    return read_record<XELF_DEF::Elf32_Phdr>(nOffset, _FIELDS_ELF32_PHDR, bIsBigEndian);
 }
 
 XELF_DEF::Elf64_Phdr XELF::_readElf64_Phdr(qint64 nOffset, bool bIsBigEndian)
 {
-    XELF_DEF::Elf64_Phdr result = {};
-
-    result.p_type = read_uint32(nOffset + offsetof(XELF_DEF::Elf64_Phdr, p_type), bIsBigEndian);
-    result.p_offset = read_uint64(nOffset + offsetof(XELF_DEF::Elf64_Phdr, p_offset), bIsBigEndian);
-    result.p_vaddr = read_uint64(nOffset + offsetof(XELF_DEF::Elf64_Phdr, p_vaddr), bIsBigEndian);
-    result.p_paddr = read_uint64(nOffset + offsetof(XELF_DEF::Elf64_Phdr, p_paddr), bIsBigEndian);
-    result.p_filesz = read_uint64(nOffset + offsetof(XELF_DEF::Elf64_Phdr, p_filesz), bIsBigEndian);
-    result.p_memsz = read_uint64(nOffset + offsetof(XELF_DEF::Elf64_Phdr, p_memsz), bIsBigEndian);
-    result.p_flags = read_uint32(nOffset + offsetof(XELF_DEF::Elf64_Phdr, p_flags), bIsBigEndian);
-    result.p_align = read_uint64(nOffset + offsetof(XELF_DEF::Elf64_Phdr, p_align), bIsBigEndian);
-
-    return result;
+    return read_record<XELF_DEF::Elf64_Phdr>(nOffset, _FIELDS_ELF64_PHDR, bIsBigEndian);
 }
 
 quint32 XELF::getElf32_Phdr_type(quint32 nIndex)
@@ -3419,7 +3449,7 @@ XELF::NOTE XELF::getNote(QList<NOTE> *pListNotes, quint32 nType, const QString &
 
 QList<XELF::TAG_STRUCT> XELF::getTagStructs()
 {
-    _MEMORY_MAP memoryMap = getMemoryMap();
+    _MEMORY_MAP memoryMap = getCachedMemoryMap();
     QList<XELF_DEF::Elf_Phdr> listProgramHeaders = getElf_PhdrList(1000);
 
     return getTagStructs(&listProgramHeaders, &memoryMap);
@@ -3566,7 +3596,7 @@ void XELF::setDynamicArrayValue(qint64 nOffset, qint64 nValue)
 
 XBinary::OFFSETSIZE XELF::getStringTable()
 {
-    _MEMORY_MAP memoryMap = getMemoryMap();
+    _MEMORY_MAP memoryMap = getCachedMemoryMap();
     QList<TAG_STRUCT> listStructs = getTagStructs();
 
     return getStringTable(&memoryMap, &listStructs);
@@ -3594,7 +3624,7 @@ XBinary::OFFSETSIZE XELF::getStringTable(XBinary::_MEMORY_MAP *pMemoryMap, QList
 
 QList<QString> XELF::getLibraries()
 {
-    _MEMORY_MAP memoryMap = getMemoryMap();
+    _MEMORY_MAP memoryMap = getCachedMemoryMap();
     QList<TAG_STRUCT> listTagStructs = getTagStructs();
 
     return getLibraries(&memoryMap, &listTagStructs);
@@ -3633,7 +3663,7 @@ QList<QString> XELF::getLibraries(_MEMORY_MAP *pMemoryMap, QList<XELF::TAG_STRUC
 
 XBinary::OS_STRING XELF::getRunPath()
 {
-    _MEMORY_MAP memoryMap = getMemoryMap();
+    _MEMORY_MAP memoryMap = getCachedMemoryMap();
     QList<TAG_STRUCT> listTagStructs = getTagStructs();
 
     return getRunPath(&memoryMap, &listTagStructs);
@@ -4165,6 +4195,9 @@ XBinary::_MEMORY_MAP XELF::getMemoryMap(MAPMODE mapMode, PDSTRUCT *pPdStruct)
         result.listRecords.append(record);
     }
 
+    // Objects can have thousands of sections
+    _prepareMemoryIndex(&result);
+
     return result;
 }
 
@@ -4344,6 +4377,36 @@ XBinary::FILEFORMATINFO XELF::getFileFormatInfo(PDSTRUCT *pPdStruct)
     result.bIsValid = isValid(pPdStruct);
 
     if (result.bIsValid) {
+        if (isPrefetchEnabled()) {
+            // Program and section header tables are read early; ask the OS to load them in one pass
+            QList<OFFSETSIZE> listRegions;
+
+            OFFSETSIZE osPhdr = {};
+            OFFSETSIZE osShdr = {};
+
+            if (is64()) {
+                osPhdr.nOffset = getHdr64_phoff();
+                osPhdr.nSize = (qint64)getHdr64_phentsize() * getHdr64_phnum();
+                osShdr.nOffset = getHdr64_shoff();
+                osShdr.nSize = (qint64)getHdr64_shentsize() * getHdr64_shnum();
+            } else {
+                osPhdr.nOffset = getHdr32_phoff();
+                osPhdr.nSize = (qint64)getHdr32_phentsize() * getHdr32_phnum();
+                osShdr.nOffset = getHdr32_shoff();
+                osShdr.nSize = (qint64)getHdr32_shentsize() * getHdr32_shnum();
+            }
+
+            if (osPhdr.nSize > 0) {
+                listRegions.append(osPhdr);
+            }
+
+            if (osShdr.nSize > 0) {
+                listRegions.append(osShdr);
+            }
+
+            prefetch(listRegions);
+        }
+
         result.nSize = getSize();
         result.fileType = getFileType();
         result.sExt = getFileFormatExt();
@@ -4397,7 +4460,7 @@ XBinary::FILEFORMATINFO XELF::getFileFormatInfo(PDSTRUCT *pPdStruct)
             sInterpteter = getProgramInterpreterName(&listSectionRecords).sString;
         }
 
-        XBinary::_MEMORY_MAP memoryMap = getMemoryMap();
+        XBinary::_MEMORY_MAP memoryMap = getCachedMemoryMap();
         QList<TAG_STRUCT> listTagStructs = getTagStructs(&listProgramHeaders, &memoryMap);
 
         QList<QString> listLibraries = getLibraries(&memoryMap, &listTagStructs);
@@ -4926,8 +4989,18 @@ QList<XELF_DEF::Elf32_Sym> XELF::getElf32_SymList(qint64 nOffset, qint64 nSize)
 
     bool bIsBigEndian = isBigEndian();
 
+    VIEW view = getView(nOffset, nSize);
+
     while (nSize > 0) {
-        XELF_DEF::Elf32_Sym record = _readElf32_Sym(nOffset, bIsBigEndian);
+        XELF_DEF::Elf32_Sym record = {};
+
+        const char *pRecord = getViewData(&view, nOffset, sizeof(XELF_DEF::Elf32_Sym));
+
+        if (pRecord) {
+            record = _readElf32_Sym(pRecord, bIsBigEndian);
+        } else {
+            record = _readElf32_Sym(nOffset, bIsBigEndian);
+        }
 
         listResult.append(record);
 
@@ -4944,8 +5017,18 @@ QList<XELF_DEF::Elf64_Sym> XELF::getElf64_SymList(qint64 nOffset, qint64 nSize)
 
     bool bIsBigEndian = isBigEndian();
 
+    VIEW view = getView(nOffset, nSize);
+
     while (nSize > 0) {
-        XELF_DEF::Elf64_Sym record = _readElf64_Sym(nOffset, bIsBigEndian);
+        XELF_DEF::Elf64_Sym record = {};
+
+        const char *pRecord = getViewData(&view, nOffset, sizeof(XELF_DEF::Elf64_Sym));
+
+        if (pRecord) {
+            record = _readElf64_Sym(pRecord, bIsBigEndian);
+        } else {
+            record = _readElf64_Sym(nOffset, bIsBigEndian);
+        }
 
         listResult.append(record);
 
@@ -4963,11 +5046,15 @@ QList<XELF_DEF::Elf_Sym> XELF::getElf_SymList(qint64 nOffset, qint64 nSize)
     bool bIsBigEndian = isBigEndian();
     bool bIs64 = is64();
 
+    VIEW view = getView(nOffset, nSize);
+
     while (nSize > 0) {
         XELF_DEF::Elf_Sym record = {};
 
         if (bIs64) {
-            XELF_DEF::Elf64_Sym _record = _readElf64_Sym(nOffset, bIsBigEndian);
+            const char *pRecord = getViewData(&view, nOffset, sizeof(XELF_DEF::Elf64_Sym));
+
+            XELF_DEF::Elf64_Sym _record = pRecord ? _readElf64_Sym(pRecord, bIsBigEndian) : _readElf64_Sym(nOffset, bIsBigEndian);
 
             record.st_name = _record.st_name;
             record.st_info = _record.st_info;
@@ -4979,7 +5066,9 @@ QList<XELF_DEF::Elf_Sym> XELF::getElf_SymList(qint64 nOffset, qint64 nSize)
             nOffset += sizeof(XELF_DEF::Elf64_Sym);
             nSize -= sizeof(XELF_DEF::Elf64_Sym);
         } else {
-            XELF_DEF::Elf32_Sym _record = _readElf32_Sym(nOffset, bIsBigEndian);
+            const char *pRecord = getViewData(&view, nOffset, sizeof(XELF_DEF::Elf32_Sym));
+
+            XELF_DEF::Elf32_Sym _record = pRecord ? _readElf32_Sym(pRecord, bIsBigEndian) : _readElf32_Sym(nOffset, bIsBigEndian);
 
             record.st_name = _record.st_name;
             record.st_info = _record.st_info;
@@ -5000,30 +5089,22 @@ QList<XELF_DEF::Elf_Sym> XELF::getElf_SymList(qint64 nOffset, qint64 nSize)
 
 XELF_DEF::Elf32_Sym XELF::_readElf32_Sym(qint64 nOffset, bool bIsBigEndian)
 {
-    XELF_DEF::Elf32_Sym result = {};
-
-    result.st_name = read_uint32(nOffset + offsetof(XELF_DEF::Elf32_Sym, st_name), bIsBigEndian);
-    result.st_value = read_uint32(nOffset + offsetof(XELF_DEF::Elf32_Sym, st_value), bIsBigEndian);
-    result.st_size = read_uint32(nOffset + offsetof(XELF_DEF::Elf32_Sym, st_size), bIsBigEndian);
-    result.st_info = read_uint8(nOffset + offsetof(XELF_DEF::Elf32_Sym, st_info));
-    result.st_other = read_uint8(nOffset + offsetof(XELF_DEF::Elf32_Sym, st_other));
-    result.st_shndx = read_uint16(nOffset + offsetof(XELF_DEF::Elf32_Sym, st_shndx), bIsBigEndian);
-
-    return result;
+    return read_record<XELF_DEF::Elf32_Sym>(nOffset, _FIELDS_ELF32_SYM, bIsBigEndian);
 }
 
 XELF_DEF::Elf64_Sym XELF::_readElf64_Sym(qint64 nOffset, bool bIsBigEndian)
 {
-    XELF_DEF::Elf64_Sym result = {};
+    return read_record<XELF_DEF::Elf64_Sym>(nOffset, _FIELDS_ELF64_SYM, bIsBigEndian);
+}
 
-    result.st_name = read_uint32(nOffset + offsetof(XELF_DEF::Elf64_Sym, st_name), bIsBigEndian);
-    result.st_info = read_uint8(nOffset + offsetof(XELF_DEF::Elf64_Sym, st_info));
-    result.st_other = read_uint8(nOffset + offsetof(XELF_DEF::Elf64_Sym, st_other));
-    result.st_shndx = read_uint16(nOffset + offsetof(XELF_DEF::Elf64_Sym, st_shndx), bIsBigEndian);
-    result.st_value = read_uint64(nOffset + offsetof(XELF_DEF::Elf64_Sym, st_value), bIsBigEndian);
-    result.st_size = read_uint64(nOffset + offsetof(XELF_DEF::Elf64_Sym, st_size), bIsBigEndian);
+XELF_DEF::Elf32_Sym XELF::_readElf32_Sym(const char *pData, bool bIsBigEndian)
+{
+    return _read_record<XELF_DEF::Elf32_Sym>(pData, _FIELDS_ELF32_SYM, bIsBigEndian);
+}
 
-    return result;
+XELF_DEF::Elf64_Sym XELF::_readElf64_Sym(const char *pData, bool bIsBigEndian)
+{
+    return _read_record<XELF_DEF::Elf64_Sym>(pData, _FIELDS_ELF64_SYM, bIsBigEndian);
 }
 
 void XELF::setElf32_Sym_st_name(qint64 nOffset, quint32 nValue, bool bIsBigEndian)
@@ -5435,13 +5516,13 @@ qint64 XELF::getFileFormatSize(PDSTRUCT *pPdStruct)
     qint64 nResult = 0;
 
     {
-        _MEMORY_MAP memoryMap = getMemoryMap(MAPMODE_SEGMENTS, pPdStruct);
+        _MEMORY_MAP memoryMap = getCachedMemoryMap(MAPMODE_SEGMENTS, pPdStruct);
 
         nResult = _calculateRawSize(&memoryMap, pPdStruct);
     }
 
     if (nResult == 0) {
-        _MEMORY_MAP memoryMap = getMemoryMap(MAPMODE_SECTIONS, pPdStruct);
+        _MEMORY_MAP memoryMap = getCachedMemoryMap(MAPMODE_SECTIONS, pPdStruct);
 
         nResult = _calculateRawSize(&memoryMap, pPdStruct);
     }
@@ -5515,7 +5596,7 @@ XELF::FIXDUMP_OPTIONS XELF::getFixDumpOptions(PDSTRUCT *pPdStruct)
 {
     XELF::FIXDUMP_OPTIONS result = {};
 
-    _MEMORY_MAP memoryMap = getMemoryMap(MAPMODE_UNKNOWN, pPdStruct);
+    _MEMORY_MAP memoryMap = getCachedMemoryMap(MAPMODE_UNKNOWN, pPdStruct);
 
     result.bOptimizeSize = true;
     result.bFixSegments = true;
@@ -431,6 +431,8 @@ public:
 
     XELF_DEF::Elf32_Sym _readElf32_Sym(qint64 nOffset, bool bIsBigEndian);
     XELF_DEF::Elf64_Sym _readElf64_Sym(qint64 nOffset, bool bIsBigEndian);
+    static XELF_DEF::Elf32_Sym _readElf32_Sym(const char *pData, bool bIsBigEndian);
+    static XELF_DEF::Elf64_Sym _readElf64_Sym(const char *pData, bool bIsBigEndian);
 
     void setElf32_Sym_st_name(qint64 nOffset, quint32 nValue, bool bIsBigEndian);
     void setElf32_Sym_st_value(qint64 nOffset, quint32 nValue, bool bIsBigEndian);
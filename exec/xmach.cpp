@@ -27,6 +27,11 @@ XBinary::XCONVERT _TABLE_XMACH_STRUCTID[] = {
     {XMACH::STRUCTID_load_command, "load_command", QString("load_command")},
 };
 
+static constexpr XBINARY_DEF::STRUCT_FIELD _FIELDS_LOAD_COMMAND[] = {
+    XBINARY_STRUCT_FIELD(XMACH_DEF::load_command, cmd),
+    XBINARY_STRUCT_FIELD(XMACH_DEF::load_command, cmdsize),
+};
+
 // Xcode Toolchain Version History Table (1.0-2.x, Before iOS Support)
 // Source: https://en.wikipedia.org/wiki/Xcode (Retrieved: January 2026)
 // Fields: {sVersion, sGccVersion, sGdbVersion}
@@ -1643,9 +1648,11 @@ XMACH::COMMAND_RECORD XMACH::_readLoadCommand(qint64 nOffset, bool bIsBigEndian)
 {
     COMMAND_RECORD result = {};
 
+    XMACH_DEF::load_command record = read_record<XMACH_DEF::load_command>(nOffset, _FIELDS_LOAD_COMMAND, bIsBigEndian);
+
     result.nStructOffset = nOffset;
-    result.nId = read_uint32(nOffset + offsetof(XMACH_DEF::load_command, cmd), bIsBigEndian);
-    result.nSize = read_uint32(nOffset + offsetof(XMACH_DEF::load_command, cmdsize), bIsBigEndian);
+    result.nId = record.cmd;
+    result.nSize = record.cmdsize;
 
     return result;
 }
@@ -2145,6 +2152,10 @@ XBinary::_MEMORY_MAP XMACH::getMemoryMap(MAPMODE mapMode, PDSTRUCT *pPdStruct)
     }
 
     result.nImageSize = nMaxAddress - nMinAddress;
+
+    // Files can have many segments and sections
+    _prepareMemoryIndex(&result);
+
     result.nEntryPointAddress = getAddressOfEntryPoint(&result);
 
     return result;
@@ -5086,7 +5097,7 @@ QList<XMACH::FUNCTION_RECORD> XMACH::getFunctionRecords(qint64 nOffset, qint64 n
 {
     QList<FUNCTION_RECORD> listRecords;
 
-    XBinary::_MEMORY_MAP memoryMap = getMemoryMap();
+    XBinary::_MEMORY_MAP memoryMap = getCachedMemoryMap();
 
     qint32 nRawOffset = 0;
 
@@ -473,6 +473,34 @@ XBinary::FILEFORMATINFO XPE::getFileFormatInfo(PDSTRUCT *pPdStruct)
     result.bIsValid = isValid(pPdStruct);
 
     if (result.bIsValid) {
+        // The memory map is only built for the hints, so skip it for memory buffers
+        if (isPrefetchEnabled()) {
+            // Headers and the directories parsed below are read early; ask the OS to load them in one pass
+            _MEMORY_MAP memoryMap = getCachedMemoryMap(MAPMODE_UNKNOWN, pPdStruct);
+
+            QList<OFFSETSIZE> listRegions;
+
+            OFFSETSIZE osHeaders = {};
+            osHeaders.nOffset = 0;
+            osHeaders.nSize = getSectionsTableOffset() + getFileHeader_NumberOfSections() * getSectionHeaderSize();
+            listRegions.append(osHeaders);
+
+            const quint32 _directories[] = {XPE_DEF::S_IMAGE_DIRECTORY_ENTRY_IMPORT, XPE_DEF::S_IMAGE_DIRECTORY_ENTRY_RESOURCE,
+                                            XPE_DEF::S_IMAGE_DIRECTORY_ENTRY_EXPORT};
+
+            for (qint32 i = 0; i < (qint32)(sizeof(_directories) / sizeof(_directories[0])); i++) {
+                OFFSETSIZE osDirectory = {};
+                osDirectory.nOffset = getDataDirectoryOffset(&memoryMap, _directories[i]);
+                osDirectory.nSize = getOptionalHeader_DataDirectory(_directories[i]).Size;
+
+                if ((osDirectory.nOffset != -1) && (osDirectory.nSize > 0)) {
+                    listRegions.append(osDirectory);
+                }
+            }
+
+            prefetch(listRegions);
+        }
+
         result.nSize = getSize();
 
         result.fileType = getFileType();
@@ -1343,7 +1371,7 @@ void XPE::setDirectories(QList<XPE_DEF::IMAGE_DATA_DIRECTORY> *pListDirectories)
 
 qint64 XPE::getDataDirectoryOffset(quint32 nNumber)
 {
-    _MEMORY_MAP memoryMap = getMemoryMap();
+    _MEMORY_MAP memoryMap = getCachedMemoryMap();
 
     return getDataDirectoryOffset(&memoryMap, nNumber);
 }
@@ -1383,7 +1411,7 @@ qint64 XPE::getDataDirectoryHeaderSize()
 
 QByteArray XPE::getDataDirectory(quint32 nNumber)
 {
-    _MEMORY_MAP memoryMap = getMemoryMap();
+    _MEMORY_MAP memoryMap = getCachedMemoryMap();
 
     return getDataDirectory(&memoryMap, nNumber);
 }
@@ -2088,7 +2116,7 @@ QList<XPE::IMPORT_RECORD> XPE::getImportRecords(PDSTRUCT *pPdStruct)
         pPdStruct = &pdStructEmpty;
     }
 
-    _MEMORY_MAP memoryMap = getMemoryMap(MAPMODE_UNKNOWN, pPdStruct);
+    _MEMORY_MAP memoryMap = getCachedMemoryMap(MAPMODE_UNKNOWN, pPdStruct);
 
     return getImportRecords(&memoryMap, pPdStruct);
 }
@@ -2273,7 +2301,7 @@ qint64 XPE::getImportDescriptorSize()
 
 QList<XPE_DEF::IMAGE_IMPORT_DESCRIPTOR> XPE::getImportDescriptors()
 {
-    _MEMORY_MAP memoryMap = getMemoryMap();
+    _MEMORY_MAP memoryMap = getCachedMemoryMap();
 
     return getImportDescriptors(&memoryMap);
 }
@@ -2315,7 +2343,7 @@ QList<XPE_DEF::IMAGE_IMPORT_DESCRIPTOR> XPE::getImportDescriptors(XBinary::_MEMO
 
 QList<XPE::IMAGE_IMPORT_DESCRIPTOR_EX> XPE::getImportDescriptorsEx()
 {
-    _MEMORY_MAP memoryMap = getMemoryMap();
+    _MEMORY_MAP memoryMap = getCachedMemoryMap();
 
     return getImportDescriptorsEx(&memoryMap);
 }
@@ -2433,7 +2461,7 @@ QList<XPE::IMPORT_HEADER> XPE::getImports(PDSTRUCT *pPdStruct)
         pPdStruct = &pdStructEmpty;
     }
 
-    _MEMORY_MAP memoryMap = getMemoryMap(MAPMODE_UNKNOWN, pPdStruct);
+    _MEMORY_MAP memoryMap = getCachedMemoryMap(MAPMODE_UNKNOWN, pPdStruct);
 
     return getImports(&memoryMap, pPdStruct);
 }
@@ -2710,7 +2738,7 @@ QList<XPE::IMPORT_POSITION> XPE::getImportPositions(qint32 nIndex, PDSTRUCT *pPd
     qint64 nImportOffset = getDataDirectoryOffset(XPE_DEF::S_IMAGE_DIRECTORY_ENTRY_IMPORT);
 
     if (nImportOffset != -1) {
-        _MEMORY_MAP memoryMap = getMemoryMap(MAPMODE_UNKNOWN, pPdStruct);
+        _MEMORY_MAP memoryMap = getCachedMemoryMap(MAPMODE_UNKNOWN, pPdStruct);
 
         qint32 _nIndex = 0;
 
@@ -3173,7 +3201,7 @@ QString XPE::getImportFunctionName(quint32 nImport, quint32 nFunctionNumber, QLi
 
 XPE::RESOURCE_HEADER XPE::getResourceHeader()
 {
-    _MEMORY_MAP memoryMap = getMemoryMap();
+    _MEMORY_MAP memoryMap = getCachedMemoryMap();
 
     return getResourceHeader(&memoryMap);
 }
@@ -3218,7 +3246,7 @@ QList<XPE::RESOURCE_RECORD> XPE::getResources(qint32 nLimit, PDSTRUCT *pPdStruct
         pPdStruct = &pdStructEmpty;
     }
 
-    _MEMORY_MAP memoryMap = getMemoryMap(MAPMODE_UNKNOWN, pPdStruct);
+    _MEMORY_MAP memoryMap = getCachedMemoryMap(MAPMODE_UNKNOWN, pPdStruct);
 
     return getResources(&memoryMap, nLimit, pPdStruct);
 }
@@ -3472,7 +3500,7 @@ bool XPE::isResourceStringTablePresent(QList<RESOURCE_RECORD> *pListResourceReco
 QList<XPE::RESOURCE_STRINGTABLE_RECORD> XPE::getResourceStringTableRecords()
 {
     QList<RESOURCE_RECORD> listResources = getResources(10000);
-    _MEMORY_MAP memoryMap = getMemoryMap();
+    _MEMORY_MAP memoryMap = getCachedMemoryMap();
 
     return getResourceStringTableRecords(&listResources, &memoryMap);
 }
@@ -4168,7 +4196,7 @@ XPE::EXPORT_HEADER XPE::getExport(bool bValidOnly, PDSTRUCT *pPdStruct)
         pPdStruct = &pdStructEmpty;
     }
 
-    _MEMORY_MAP memoryMap = getMemoryMap(MAPMODE_UNKNOWN, pPdStruct);
+    _MEMORY_MAP memoryMap = getCachedMemoryMap(MAPMODE_UNKNOWN, pPdStruct);
 
     return getExport(&memoryMap, bValidOnly, pPdStruct);
 }
@@ -4301,7 +4329,7 @@ QList<XADDR> XPE::getExportFunctionAddressesList(PDSTRUCT *pPdStruct)
         pPdStruct = &pdStructEmpty;
     }
 
-    _MEMORY_MAP memoryMap = getMemoryMap(MAPMODE_UNKNOWN, pPdStruct);
+    _MEMORY_MAP memoryMap = getCachedMemoryMap(MAPMODE_UNKNOWN, pPdStruct);
     XPE_DEF::IMAGE_EXPORT_DIRECTORY ied = getExportDirectory();
 
     return getExportFunctionAddressesList(&memoryMap, &ied, pPdStruct);
@@ -6855,7 +6883,7 @@ qint64 XPE::getExceptionRecordSize()
 
 QList<XPE_DEF::S_IMAGE_RUNTIME_FUNCTION_ENTRY> XPE::getExceptionsList()
 {
-    _MEMORY_MAP memoryMap = getMemoryMap();
+    _MEMORY_MAP memoryMap = getCachedMemoryMap();
 
     return getExceptionsList(&memoryMap);
 }
@@ -6902,7 +6930,7 @@ XPE_DEF::S_IMAGE_DEBUG_DIRECTORY XPE::_read_IMAGE_DEBUG_DIRECTORY(qint64 nOffset
 
 QList<XPE_DEF::S_IMAGE_DEBUG_DIRECTORY> XPE::getDebugList()
 {
-    _MEMORY_MAP memoryMap = getMemoryMap();
+    _MEMORY_MAP memoryMap = getCachedMemoryMap();
 
     return getDebugList(&memoryMap);
 }
@@ -7035,7 +7063,7 @@ qint64 XPE::getDelayImportRecordSize()
 
 QList<XPE_DEF::S_IMAGE_DELAYLOAD_DESCRIPTOR> XPE::getDelayImportsList()
 {
-    _MEMORY_MAP memoryMap = getMemoryMap();
+    _MEMORY_MAP memoryMap = getCachedMemoryMap();
 
     return getDelayImportsList(&memoryMap);
 }
@@ -7121,7 +7149,7 @@ void XPE::setDelayImport_TimeDateStamp(quint32 nNumber, quint32 nValue)
 
 QList<XPE::DELAYIMPORT_POSITION> XPE::getDelayImportPositions(qint32 nIndex)
 {
-    _MEMORY_MAP memoryMap = getMemoryMap();
+    _MEMORY_MAP memoryMap = getCachedMemoryMap();
 
     return getDelayImportPositions(&memoryMap, nIndex);
 }
@@ -7241,7 +7269,7 @@ QList<XPE::DELAYIMPORT_POSITION> XPE::getDelayImportPositions(XBinary::_MEMORY_M
 
 QList<XPE::BOUND_IMPORT_POSITION> XPE::getBoundImportPositions()
 {
-    _MEMORY_MAP memoryMap = getMemoryMap();
+    _MEMORY_MAP memoryMap = getCachedMemoryMap();
 
     return getBoundImportPositions(&memoryMap);
 }
@@ -7976,7 +8004,7 @@ bool XPE::_resizeDosStubSize(qint64 nNewStubSize)
         if (nRawDelta > 0) {
             if (nAlignDelta) {
                 if (bResult) {
-                    bResult = resize(getDevice(), getSize() + nAlignDelta);
+                    bResult = resize(getSize() + nAlignDelta);
                 }
 
                 if (bResult) {
@@ -8001,7 +8029,7 @@ bool XPE::_resizeDosStubSize(qint64 nNewStubSize)
                 }
 
                 if (bResult) {
-                    bResult = resize(getDevice(), getSize() + nAlignDelta);
+                    bResult = resize(getSize() + nAlignDelta);
                 }
             }
         }
@@ -8616,7 +8644,7 @@ QList<XBinary::FMT_MSG> XPE::checkFileFormat(bool bDeep, PDSTRUCT *pPdStruct)
 
     bool bSuccess = true;
 
-    _MEMORY_MAP memoryMap = getMemoryMap(MAPMODE_SECTIONS, pPdStruct);
+    _MEMORY_MAP memoryMap = getCachedMemoryMap(MAPMODE_SECTIONS, pPdStruct);
 
     quint32 nFileAlignment = getOptionalHeader_FileAlignment();
     quint32 nSectionAlignment = getOptionalHeader_SectionAlignment();
@@ -10385,7 +10413,7 @@ XPE::CLI_INFO XPE::getCliInfo(bool bFindHidden, PDSTRUCT *pPdStruct)
         pPdStruct = &pdStructEmpty;
     }
 
-    _MEMORY_MAP memoryMap = getMemoryMap(MAPMODE_UNKNOWN, pPdStruct);
+    _MEMORY_MAP memoryMap = getCachedMemoryMap(MAPMODE_UNKNOWN, pPdStruct);
 
     return getCliInfo(bFindHidden, &memoryMap, pPdStruct);
 }
@@ -11725,7 +11753,7 @@ XBinary::OFFSETSIZE XPE::getNet_MetadataOffsetSize()
     OFFSETSIZE osResult = {};
     osResult.nOffset = -1;
 
-    _MEMORY_MAP memoryMap = getMemoryMap();
+    _MEMORY_MAP memoryMap = getCachedMemoryMap();
 
     qint64 nCLIHeaderOffset = -1;
 
@@ -11928,7 +11956,7 @@ void XPE::setMetadataHeader_Streams(quint16 nValue)
 
 bool XPE::isDataDirectoryValid(XPE_DEF::IMAGE_DATA_DIRECTORY *pDataDirectory)
 {
-    _MEMORY_MAP memoryMap = getMemoryMap();
+    _MEMORY_MAP memoryMap = getCachedMemoryMap();
 
     return isDataDirectoryValid(pDataDirectory, &memoryMap);
 }
@@ -11946,7 +11974,7 @@ bool XPE::isDataDirectoryValid(XPE_DEF::IMAGE_DATA_DIRECTORY *pDataDirectory, XB
 
 bool XPE::isNetMetadataPresent(PDSTRUCT *pPdStruct)
 {
-    _MEMORY_MAP memoryMap = getMemoryMap(MAPMODE_UNKNOWN, pPdStruct);
+    _MEMORY_MAP memoryMap = getCachedMemoryMap(MAPMODE_UNKNOWN, pPdStruct);
     CLI_INFO cliInfo = getCliInfo(true, &memoryMap, pPdStruct);
 
     return isNetMetadataPresent(&cliInfo, &memoryMap);
@@ -11986,7 +12014,7 @@ bool XPE::isSignatureInBlobPresent_NET(const QString &sSignature, _MEMORY_MAP *p
 
 qint32 XPE::getEntryPointSection()
 {
-    _MEMORY_MAP memoryMap = getMemoryMap();
+    _MEMORY_MAP memoryMap = getCachedMemoryMap();
 
     return getEntryPointSection(&memoryMap);
 }
@@ -12010,42 +12038,42 @@ qint32 XPE::getEntryPointSection(_MEMORY_MAP *pMemoryMap)
 
 qint32 XPE::getImportSection()
 {
-    _MEMORY_MAP memoryMap = getMemoryMap();
+    _MEMORY_MAP memoryMap = getCachedMemoryMap();
 
     return getImageDirectoryEntrySection(&memoryMap, XPE_DEF::S_IMAGE_DIRECTORY_ENTRY_IMPORT);
 }
 
 qint32 XPE::getExportSection()
 {
-    _MEMORY_MAP memoryMap = getMemoryMap();
+    _MEMORY_MAP memoryMap = getCachedMemoryMap();
 
     return getImageDirectoryEntrySection(&memoryMap, XPE_DEF::S_IMAGE_DIRECTORY_ENTRY_EXPORT);
 }
 
 qint32 XPE::getTLSSection()
 {
-    _MEMORY_MAP memoryMap = getMemoryMap();
+    _MEMORY_MAP memoryMap = getCachedMemoryMap();
 
     return getImageDirectoryEntrySection(&memoryMap, XPE_DEF::S_IMAGE_DIRECTORY_ENTRY_TLS);
 }
 
 qint32 XPE::getIATSection()
 {
-    _MEMORY_MAP memoryMap = getMemoryMap();
+    _MEMORY_MAP memoryMap = getCachedMemoryMap();
 
     return getImageDirectoryEntrySection(&memoryMap, XPE_DEF::S_IMAGE_DIRECTORY_ENTRY_IAT);
 }
 
 qint32 XPE::getResourcesSection()
 {
-    _MEMORY_MAP memoryMap = getMemoryMap();
+    _MEMORY_MAP memoryMap = getCachedMemoryMap();
 
     return getImageDirectoryEntrySection(&memoryMap, XPE_DEF::S_IMAGE_DIRECTORY_ENTRY_RESOURCE);
 }
 
 qint32 XPE::getRelocsSection()
 {
-    _MEMORY_MAP memoryMap = getMemoryMap();
+    _MEMORY_MAP memoryMap = getCachedMemoryMap();
 
     return getImageDirectoryEntrySection(&memoryMap, XPE_DEF::S_IMAGE_DIRECTORY_ENTRY_RESOURCE);
 }
@@ -12069,7 +12097,7 @@ qint32 XPE::getImageDirectoryEntrySection(_MEMORY_MAP *pMemoryMap, qint32 nImage
 
 qint32 XPE::getNormalCodeSection()
 {
-    _MEMORY_MAP memoryMap = getMemoryMap();
+    _MEMORY_MAP memoryMap = getCachedMemoryMap();
 
     return getNormalCodeSection(&memoryMap);
 }
@@ -12114,7 +12142,7 @@ qint32 XPE::getNormalCodeSection(_MEMORY_MAP *pMemoryMap)
 
 qint32 XPE::getNormalDataSection()
 {
-    _MEMORY_MAP memoryMap = getMemoryMap();
+    _MEMORY_MAP memoryMap = getCachedMemoryMap();
 
     return getNormalDataSection(&memoryMap);
 }
@@ -12164,7 +12192,7 @@ qint32 XPE::getNormalDataSection(_MEMORY_MAP *pMemoryMap)
 
 qint32 XPE::getConstDataSection()
 {
-    _MEMORY_MAP memoryMap = getMemoryMap();
+    _MEMORY_MAP memoryMap = getCachedMemoryMap();
 
     return getConstDataSection(&memoryMap);
 }
@@ -12477,7 +12505,7 @@ XPE::FIXDUMP_OPTIONS XPE::getFixDumpOptions(PDSTRUCT *pPdStruct)
         pPdStruct = &pdStructEmpty;
     }
 
-    _MEMORY_MAP memoryMap = getMemoryMap(MAPMODE_UNKNOWN, pPdStruct);
+    _MEMORY_MAP memoryMap = getCachedMemoryMap(MAPMODE_UNKNOWN, pPdStruct);
 
     FIXDUMP_OPTIONS result = {};
 
@@ -12691,15 +12719,21 @@ QList<qint64> XPE::getRelocsAsRVAList()
 
             nNumberOfBlocks = qMin(nNumberOfBlocks, (int)0xFFFF);
 
-            for (qint32 i = 0; i < nNumberOfBlocks; i++) {
-                quint16 nRecord = read_uint16(nRelocsOffset);
+            if (nNumberOfBlocks > 0) {
+                QVector<quint16> listRecords(nNumberOfBlocks);
 
-                if (nRecord) {
-                    nRecord = nRecord & 0x0FFF;
-                    stResult.insert(ibr.VirtualAddress + nRecord);
+                qint64 nCount = read_uint16_array(nRelocsOffset, listRecords.data(), nNumberOfBlocks);
+
+                for (qint32 i = 0; i < nCount; i++) {
+                    quint16 nRecord = listRecords.at(i);
+
+                    if (nRecord) {
+                        nRecord = nRecord & 0x0FFF;
+                        stResult.insert(ibr.VirtualAddress + nRecord);
+                    }
                 }
 
-                nRelocsOffset += sizeof(quint16);
+                nRelocsOffset += nNumberOfBlocks * sizeof(quint16);
             }
         }
     }
@@ -13231,7 +13265,7 @@ void XPE::setTLS_Characteristics(quint32 nValue)
 
 QList<XADDR> XPE::getTLS_CallbacksList()  // TODO limit
 {
-    _MEMORY_MAP memoryMap = getMemoryMap();
+    _MEMORY_MAP memoryMap = getCachedMemoryMap();
 
     return getTLS_CallbacksList(&memoryMap);
 }
@@ -13276,7 +13310,7 @@ QList<XADDR> XPE::getTLS_CallbacksList(XBinary::_MEMORY_MAP *pMemoryMap, PDSTRUC
 
 bool XPE::isTLSCallbacksPresent()
 {
-    _MEMORY_MAP memoryMap = getMemoryMap();
+    _MEMORY_MAP memoryMap = getCachedMemoryMap();
 
     return isTLSCallbacksPresent(&memoryMap);
 }
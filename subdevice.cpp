@@ -83,6 +83,55 @@ bool SubDevice::reset()
     return seek(0);
 }
 
+bool SubDevice::isPositional() const
+{
+    return (XIODevice::getPositionalDevice(m_pDevice) != nullptr);
+}
+
+qint64 SubDevice::readAt(qint64 nPos, char *pData, qint64 nMaxSize)
+{
+    qint64 nResult = -1;
+
+    XIODevice *pDevice = XIODevice::getPositionalDevice(m_pDevice);
+
+    if (pDevice && (nPos >= 0)) {
+        nMaxSize = qMin(nMaxSize, size() - nPos);
+
+        if (nMaxSize > 0) {
+            nResult = pDevice->readAt(getInitLocation() + nPos, pData, nMaxSize);
+        } else {
+            nResult = 0;
+        }
+    }
+
+    return nResult;
+}
+
+void SubDevice::prefetch(qint64 nPos, qint64 nSize)
+{
+    if (nPos >= 0) {
+        nSize = qMin(nSize, size() - nPos);
+
+        if (nSize > 0) {
+            XIODevice::prefetchDevice(m_pDevice, getInitLocation() + nPos, nSize);
+        }
+    }
+}
+
+const char *SubDevice::getMemory() const
+{
+    const char *pResult = nullptr;
+
+    // Nested subdevices resolve to a slice of the root buffer
+    const char *pMemory = XIODevice::getDeviceMemory(m_pDevice);
+
+    if (pMemory) {
+        pResult = pMemory + getInitLocation();
+    }
+
+    return pResult;
+}
+
 qint64 SubDevice::readData(char *pData, qint64 nMaxSize)
 {
     nMaxSize = qMin(nMaxSize, size() - pos());
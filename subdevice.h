@@ -37,6 +37,11 @@ public:
     virtual bool seek(qint64 nPos);
     virtual bool reset();
 
+    virtual bool isPositional() const;
+    virtual qint64 readAt(qint64 nPos, char *pData, qint64 nMaxSize);
+    virtual void prefetch(qint64 nPos, qint64 nSize);
+    virtual const char *getMemory() const;
+
 protected:
     virtual qint64 readData(char *pData, qint64 nMaxSize);
     virtual qint64 writeData(const char *pData, qint64 nMaxSize);
@@ -9,4 +9,10 @@ set(XBINARY_SOURCES
     ${CMAKE_CURRENT_LIST_DIR}/xbinary_def.h
     ${CMAKE_CURRENT_LIST_DIR}/xiodevice.cpp
     ${CMAKE_CURRENT_LIST_DIR}/xiodevice.h
+    ${CMAKE_CURRENT_LIST_DIR}/xmappeddevice.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/xmappeddevice.h
+    ${CMAKE_CURRENT_LIST_DIR}/xoverlaydevice.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/xoverlaydevice.h
+    ${CMAKE_CURRENT_LIST_DIR}/xpagecache.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/xpagecache.h
 )
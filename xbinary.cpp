@@ -21,6 +21,11 @@
 #include "xbinary.h"
 #include <cstring>
 #include <QDebug>
+#include <QAtomicInteger>
+#include <QReadWriteLock>
+#include <QRunnable>
+#include <QThread>
+#include <QThreadPool>
 
 bool compareMemoryMapRecord(const XBinary::_MEMORY_RECORD &a, const XBinary::_MEMORY_RECORD &b)
 {
@@ -1177,11 +1182,17 @@ XBinary::~XBinary()
 
         delete m_pFile;
     }
+
+    delete m_pSearchThreadPool;
 }
 
 void XBinary::setData(QIODevice *pDevice, bool bIsImage, XADDR nModuleAddress)
 {
     m_pReadWriteMutex = nullptr;
+    m_pPageCache = nullptr;
+    m_bMemoryMapCache = true;
+    m_nSearchThreads = 0;
+    m_pSearchThreadPool = nullptr;
     m_nSize = 0;
     m_nFileFormatSize = 0;
     m_pFile = nullptr;
@@ -1213,24 +1224,14 @@ void XBinary::setData(QIODevice *pDevice, bool bIsImage, XADDR nModuleAddress)
 void XBinary::setDevice(QIODevice *pDevice)
 {
     m_pDevice = pDevice;
+    m_pPositionalDevice = XIODevice::getPositionalDevice(pDevice);
+    m_bIsPageCacheable = XPageCache::isDeviceCacheable(pDevice);
 
-    if (m_pDevice) {
-        QBuffer *pBuffer = dynamic_cast<QBuffer *>(pDevice);
+    resetMemoryMapCache();
 
-        if (pBuffer) {
-            m_pConstMemory = pBuffer->data().data();
-        } else {
-            SubDevice *pSubDevice = dynamic_cast<SubDevice *>(pDevice);
-            if (pSubDevice) {
-#ifdef QT_DEBUG
-                qDebug("XBinary::setDevice(): SubDevice detected!!!!");
-#endif
-                m_pConstMemory = nullptr;
-            } else {
-                m_pConstMemory = nullptr;
-            }
-        }
+    _updateConstMemory();
 
+    if (m_pDevice) {
         if (m_pReadWriteMutex) m_pReadWriteMutex->lock();
 
         // qDebug("%s",XBinary::valueToHex((quint64)m_pDevice).toLatin1().data());
@@ -1241,11 +1242,98 @@ void XBinary::setDevice(QIODevice *pDevice)
     }
 }
 
+void XBinary::_updateConstMemory()
+{
+    // Read-only QBuffer, mapped files and subdevices of them are read without the device
+    m_pConstMemory = XIODevice::getDeviceMemory(m_pDevice);
+}
+
 void XBinary::setReadWriteMutex(QMutex *pReadWriteMutex)
 {
     m_pReadWriteMutex = pReadWriteMutex;
 }
 
+void XBinary::setPageCache(XPageCache *pPageCache)
+{
+    m_pPageCache = pPageCache;
+}
+
+XPageCache *XBinary::getPageCache()
+{
+    return m_pPageCache;
+}
+
+XBinary::VIEW XBinary::getView(qint64 nOffset, qint64 nSize)
+{
+    VIEW result = {};
+
+    OFFSETSIZE osRegion = convertOffsetAndSize(nOffset, nSize);
+
+    if (osRegion.nOffset != -1) {
+        result.nOffset = osRegion.nOffset;
+
+        if (m_pConstMemory) {
+            result.pData = m_pConstMemory + osRegion.nOffset;
+            result.nSize = osRegion.nSize;
+        } else {
+            if (m_pPageCache && m_bIsPageCacheable) {
+                qint64 nDelta = 0;
+
+                bool bLock = (m_pReadWriteMutex && (!m_pPositionalDevice));
+
+                if (bLock) m_pReadWriteMutex->lock();
+
+                if (m_pPageCache->getPage(m_pDevice, osRegion.nOffset, osRegion.nSize, &(result.baHolder), &nDelta)) {
+                    result.pData = result.baHolder.constData() + nDelta;
+                    result.nSize = osRegion.nSize;
+                }
+
+                if (bLock) m_pReadWriteMutex->unlock();
+            }
+
+            if (!result.pData) {
+                result.baHolder = read_array(osRegion.nOffset, osRegion.nSize);
+                result.pData = result.baHolder.constData();
+                result.nSize = result.baHolder.size();
+            }
+        }
+    }
+
+    return result;
+}
+
+bool XBinary::isPrefetchEnabled()
+{
+    // Memory buffers are already resident; mapped files are handled by the device
+    return m_pDevice && (!dynamic_cast<QBuffer *>(m_pDevice));
+}
+
+void XBinary::prefetch(const QList<OFFSETSIZE> &listRegions)
+{
+    if (isPrefetchEnabled()) {
+        qint32 nNumberOfRegions = listRegions.count();
+
+        for (qint32 i = 0; i < nNumberOfRegions; i++) {
+            OFFSETSIZE osRegion = convertOffsetAndSize(listRegions.at(i).nOffset, listRegions.at(i).nSize);
+
+            if (osRegion.nOffset != -1) {
+                XIODevice::prefetchDevice(m_pDevice, osRegion.nOffset, osRegion.nSize);
+            }
+        }
+    }
+}
+
+const char *XBinary::getViewData(const VIEW *pView, qint64 nOffset, qint64 nSize)
+{
+    const char *pResult = nullptr;
+
+    if (pView->pData && (nOffset >= pView->nOffset) && (nSize >= 0) && (nOffset + nSize <= pView->nOffset + pView->nSize)) {
+        pResult = pView->pData + (nOffset - pView->nOffset);
+    }
+
+    return pResult;
+}
+
 void XBinary::setFileName(const QString &sFileName)
 {
     m_sFileName = sFileName;
@@ -1256,6 +1344,22 @@ qint64 XBinary::safeReadData(QIODevice *pDevice, qint64 nPos, char *pData, qint6
     // qDebug("%X %X pos: %X maxlen: %X", this, pDevice, nPos, nMaxLen);
     qint64 nResult = 0;
 
+    if (!_chargeReadBudget(nMaxLen)) {
+        return 0;
+    }
+
+    if (m_pConstMemory && (pDevice == m_pDevice)) {
+        return _readDataConstMemory(nPos, pData, nMaxLen);
+    }
+
+    if (m_pPageCache && m_bIsPageCacheable && (pDevice == m_pDevice) && (nMaxLen < m_pPageCache->getPageSize())) {
+        return _readDataPageCache(nPos, pData, nMaxLen);
+    }
+
+    if (m_pPositionalDevice && (pDevice == m_pDevice)) {
+        return _readDataPositional(nPos, pData, nMaxLen);
+    }
+
     if (m_pReadWriteMutex) m_pReadWriteMutex->lock();
 
     if ((pDevice->size() > nPos) && (nPos >= 0)) {
@@ -1320,6 +1424,19 @@ qint64 XBinary::safeWriteData(QIODevice *pDevice, qint64 nPos, const char *pData
 
     if (m_pReadWriteMutex) m_pReadWriteMutex->unlock();
 
+    if (m_pConstMemory && (pDevice == m_pDevice)) {
+        // QBuffer may detach its data on write
+        _updateConstMemory();
+    }
+
+    if (m_pPageCache) {
+        m_pPageCache->invalidate(pDevice, nPos, nResult);
+    }
+
+    if ((nResult > 0) && (pDevice == m_pDevice)) {
+        resetMemoryMapCache();
+    }
+
     return nResult;
 }
 
@@ -1328,6 +1445,22 @@ qint64 XBinary::_readDataSimple(QIODevice *pDevice, qint64 nPos, char *pData, qi
     // qDebug("%X %X pos: %X maxlen: %X", this, pDevice, nPos, nMaxLen);
     qint64 nResult = 0;
 
+    if (!_chargeReadBudget(nMaxLen)) {
+        return 0;
+    }
+
+    if (m_pConstMemory && (pDevice == m_pDevice)) {
+        return _readDataConstMemory(nPos, pData, nMaxLen);
+    }
+
+    if (m_pPageCache && m_bIsPageCacheable && (pDevice == m_pDevice) && (nMaxLen < m_pPageCache->getPageSize())) {
+        return _readDataPageCache(nPos, pData, nMaxLen);
+    }
+
+    if (m_pPositionalDevice && (pDevice == m_pDevice)) {
+        return _readDataPositional(nPos, pData, nMaxLen);
+    }
+
     if (m_pReadWriteMutex) m_pReadWriteMutex->lock();
 
     if ((pDevice->size() > nPos) && (nPos >= 0)) {
@@ -1391,6 +1524,70 @@ qint64 XBinary::_writeDataSimple(QIODevice *pDevice, qint64 nPos, const char *pD
 
     if (m_pReadWriteMutex) m_pReadWriteMutex->unlock();
 
+    if (m_pConstMemory && (pDevice == m_pDevice)) {
+        _updateConstMemory();
+    }
+
+    if (m_pPageCache) {
+        m_pPageCache->invalidate(pDevice, nPos, nResult);
+    }
+
+    if ((nResult > 0) && (pDevice == m_pDevice)) {
+        resetMemoryMapCache();
+    }
+
+    return nResult;
+}
+
+qint64 XBinary::_readDataConstMemory(qint64 nPos, char *pData, qint64 nMaxLen)
+{
+    qint64 nResult = 0;
+
+    if ((m_nSize > nPos) && (nPos >= 0) && (nMaxLen > 0)) {
+        nResult = qMin(nMaxLen, m_nSize - nPos);
+
+        memcpy(pData, m_pConstMemory + nPos, (size_t)nResult);
+    } else {
+#ifdef QT_DEBUG
+        qDebug("Invalid pos: %llX Size: %llX", nPos, getSize());
+#endif
+    }
+
+    return nResult;
+}
+
+qint64 XBinary::_readDataPageCache(qint64 nPos, char *pData, qint64 nMaxLen)
+{
+    qint64 nResult = 0;
+
+    // Positional devices do not share a file position, so no lock is needed
+    bool bLock = (m_pReadWriteMutex && (!m_pPositionalDevice));
+
+    if (bLock) m_pReadWriteMutex->lock();
+
+    nResult = m_pPageCache->read(m_pDevice, nPos, pData, nMaxLen);
+
+    if (bLock) m_pReadWriteMutex->unlock();
+
+    return nResult;
+}
+
+qint64 XBinary::_readDataPositional(qint64 nPos, char *pData, qint64 nMaxLen)
+{
+    qint64 nResult = 0;
+
+    if ((m_nSize > nPos) && (nPos >= 0) && (nMaxLen > 0)) {
+        nResult = m_pPositionalDevice->readAt(nPos, pData, nMaxLen);
+
+        if (nResult < 0) {
+            nResult = 0;
+        }
+    } else {
+#ifdef QT_DEBUG
+        qDebug("Invalid pos: %llX Size: %llX", nPos, getSize());
+#endif
+    }
+
     return nResult;
 }
 
@@ -1425,6 +1622,7 @@ qint64 XBinary::getSize(const QString &sFileName)
 void XBinary::setMode(XBinary::MODE mode)
 {
     m_mode = mode;
+    resetMemoryMapCache();
 }
 
 XBinary::MODE XBinary::getMode()
@@ -1435,6 +1633,7 @@ XBinary::MODE XBinary::getMode()
 void XBinary::setType(qint32 nType)
 {
     m_nType = nType;
+    resetMemoryMapCache();
 }
 
 qint32 XBinary::getType()
@@ -1461,6 +1660,7 @@ QString XBinary::getTypeAsString()
 void XBinary::setFileType(XBinary::FT fileType)
 {
     m_fileType = fileType;
+    resetMemoryMapCache();
 }
 
 XBinary::FT XBinary::getFileType()
@@ -1507,6 +1707,7 @@ QString XBinary::endianToString(ENDIAN endian)
 void XBinary::setArch(const QString &sArch)
 {
     m_sArch = sArch;
+    resetMemoryMapCache();
 }
 
 QString XBinary::getArch()
@@ -1680,6 +1881,7 @@ XBinary::FILEFORMATINFO XBinary::getFileFormatInfo(PDSTRUCT *pPdStruct)
 void XBinary::setEndian(ENDIAN endian)
 {
     m_endian = endian;
+    resetMemoryMapCache();
 }
 
 void XBinary::setIsExecutable(bool bIsExecutable)
@@ -2369,6 +2571,45 @@ quint64 XBinary::read_uint64(qint64 nOffset, bool bIsBigEndian)
     return result;
 }
 
+qint64 XBinary::read_uint16_array(qint64 nOffset, quint16 *pBuffer, qint64 nCount, bool bIsBigEndian)
+{
+    qint64 nResult = 0;
+
+    if (nCount > 0) {
+        nResult = qMax(read_array(nOffset, (char *)pBuffer, nCount * 2), (qint64)0) / 2;
+
+        _toHostEndian16(pBuffer, nResult, bIsBigEndian);
+    }
+
+    return nResult;
+}
+
+qint64 XBinary::read_uint32_array(qint64 nOffset, quint32 *pBuffer, qint64 nCount, bool bIsBigEndian)
+{
+    qint64 nResult = 0;
+
+    if (nCount > 0) {
+        nResult = qMax(read_array(nOffset, (char *)pBuffer, nCount * 4), (qint64)0) / 4;
+
+        _toHostEndian32(pBuffer, nResult, bIsBigEndian);
+    }
+
+    return nResult;
+}
+
+qint64 XBinary::read_uint64_array(qint64 nOffset, quint64 *pBuffer, qint64 nCount, bool bIsBigEndian)
+{
+    qint64 nResult = 0;
+
+    if (nCount > 0) {
+        nResult = qMax(read_array(nOffset, (char *)pBuffer, nCount * 8), (qint64)0) / 8;
+
+        _toHostEndian64(pBuffer, nResult, bIsBigEndian);
+    }
+
+    return nResult;
+}
+
 qint64 XBinary::read_int64(qint64 nOffset, bool bIsBigEndian)
 {
     qint64 result = 0;
@@ -2525,6 +2766,60 @@ qint64 XBinary::write_unicodeString(qint64 nOffset, const QString &sString, qint
     return nResult;
 }
 
+static qint64 _x_find_null_byte(const char *pData, qint64 nSize)
+{
+    qint64 nResult = -1;
+
+    if (nSize > 0) {
+#ifdef USE_XSIMD
+        nResult = xsimd_find_null_byte(pData, nSize);
+#else
+        const void *p = memchr(pData, 0, (size_t)nSize);
+
+        if (p) {
+            nResult = (const char *)p - pData;
+        }
+#endif
+    }
+
+    return nResult;
+}
+
+static qint64 _x_find_null_word(const char *pData, qint64 nSize)
+{
+    qint64 nResult = -1;
+
+    if (nSize > 1) {
+#ifdef USE_XSIMD
+        nResult = xsimd_find_null_word(pData, nSize);
+#else
+        for (qint64 i = 0; i + 1 < nSize; i += 2) {
+            if ((pData[i] == 0) && (pData[i + 1] == 0)) {
+                nResult = i;
+                break;
+            }
+        }
+#endif
+    }
+
+    return nResult;
+}
+
+static qint32 _x_utf8_sequence_size(quint8 nByte)
+{
+    qint32 nResult = 1;
+
+    if ((nByte & 0xE0) == 0xC0) {
+        nResult = 2;
+    } else if ((nByte & 0xF0) == 0xE0) {
+        nResult = 3;
+    } else if ((nByte & 0xF8) == 0xF0) {
+        nResult = 4;
+    }
+
+    return nResult;
+}
+
 QString XBinary::read_ansiString(qint64 nOffset, qint64 nMaxSize)
 {
     QString sResult;
@@ -2534,23 +2829,27 @@ QString XBinary::read_ansiString(qint64 nOffset, qint64 nMaxSize)
     }
 
     if (nMaxSize > 0) {
-        quint8 *pBuffer = new quint8[nMaxSize + 1];
+        // Short strings are resolved from the stack buffer
+        char szBuffer[256];
 
-        for (qint32 i = 0; i < nMaxSize; i++) {
-            pBuffer[i] = read_uint8(nOffset + i);
+        qint64 nSize = qMax(read_array(nOffset, szBuffer, qMin(nMaxSize, (qint64)sizeof(szBuffer))), (qint64)0);
+        qint64 nLength = _x_find_null_byte(szBuffer, nSize);
 
-            if (pBuffer[i] == 0) {
-                break;
-            }
+        if (nLength != -1) {
+            sResult = QString::fromUtf8(szBuffer, (qint32)nLength);
+        } else if ((nSize < (qint64)sizeof(szBuffer)) || (nSize == nMaxSize)) {
+            sResult = QString::fromUtf8(szBuffer, (qint32)nSize);
+        } else {
+            QByteArray baBuffer = read_array(nOffset, nMaxSize);
 
-            if (i == nMaxSize - 1) {
-                pBuffer[nMaxSize] = 0;
-            }
-        }
+            nLength = _x_find_null_byte(baBuffer.constData(), baBuffer.size());
 
-        sResult.append((char *)pBuffer);
+            if (nLength == -1) {
+                nLength = baBuffer.size();
+            }
 
-        delete[] pBuffer;
+            sResult = QString::fromUtf8(baBuffer.constData(), (qint32)nLength);
+        }
     }
 
     return sResult;
@@ -2561,23 +2860,35 @@ QString XBinary::read_unicodeString(qint64 nOffset, qint64 nMaxSize, bool bIsBig
     QString sResult;
 
     if ((nMaxSize > 0) && (nMaxSize < 0x10000)) {
-        quint16 *pBuffer = new quint16[nMaxSize + 1];
+        quint16 szBuffer[256];
+        QVector<quint16> listBuffer;
 
-        for (qint32 i = 0; i < nMaxSize; i++) {
-            pBuffer[i] = read_uint16(nOffset + 2 * i, bIsBigEndian);
+        quint16 *pData = szBuffer;
+        qint64 nSize = qMax(read_array(nOffset, (char *)szBuffer, 2 * qMin(nMaxSize, (qint64)256)), (qint64)0);
+        qint64 nLength = _x_find_null_word((char *)pData, nSize);
 
-            if (pBuffer[i] == 0) {
-                break;
-            }
+        if ((nLength == -1) && (nSize == (qint64)sizeof(szBuffer)) && (nMaxSize > 256)) {
+            listBuffer.resize((qint32)nMaxSize);
+            pData = listBuffer.data();
+            nSize = qMax(read_array(nOffset, (char *)pData, 2 * nMaxSize), (qint64)0);
+            nLength = _x_find_null_word((char *)pData, nSize);
+        }
 
-            if (i == nMaxSize - 1) {
-                pBuffer[nMaxSize] = 0;
-            }
+        if (nLength == -1) {
+            nLength = nSize & ~((qint64)1);
         }
 
-        sResult = QString::fromUtf16(pBuffer);  // TODO Check Qt6
+        qint32 nNumberOfChars = (qint32)(nLength / 2);
 
-        delete[] pBuffer;
+        for (qint32 i = 0; i < nNumberOfChars; i++) {
+            if (bIsBigEndian) {
+                pData[i] = qFromBigEndian(pData[i]);
+            } else {
+                pData[i] = qFromLittleEndian(pData[i]);
+            }
+        }
+
+        sResult = QString::fromUtf16(pData, nNumberOfChars);  // TODO Check Qt6
     }
 
     return sResult;
@@ -2589,29 +2900,22 @@ QString XBinary::read_ucsdString(qint64 nOffset)
 
     qint32 nSize = read_uint8(nOffset);
 
-    if (nSize > 0x10000) {
-        nSize = 0x10000;
-    }
-
     if (nSize > 0) {
-        nOffset++;
-        quint8 *pBuffer = new quint8[nSize + 1];
-
-        for (qint32 i = 0; i < nSize; i++) {
-            pBuffer[i] = read_uint8(nOffset + i);
+        char szBuffer[256];
 
-            if (pBuffer[i] == 0) {
-                pBuffer[i] = 0x20;  // Space
-            }
+        qint32 nRead = (qint32)qMax(read_array(nOffset + 1, szBuffer, nSize), (qint64)0);
 
-            if (i == nSize - 1) {
-                pBuffer[nSize] = 0;
+        for (qint32 i = 0; i < nRead; i++) {
+            if (szBuffer[i] == 0) {
+                szBuffer[i] = 0x20;  // Space
             }
         }
 
-        sResult.append((char *)pBuffer);
+        if (nRead < nSize) {
+            memset(szBuffer + nRead, 0x20, nSize - nRead);
+        }
 
-        delete[] pBuffer;
+        sResult = QString::fromUtf8(szBuffer, nSize);
     }
 
     return sResult;
@@ -2621,31 +2925,57 @@ QString XBinary::read_utf8String(qint64 nOffset, qint64 nMaxSize)
 {
     QString sResult;
 
-    if (nMaxSize) {
-        qint32 nRealSize = 0;
+    if (nMaxSize > 0) {
+        // The string is read in chunks; only strings longer than one chunk need a temp buffer
+        char szBuffer[256];
+        QByteArray baString;
+        qint64 nNumberOfChars = 0;
+        bool bFinished = false;
 
-        for (qint32 i = 0; i < nMaxSize; i++) {
-            quint8 nByte = read_uint8(nOffset + nRealSize);
+        while (!bFinished) {
+            qint64 nSize = read_array(nOffset, szBuffer, sizeof(szBuffer));
 
-            if (nByte == 0) {
+            if (nSize <= 0) {
                 break;
             }
 
-            // TODO Check !!!
-            if ((nByte >> 7) & 0x1) {
-                nRealSize++;
-            } else if ((nByte >> 5) & 0x1) {
-                nRealSize += 2;
-            } else if ((nByte >> 4) & 0x1) {
-                nRealSize += 3;
-            } else if ((nByte >> 3) & 0x1) {
-                nRealSize += 4;
+            qint64 nLimit = _x_find_null_byte(szBuffer, nSize);
+            bool bLastChunk = (nLimit != -1) || (nSize < (qint64)sizeof(szBuffer));
+
+            if (nLimit == -1) {
+                nLimit = nSize;
+            }
+
+            qint64 i = 0;
+
+            while ((i < nLimit) && (nNumberOfChars < nMaxSize)) {
+                qint32 nSequenceSize = _x_utf8_sequence_size((quint8)szBuffer[i]);
+
+                if (i + nSequenceSize > nLimit) {
+                    if (bLastChunk) {
+                        i = nLimit;
+                    }
+
+                    break;
+                }
+
+                i += nSequenceSize;
+                nNumberOfChars++;
+            }
+
+            bFinished = bLastChunk || (nNumberOfChars >= nMaxSize) || (i == 0);
+
+            if (bFinished && baString.isEmpty()) {
+                sResult = QString::fromUtf8(szBuffer, (qint32)i);
+            } else {
+                baString.append(szBuffer, (qint32)i);
             }
+
+            nOffset += i;
         }
 
-        if (nRealSize) {
-            QByteArray baString = read_array(nOffset, nRealSize);
-            sResult = QString::fromUtf8(baString.data());
+        if (!baString.isEmpty()) {
+            sResult = QString::fromUtf8(baString.constData(), baString.size());
         }
     }
 
@@ -3035,23 +3365,151 @@ quint64 XBinary::_read_value(MODE mode, char *pData, bool bIsBigEndian)
     return nResult;
 }
 
-quint8 XBinary::_read_uint8_safe(char *pBuffer, qint32 nBufferSize, qint32 nOffset)
+void XBinary::_toHostEndian16(quint16 *pData, qint64 nCount, bool bIsBigEndian)
 {
-    quint8 result = 0;
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+    bool bSwap = !bIsBigEndian;
+#else
+    bool bSwap = bIsBigEndian;
+#endif
 
-    if ((nOffset >= 0) && (nOffset < nBufferSize)) {
-        result = _read_uint8(pBuffer + nOffset);
+    if (bSwap && (nCount > 0)) {
+#ifdef USE_XSIMD
+        xsimd_bswap16(pData, nCount);
+#else
+        for (qint64 i = 0; i < nCount; i++) {
+            pData[i] = qbswap(pData[i]);
+        }
+#endif
     }
-
-    return result;
 }
 
-quint16 XBinary::_read_uint16_safe(char *pBuffer, qint32 nBufferSize, qint32 nOffset, bool bIsBigEndian)
+void XBinary::_toHostEndian32(quint32 *pData, qint64 nCount, bool bIsBigEndian)
 {
-    quint16 result = 0;
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+    bool bSwap = !bIsBigEndian;
+#else
+    bool bSwap = bIsBigEndian;
+#endif
 
-    if ((nOffset >= 0) && (nOffset + 1 < nBufferSize)) {
-        result = _read_uint16(pBuffer + nOffset, bIsBigEndian);
+    if (bSwap && (nCount > 0)) {
+#ifdef USE_XSIMD
+        xsimd_bswap32(pData, nCount);
+#else
+        for (qint64 i = 0; i < nCount; i++) {
+            pData[i] = qbswap(pData[i]);
+        }
+#endif
+    }
+}
+
+void XBinary::_toHostEndian64(quint64 *pData, qint64 nCount, bool bIsBigEndian)
+{
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+    bool bSwap = !bIsBigEndian;
+#else
+    bool bSwap = bIsBigEndian;
+#endif
+
+    if (bSwap && (nCount > 0)) {
+#ifdef USE_XSIMD
+        xsimd_bswap64(pData, nCount);
+#else
+        for (qint64 i = 0; i < nCount; i++) {
+            pData[i] = qbswap(pData[i]);
+        }
+#endif
+    }
+}
+
+void XBinary::_swapStructFields(char *pData, qint32 nStructSize, qint32 nCount, const XBINARY_DEF::STRUCT_FIELD *pFields, qint32 nNumberOfFields,
+                                bool bIsBigEndian)
+{
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+    bool bSwap = !bIsBigEndian;
+#else
+    bool bSwap = bIsBigEndian;
+#endif
+
+    if (bSwap && (nCount > 0)) {
+        // Structures made of same-width fields only are swapped as one flat array
+        qint32 nFieldSize = pFields[0].nSize;
+        qint32 nTotalSize = 0;
+
+        for (qint32 j = 0; j < nNumberOfFields; j++) {
+            if (pFields[j].nSize != nFieldSize) {
+                nFieldSize = 0;
+                break;
+            }
+
+            nTotalSize += pFields[j].nSize;
+        }
+
+        if (nTotalSize != nStructSize) {
+            nFieldSize = 0;
+        }
+
+        qint64 nNumberOfValues = 0;
+
+        if (nFieldSize) {
+            nNumberOfValues = ((qint64)nCount * nStructSize) / nFieldSize;
+        }
+
+        if (nFieldSize == 2) {
+            _toHostEndian16((quint16 *)pData, nNumberOfValues, bIsBigEndian);
+            nCount = 0;
+        } else if (nFieldSize == 4) {
+            _toHostEndian32((quint32 *)pData, nNumberOfValues, bIsBigEndian);
+            nCount = 0;
+        } else if (nFieldSize == 8) {
+            _toHostEndian64((quint64 *)pData, nNumberOfValues, bIsBigEndian);
+            nCount = 0;
+        }
+
+        for (qint32 i = 0; i < nCount; i++) {
+            for (qint32 j = 0; j < nNumberOfFields; j++) {
+                char *pField = pData + pFields[j].nOffset;
+
+                if (pFields[j].nSize == 2) {
+                    quint16 nValue = 0;
+                    memcpy(&nValue, pField, 2);
+                    nValue = qbswap(nValue);
+                    memcpy(pField, &nValue, 2);
+                } else if (pFields[j].nSize == 4) {
+                    quint32 nValue = 0;
+                    memcpy(&nValue, pField, 4);
+                    nValue = qbswap(nValue);
+                    memcpy(pField, &nValue, 4);
+                } else if (pFields[j].nSize == 8) {
+                    quint64 nValue = 0;
+                    memcpy(&nValue, pField, 8);
+                    nValue = qbswap(nValue);
+                    memcpy(pField, &nValue, 8);
+                }
+            }
+
+            pData += nStructSize;
+        }
+    }
+}
+
+quint8 XBinary::_read_uint8_safe(char *pBuffer, qint32 nBufferSize, qint32 nOffset)
+{
+    quint8 result = 0;
+
+    if ((nOffset >= 0) && (nOffset < nBufferSize)) {
+        result = _read_uint8(pBuffer + nOffset);
+    }
+
+    return result;
+}
+
+quint16 XBinary::_read_uint16_safe(char *pBuffer, qint32 nBufferSize, qint32 nOffset, bool bIsBigEndian)
+{
+    quint16 result = 0;
+
+    if ((nOffset >= 0) && (nOffset + 1 < nBufferSize)) {
+        result = _read_uint16(pBuffer + nOffset, bIsBigEndian);
     }
 
     return result;
@@ -3345,6 +3803,26 @@ static qint64 _x_findpattern_bmh(char *pBuffer, qint64 nTemp, const char *pArray
     return nResult;
 }
 
+static qint64 _x_find_masked(const char *pBuffer, qint64 nTemp, const char *pPattern, const char *pMask, qint64 nPatternSize, qint64 nOffset)
+{
+    qint64 nResult = -1;
+
+#ifdef USE_XSIMD
+    nResult = xsimd_find_pattern_masked(pBuffer, nTemp, pPattern, pMask, nPatternSize, nOffset);
+#else
+    const qint64 limit = nTemp - nPatternSize;
+
+    for (qint64 i = 0; i <= limit; ++i) {
+        if (XBinary::compareMemoryMasked(pBuffer + i, pPattern, pMask, nPatternSize)) {
+            nResult = nOffset + i;
+            break;
+        }
+    }
+#endif
+
+    return nResult;
+}
+
 static qint64 _x_find_notnull(char *pBuffer, qint64 nTemp, qint64 nArraySize, qint64 nOffset)
 {
     qint64 nResult = -1;
@@ -3562,6 +4040,10 @@ qint64 XBinary::_find_array(ST st, qint64 nOffset, qint64 nSize, const char *pAr
         return -1;
     }
 
+    if (_isParallelSearch(nSize, nArraySize)) {
+        return _find_parallel(st, nOffset, nSize, pArray, nullptr, nArraySize, pPdStruct);
+    }
+
     qint64 nTemp = 0;
 
     qint32 _nFreeIndex = XBinary::getFreeIndex(pPdStruct);
@@ -3682,6 +4164,282 @@ qint64 XBinary::find_byteArray(qint64 nOffset, qint64 nSize, const QByteArray &b
     return _find_array(ST_COMPAREBYTES, nOffset, nSize, baData.data(), baData.size(), pPdStruct);
 }
 
+qint64 XBinary::find_masked(qint64 nOffset, qint64 nSize, const char *pPattern, const char *pMask, qint64 nPatternSize, PDSTRUCT *pPdStruct)
+{
+    qint64 nResult = -1;
+
+    PDSTRUCT pdStructEmpty = XBinary::createPdStruct();
+
+    if (!pPdStruct) {
+        pPdStruct = &pdStructEmpty;
+    }
+
+    if ((!pPattern) || (!pMask) || (nPatternSize <= 0)) {
+        return -1;
+    }
+
+    qint64 _nSize = getSize();
+
+    if (nSize == -1) {
+        nSize = _nSize - nOffset;
+    }
+
+    if ((nSize <= 0) || (nOffset < 0) || (nOffset + nSize > _nSize) || (nPatternSize > nSize)) {
+        return -1;
+    }
+
+    if (_isParallelSearch(nSize, nPatternSize)) {
+        return _find_parallel(ST_COMPAREBYTES, nOffset, nSize, pPattern, pMask, nPatternSize, pPdStruct);
+    }
+
+    qint32 _nFreeIndex = XBinary::getFreeIndex(pPdStruct);
+    XBinary::setPdStructInit(pPdStruct, _nFreeIndex, nSize);
+
+    qint64 nStartOffset = nOffset;
+
+    char *pBuffer = nullptr;
+
+    qint32 nBufferSize = getBufferSize(pPdStruct);
+
+    if (!m_pConstMemory) {
+        pBuffer = new char[nBufferSize];
+    }
+
+    while ((nSize > nPatternSize - 1) && (!(pPdStruct->bIsStop))) {
+        qint64 nTemp = (nSize < nBufferSize) ? nSize : nBufferSize;
+
+        if (m_pConstMemory) {
+            pBuffer = (char *)m_pConstMemory + nOffset;
+        } else {
+            qint64 nBytesRead = read_array_process(nOffset, pBuffer, nTemp, pPdStruct);
+
+            if (nBytesRead != nTemp) {
+                pPdStruct->sInfoString = tr("Read error");
+                break;
+            }
+        }
+
+        nResult = _x_find_masked(pBuffer, nTemp, pPattern, pMask, nPatternSize, nOffset);
+
+        if (nResult != -1) {
+            break;
+        }
+
+        // Buffers overlap by nPatternSize - 1 bytes so that no match is split
+        nSize -= nTemp - (nPatternSize - 1);
+        nOffset += nTemp - (nPatternSize - 1);
+
+        XBinary::setPdStructCurrent(pPdStruct, _nFreeIndex, nOffset - nStartOffset);
+    }
+
+    if (!m_pConstMemory) {
+        delete[] pBuffer;
+    }
+
+    setPdStructFinished(pPdStruct, _nFreeIndex);
+
+    return nResult;
+}
+
+// Parallel search: chunks are handed out in offset order, so once chunk N has a hit no chunk above N can hold the first match
+static const qint64 _XBINARY_PARALLEL_SEARCH_CHUNK = 0x400000;
+static const qint64 _XBINARY_PARALLEL_SEARCH_MIN = 4 * _XBINARY_PARALLEL_SEARCH_CHUNK;
+static const qint32 _XBINARY_PARALLEL_SEARCH_POLL_MS = 50;
+
+struct _XBINARY_SEARCH_STATE {
+    XBinary::ST st;
+    const char *pArray;
+    const char *pMask;  // nullptr => _find_array
+    qint64 nArraySize;
+    qint64 nOffset;
+    qint64 nSize;
+    qint64 nNumberOfChunks;
+    qint64 *pResults;  // One per chunk
+    XBinary::PDSTRUCT *pPdStructs;  // One per worker; bIsStop cancels the chunk it is scanning
+    QAtomicInteger<qint64> *pCurrentChunks;  // One per worker
+    qint32 nNumberOfWorkers;
+    QAtomicInteger<qint64> nNextChunk;
+    QAtomicInteger<qint64> nFirstHitChunk;
+    QAtomicInteger<qint64> nProcessed;
+    QAtomicInt nIsStop;
+    QAtomicInt nIsReadError;
+};
+
+// Stops the workers that scan a chunk above nChunk; -1 stops all of them
+static void _x_cancelSearchChunks(_XBINARY_SEARCH_STATE *pState, qint64 nChunk)
+{
+    for (qint32 i = 0; i < pState->nNumberOfWorkers; i++) {
+        if (pState->pCurrentChunks[i].loadAcquire() > nChunk) {
+            pState->pPdStructs[i].bIsStop = true;
+        }
+    }
+}
+
+class _XBinarySearchWorker : public QRunnable {
+public:
+    _XBinarySearchWorker(XBinary *pBinary, _XBINARY_SEARCH_STATE *pState, qint32 nIndex)
+    {
+        m_pBinary = pBinary;
+        m_pState = pState;
+        m_nIndex = nIndex;
+    }
+
+    virtual void run()
+    {
+        XBinary::PDSTRUCT *pPdStruct = &(m_pState->pPdStructs[m_nIndex]);
+
+        while (true) {
+            qint64 nChunk = m_pState->nNextChunk.fetchAndAddOrdered(1);
+
+            if (nChunk >= m_pState->nNumberOfChunks) {
+                break;
+            }
+
+            // The chunk is published before the stop checks, so a canceller either is seen here or sees this chunk
+            pPdStruct->bIsStop = false;
+            m_pState->pCurrentChunks[m_nIndex].fetchAndStoreOrdered(nChunk);
+
+            if (m_pState->nIsStop.loadAcquire() || (nChunk > m_pState->nFirstHitChunk.loadAcquire())) {
+                break;
+            }
+
+            // Chunks overlap by nArraySize - 1 bytes, so each match starts in exactly one chunk
+            qint64 nChunkOffset = m_pState->nOffset + nChunk * _XBINARY_PARALLEL_SEARCH_CHUNK;
+            qint64 nChunkSize = qMin(_XBINARY_PARALLEL_SEARCH_CHUNK + m_pState->nArraySize - 1, m_pState->nOffset + m_pState->nSize - nChunkOffset);
+            qint64 nResult = -1;
+
+            if (nChunkSize >= m_pState->nArraySize) {
+                pPdStruct->sInfoString.clear();
+
+                if (m_pState->pMask) {
+                    nResult = m_pBinary->find_masked(nChunkOffset, nChunkSize, m_pState->pArray, m_pState->pMask, m_pState->nArraySize, pPdStruct);
+                } else {
+                    nResult = m_pBinary->_find_array(m_pState->st, nChunkOffset, nChunkSize, m_pState->pArray, m_pState->nArraySize, pPdStruct);
+                }
+
+                if (pPdStruct->sInfoString.size()) {
+                    m_pState->nIsReadError.storeRelease(1);
+                }
+            }
+
+            m_pState->pResults[nChunk] = nResult;
+
+            if (nResult != -1) {
+                qint64 nFirstHitChunk = m_pState->nFirstHitChunk.loadAcquire();
+
+                while ((nChunk < nFirstHitChunk) && (!m_pState->nFirstHitChunk.testAndSetOrdered(nFirstHitChunk, nChunk))) {
+                    nFirstHitChunk = m_pState->nFirstHitChunk.loadAcquire();
+                }
+
+                _x_cancelSearchChunks(m_pState, m_pState->nFirstHitChunk.loadAcquire());
+            }
+
+            m_pState->nProcessed.fetchAndAddOrdered(qMin(_XBINARY_PARALLEL_SEARCH_CHUNK, nChunkSize));
+        }
+    }
+
+private:
+    XBinary *m_pBinary;
+    _XBINARY_SEARCH_STATE *m_pState;
+    qint32 m_nIndex;
+};
+
+bool XBinary::_isConcurrentReadSafe()
+{
+    // Workers read concurrently, which needs constant memory or positional reads; a bound read budget is per thread
+    return (m_pConstMemory || m_pPositionalDevice) && (!getReadBudget());
+}
+
+bool XBinary::_isParallelSearch(qint64 nSize, qint64 nArraySize)
+{
+    return (m_nSearchThreads > 1) && (nSize >= _XBINARY_PARALLEL_SEARCH_MIN) && (nArraySize <= _XBINARY_PARALLEL_SEARCH_CHUNK) && _isConcurrentReadSafe();
+}
+
+qint64 XBinary::_find_parallel(ST st, qint64 nOffset, qint64 nSize, const char *pArray, const char *pMask, qint64 nArraySize, PDSTRUCT *pPdStruct)
+{
+    qint64 nResult = -1;
+
+    PDSTRUCT pdStructEmpty = XBinary::createPdStruct();
+
+    if (!pPdStruct) {
+        pPdStruct = &pdStructEmpty;
+    }
+
+    qint64 nNumberOfChunks = (nSize + _XBINARY_PARALLEL_SEARCH_CHUNK - 1) / _XBINARY_PARALLEL_SEARCH_CHUNK;
+
+    qint32 nNumberOfThreads = (qint32)qMin((qint64)m_nSearchThreads, nNumberOfChunks);
+
+    QVector<qint64> listResults(nNumberOfChunks, -1);
+    QVector<PDSTRUCT> listPdStructs(nNumberOfThreads, XBinary::createPdStruct());
+    QVector<QAtomicInteger<qint64>> listCurrentChunks(nNumberOfThreads, QAtomicInteger<qint64>(-1));
+
+    for (qint32 i = 0; i < nNumberOfThreads; i++) {
+        listPdStructs[i].nBufferSize = pPdStruct->nBufferSize;
+    }
+
+    _XBINARY_SEARCH_STATE state;
+    state.st = st;
+    state.pArray = pArray;
+    state.pMask = pMask;
+    state.nArraySize = nArraySize;
+    state.nOffset = nOffset;
+    state.nSize = nSize;
+    state.nNumberOfChunks = nNumberOfChunks;
+    state.pResults = listResults.data();
+    state.pPdStructs = listPdStructs.data();
+    state.pCurrentChunks = listCurrentChunks.data();
+    state.nNumberOfWorkers = nNumberOfThreads;
+    state.nNextChunk.storeRelease(0);
+    state.nFirstHitChunk.storeRelease(nNumberOfChunks);
+    state.nProcessed.storeRelease(0);
+    state.nIsStop.storeRelease(0);
+    state.nIsReadError.storeRelease(0);
+
+    qint32 _nFreeIndex = XBinary::getFreeIndex(pPdStruct);
+    XBinary::setPdStructInit(pPdStruct, _nFreeIndex, nSize);
+
+    // One pool per instance: signature and candidate loops call this once per candidate
+    if (!m_pSearchThreadPool) {
+        m_pSearchThreadPool = new QThreadPool;
+    }
+
+    m_pSearchThreadPool->setMaxThreadCount(nNumberOfThreads);
+
+    for (qint32 i = 0; i < nNumberOfThreads; i++) {
+        m_pSearchThreadPool->start(new _XBinarySearchWorker(this, &state, i));
+    }
+
+    bool bIsStopForwarded = false;
+
+    // The calling thread forwards stop requests and reports progress
+    while (!m_pSearchThreadPool->waitForDone(_XBINARY_PARALLEL_SEARCH_POLL_MS)) {
+        if ((!bIsStopForwarded) && (pPdStruct->bIsStop)) {
+            state.nIsStop.storeRelease(1);
+            _x_cancelSearchChunks(&state, -1);
+
+            bIsStopForwarded = true;
+        }
+
+        XBinary::setPdStructCurrent(pPdStruct, _nFreeIndex, state.nProcessed.loadAcquire());
+    }
+
+    if (!(pPdStruct->bIsStop)) {
+        qint64 nFirstHitChunk = state.nFirstHitChunk.loadAcquire();
+
+        if (nFirstHitChunk < nNumberOfChunks) {
+            nResult = listResults.at(nFirstHitChunk);
+        }
+    }
+
+    if (state.nIsReadError.loadAcquire() && (nResult == -1)) {
+        pPdStruct->sInfoString = tr("Read error");
+    }
+
+    XBinary::setPdStructFinished(pPdStruct, _nFreeIndex);
+
+    return nResult;
+}
+
 qint64 XBinary::find_uint8(qint64 nOffset, qint64 nSize, quint8 nValue, PDSTRUCT *pPdStruct)
 {
     quint8 baValue[1];
@@ -3914,6 +4672,12 @@ qint64 XBinary::find_signature(qint64 nOffset, qint64 nSize, const QString &sSig
 }
 
 qint64 XBinary::find_signature(_MEMORY_MAP *pMemoryMap, qint64 nOffset, qint64 nSize, const QString &sSignature, qint64 *pnResultSize, PDSTRUCT *pPdStruct)
+{
+    return find_signature(pMemoryMap, nOffset, nSize, getCompiledSignature(sSignature), pnResultSize, pPdStruct);
+}
+
+qint64 XBinary::find_signature(_MEMORY_MAP *pMemoryMap, qint64 nOffset, qint64 nSize, const COMPILED_SIGNATURE &compiledSignature, qint64 *pnResultSize,
+                               PDSTRUCT *pPdStruct)
 {
     PDSTRUCT pdStructEmpty = XBinary::createPdStruct();
 
@@ -3921,14 +4685,6 @@ qint64 XBinary::find_signature(_MEMORY_MAP *pMemoryMap, qint64 nOffset, qint64 n
         pPdStruct = &pdStructEmpty;
     }
 
-    //    bool bDisableSignals=true;
-
-    //    if(pPdStruct->bIsDisable) // If we call find_signature in another
-    //    search function
-    //    {
-    //        bDisableSignals=false; // TODO Check !!!
-    //    }
-
     // TODO CheckSize function
     qint64 _nSize = getSize();
 
@@ -3951,55 +4707,30 @@ qint64 XBinary::find_signature(_MEMORY_MAP *pMemoryMap, qint64 nOffset, qint64 n
         return -1;
     }
 
-    QString _sSignature = convertSignature(sSignature);
+    *pnResultSize = compiledSignature.nResultSize;
 
-    if (_sSignature.contains(QChar('$')) || _sSignature.contains(QChar('#')) || _sSignature.contains(QChar('+'))) {
-        *pnResultSize = 1;
-    } else {
-        // Fix size
-        *pnResultSize = _sSignature.size() / 2;
+    if ((!compiledSignature.bIsPlain) && compiledSignature.sInfoString.size()) {
+        setPdStructInfoString(pPdStruct, compiledSignature.sInfoString);
     }
 
     qint64 nResult = -1;
 
-    if (_sSignature.contains(QChar('.')) || _sSignature.contains(QChar('$')) || _sSignature.contains(QChar('#')) || _sSignature.contains(QChar('+')) ||
-        _sSignature.contains(QChar('*')) || _sSignature.contains(QChar('%')) || _sSignature.contains(QChar('!')) || _sSignature.contains(QChar('_')) ||
-        _sSignature.contains(QChar('&'))) {
-        bool bIsValid = true;
+    if (compiledSignature.bIsMasked) {
+        // Only the start of a match has to be in the region; the rest may run on to the end of the file
+        qint64 nPatternSize = compiledSignature.baMaskedPattern.size();
+        qint64 nMaskedSize = qMin(nSize + nPatternSize - 1, _nSize - nOffset);
 
-        QList<SIGNATURE_RECORD> listSignatureRecords = getSignatureRecords(_sSignature, &bIsValid, pPdStruct);
+        nResult = find_masked(nOffset, nMaskedSize, compiledSignature.baMaskedPattern.constData(), compiledSignature.baMask.constData(), nPatternSize, pPdStruct);
+    } else if (!compiledSignature.bIsPlain) {
+        const QList<SIGNATURE_RECORD> *pListSignatureRecords = &(compiledSignature.listRecords);
 
-        if (listSignatureRecords.count()) {
+        if (pListSignatureRecords->count()) {
             qint32 _nFreeIndex = XBinary::getFreeIndex(pPdStruct);
 
-            qint32 nSearchFirstIndex = 0;
-            qint64 nDelta = 0;
-            ST stIndex = ST_COMPAREBYTES;
-            qint64 nSearchMaxSize = 0;
-
-            if (!_sSignature.contains(QChar('+'))) {
-                qint32 nNumberOfRecords = listSignatureRecords.count();
-                qint64 nCurrentDelta = 0;
-
-                for (qint32 i = 0; i < nNumberOfRecords; i++) {
-                    if ((listSignatureRecords.at(i).st == ST_ADDRESS) || (listSignatureRecords.at(i).st == ST_RELOFFSET)) {
-                        break;
-                    } else if ((listSignatureRecords.at(i).nWindowSize > nSearchMaxSize) && (
-                                   (listSignatureRecords.at(i).st == ST_COMPAREBYTES) ||
-                                   (listSignatureRecords.at(i).st == ST_FINDBYTES) ||
-                                   (listSignatureRecords.at(i).st == ST_NOTNULL) ||
-                                   (listSignatureRecords.at(i).st == ST_ANSI) ||
-                                   (listSignatureRecords.at(i).st == ST_NOTANSI) ||
-                                   (listSignatureRecords.at(i).st == ST_NOTANSIANDNULL) ||
-                                   (listSignatureRecords.at(i).st == ST_ANSINUMBER))) {
-                        nSearchMaxSize = listSignatureRecords.at(i).nWindowSize;
-                        stIndex = listSignatureRecords.at(i).st;
-                        nDelta = nCurrentDelta;
-                        nSearchFirstIndex = i;
-                    }
-                    nCurrentDelta += listSignatureRecords.at(i).nWindowSize;
-                }
-            }
+            qint32 nSearchFirstIndex = compiledSignature.nSearchFirstIndex;
+            qint64 nDelta = compiledSignature.nSearchDelta;
+            ST stIndex = compiledSignature.stSearch;
+            qint64 nSearchMaxSize = compiledSignature.nSearchMaxSize;
 
             if (nSearchFirstIndex > 0) {
                 qint64 nTmpOffset = nOffset + nDelta;
@@ -4007,9 +4738,9 @@ qint64 XBinary::find_signature(_MEMORY_MAP *pMemoryMap, qint64 nOffset, qint64 n
 
                 XBinary::setPdStructInit(pPdStruct, _nFreeIndex, nTmpSize);
 
-                QByteArray baData = listSignatureRecords.at(nSearchFirstIndex).baData;
+                const QByteArray &baData = pListSignatureRecords->at(nSearchFirstIndex).baData;
 
-                char *pData = baData.data();
+                const char *pData = baData.constData();
                 qint32 nDataSize = baData.size();
 
                 for (qint64 i = 0; (i < nTmpSize) && (!(pPdStruct->bIsStop));) {
@@ -4023,7 +4754,7 @@ qint64 XBinary::find_signature(_MEMORY_MAP *pMemoryMap, qint64 nOffset, qint64 n
                     }
 
                     if (nCurrentOffset != -1) {
-                        if (_compareSignature(pMemoryMap, &listSignatureRecords, nCurrentOffset - nDelta, pPdStruct)) {
+                        if (_compareSignature(pMemoryMap, pListSignatureRecords, nCurrentOffset - nDelta, pPdStruct)) {
                             nResult = nCurrentOffset - nDelta;
 
                             break;
@@ -4036,29 +4767,29 @@ qint64 XBinary::find_signature(_MEMORY_MAP *pMemoryMap, qint64 nOffset, qint64 n
 
                     XBinary::setPdStructCurrent(pPdStruct, _nFreeIndex, i);
                 }
-            } else if ((listSignatureRecords.at(0).st == ST_COMPAREBYTES) || (listSignatureRecords.at(0).st == ST_FINDBYTES) ||
-                       (listSignatureRecords.at(0).st == ST_NOTNULL) || (listSignatureRecords.at(0).st == ST_ANSI) || (listSignatureRecords.at(0).st == ST_NOTANSI) ||
-                       (listSignatureRecords.at(0).st == ST_NOTANSIANDNULL) || (listSignatureRecords.at(0).st == ST_ANSINUMBER)) {
-                ST _st = listSignatureRecords.at(0).st;
+            } else if ((pListSignatureRecords->at(0).st == ST_COMPAREBYTES) || (pListSignatureRecords->at(0).st == ST_FINDBYTES) ||
+                       (pListSignatureRecords->at(0).st == ST_NOTNULL) || (pListSignatureRecords->at(0).st == ST_ANSI) || (pListSignatureRecords->at(0).st == ST_NOTANSI) ||
+                       (pListSignatureRecords->at(0).st == ST_NOTANSIANDNULL) || (pListSignatureRecords->at(0).st == ST_ANSINUMBER)) {
+                ST _st = pListSignatureRecords->at(0).st;
 
-                if (listSignatureRecords.at(0).st == ST_FINDBYTES) {
+                if (pListSignatureRecords->at(0).st == ST_FINDBYTES) {
                     _st = ST_COMPAREBYTES;
                 }
 
                 XBinary::setPdStructInit(pPdStruct, _nFreeIndex, nSize);
 
-                QByteArray baFirst = listSignatureRecords.at(0).baData;
+                const QByteArray &baFirst = pListSignatureRecords->at(0).baData;
 
-                char *pData = baFirst.data();
+                const char *pData = baFirst.constData();
                 // For ST_COMPAREBYTES (including remapped ST_FINDBYTES), use the actual baFirst size.
                 // For other ST_* modes, use the recorded window size.
-                qint32 nDataSize = (_st == ST_COMPAREBYTES) ? baFirst.size() : listSignatureRecords.at(0).nWindowSize;
+                qint32 nDataSize = (_st == ST_COMPAREBYTES) ? baFirst.size() : pListSignatureRecords->at(0).nWindowSize;
 
                 for (qint64 i = 0; (i < nSize) && (!(pPdStruct->bIsStop));) {
                     qint64 nTempOffset = _find_array(_st, nOffset + i, nSize - i, pData, nDataSize, pPdStruct);
 
                     if (nTempOffset != -1) {
-                        if (_compareSignature(pMemoryMap, &listSignatureRecords, nTempOffset, pPdStruct)) {
+                        if (_compareSignature(pMemoryMap, pListSignatureRecords, nTempOffset, pPdStruct)) {
                             nResult = nTempOffset;
 
                             break;
@@ -4073,7 +4804,7 @@ qint64 XBinary::find_signature(_MEMORY_MAP *pMemoryMap, qint64 nOffset, qint64 n
                 }
             } else {
                 for (qint64 i = 0; (i < nSize) && (!(pPdStruct->bIsStop)); i++) {
-                    if (_compareSignature(pMemoryMap, &listSignatureRecords, nOffset + i, pPdStruct)) {
+                    if (_compareSignature(pMemoryMap, pListSignatureRecords, nOffset + i, pPdStruct)) {
                         nResult = nOffset + i;
                         break;
                     }
@@ -4085,10 +4816,8 @@ qint64 XBinary::find_signature(_MEMORY_MAP *pMemoryMap, qint64 nOffset, qint64 n
             XBinary::setPdStructFinished(pPdStruct, _nFreeIndex);
         }
     } else {
-        QByteArray baData = QByteArray::fromHex(QByteArray(_sSignature.toLatin1().data()));
-
-        if (baData.size()) {
-            nResult = find_array(nOffset, nSize, baData.data(), baData.size(), pPdStruct);
+        if (compiledSignature.baPlain.size()) {
+            nResult = find_array(nOffset, nSize, compiledSignature.baPlain.constData(), compiledSignature.baPlain.size(), pPdStruct);
         }
     }
 
@@ -4447,6 +5176,9 @@ bool XBinary::_addMultiSearchStringRecordOptimized(QVector<MS_RECORD> *pList, MS
     return false;
 }
 
+// Default number of records multiSearch_allStringsNext returns at most
+static const qint32 _XBINARY_STRINGS_BATCH_SIZE = 0x1000;
+
 QVector<XBinary::MS_RECORD> XBinary::multiSearch_allStrings(_MEMORY_MAP *pMemoryMap, qint64 nOffset, qint64 nSize, STRINGSEARCH_OPTIONS ssOptions, PDSTRUCT *pPdStruct)
 {
     PDSTRUCT pdStructEmpty = XBinary::createPdStruct();
@@ -4455,13 +5187,42 @@ QVector<XBinary::MS_RECORD> XBinary::multiSearch_allStrings(_MEMORY_MAP *pMemory
         pPdStruct = &pdStructEmpty;
     }
 
-    OFFSETSIZE osRegion = convertOffsetAndSize(nOffset, nSize);
-
-    nOffset = osRegion.nOffset;
-    nSize = osRegion.nSize;
-
     QVector<XBinary::MS_RECORD> listResult;
 
+    STRINGSCAN_STATE state = multiSearch_allStringsBegin(pMemoryMap, nOffset, nSize, ssOptions);
+    state.nLimit = qMax(ssOptions.nLimit, 0);  // Here the limit is always on
+
+    qint32 _nFreeIndex = XBinary::getFreeIndex(pPdStruct);
+
+    XBinary::setPdStructInit(pPdStruct, _nFreeIndex, state.nSize);
+
+    bool bContinue = true;
+
+    while (bContinue) {
+        bContinue = multiSearch_allStringsNext(&state, &listResult, 0, pPdStruct);
+
+        XBinary::setPdStructCurrent(pPdStruct, _nFreeIndex, state.nCurrentOffset - state.nOffset);
+    }
+
+    if (state.bIsLimit) {
+        pPdStruct->sInfoString = QString("%1: %2").arg(tr("Maximum"), QString::number(state.nNumberOfRecords));
+    }
+
+    if (state.bIsReadError) {
+        pPdStruct->sInfoString = tr("Read error");
+    }
+
+    XBinary::setPdStructFinished(pPdStruct, _nFreeIndex);
+
+    return listResult;
+}
+
+XBinary::STRINGSCAN_STATE XBinary::multiSearch_allStringsBegin(_MEMORY_MAP *pMemoryMap, qint64 nOffset, qint64 nSize, STRINGSEARCH_OPTIONS ssOptions)
+{
+    STRINGSCAN_STATE result = {};
+
+    OFFSETSIZE osRegion = convertOffsetAndSize(nOffset, nSize);
+
     if (ssOptions.nMinLenght == 0) {
         ssOptions.nMinLenght = 1;
     }
@@ -4470,62 +5231,96 @@ QVector<XBinary::MS_RECORD> XBinary::multiSearch_allStrings(_MEMORY_MAP *pMemory
         ssOptions.nMaxLenght = 128;  // TODO Check
     }
 
-    qint64 _nSize = nSize;
-    qint64 _nOffset = nOffset;
-    qint64 _nRawOffset = 0;
+    result.pMemoryMap = pMemoryMap;
+    result.ssOptions = ssOptions;
+    result.nOffset = osRegion.nOffset;
+    result.nSize = osRegion.nSize;
+    result.nLimit = (ssOptions.nLimit > 0) ? (ssOptions.nLimit) : (-1);
+    result.nCurrentOffset = osRegion.nOffset;
+    result.nBufferOffset = osRegion.nOffset;
+    result.baAnsi.resize(ssOptions.nMaxLenght + 1);
+    result.listUnicode[0].resize(ssOptions.nMaxLenght + 1);
+    result.listUnicode[1].resize(ssOptions.nMaxLenght + 1);
+    result.bIsStart = true;
 
-    bool bReadError = false;
+    return result;
+}
 
-    qint32 nBufferSize = getBufferSize(pPdStruct);
-    char *pBuffer = new char[nBufferSize];
+bool XBinary::multiSearch_allStringsNext(STRINGSCAN_STATE *pState, QVector<MS_RECORD> *pListRecords, qint32 nBatchSize, PDSTRUCT *pPdStruct)
+{
+    PDSTRUCT pdStructEmpty = XBinary::createPdStruct();
 
-    char *pAnsiBuffer = new char[ssOptions.nMaxLenght + 1];
+    if (!pPdStruct) {
+        pPdStruct = &pdStructEmpty;
+    }
 
-    quint16 *pUnicodeBuffer[2] = {new quint16[ssOptions.nMaxLenght + 1], new quint16[ssOptions.nMaxLenght + 1]};
-    qint64 nCurrentUnicodeSize[2] = {0, 0};
-    qint64 nCurrentUnicodeOffset[2] = {0, 0};
+    if (nBatchSize <= 0) {
+        nBatchSize = _XBINARY_STRINGS_BATCH_SIZE;
+    }
 
-    qint64 nCurrentAnsiSize = 0;
-    qint64 nCurrentAnsiOffset = 0;
+    if (pState->baBuffer.isEmpty()) {
+        pState->baBuffer.resize(getBufferSize(pPdStruct));
+    }
 
-    bool bIsStart = true;
-    char cPrevSymbol = 0;
+    STRINGSEARCH_OPTIONS *pSsOptions = &(pState->ssOptions);
+    _MEMORY_MAP *pMemoryMap = pState->pMemoryMap;
 
-    qint32 _nFreeIndex = XBinary::getFreeIndex(pPdStruct);
+    char *pBuffer = pState->baBuffer.data();
+    char *pAnsiBuffer = pState->baAnsi.data();
+    quint16 *pUnicodeBuffer[2] = {pState->listUnicode[0].data(), pState->listUnicode[1].data()};
 
-    XBinary::setPdStructInit(pPdStruct, _nFreeIndex, nSize);
+    // The scan works on locals; the state is written back before returning
+    qint64 nEnd = pState->nOffset + pState->nSize;
+    qint64 nCurrentOffset = pState->nCurrentOffset;
+    qint64 nCurrentAnsiSize = pState->nCurrentAnsiSize;
+    qint64 nCurrentAnsiOffset = pState->nCurrentAnsiOffset;
+    qint64 nCurrentUnicodeSize[2] = {pState->nCurrentUnicodeSize[0], pState->nCurrentUnicodeSize[1]};
+    qint64 nCurrentUnicodeOffset[2] = {pState->nCurrentUnicodeOffset[0], pState->nCurrentUnicodeOffset[1]};
+    char cPrevSymbol = pState->cPrevSymbol;
+    bool bIsStart = pState->bIsStart;
 
     qint32 nCurrentRecords = 0;
 
-    while ((_nSize > 0) && (!(pPdStruct->bIsStop))) {
-        qint64 nCurrentSize = _nSize;
+    if ((!(pState->bIsFinished)) && (nCurrentOffset >= nEnd)) {
+        pState->bIsFinished = true;
+    }
 
-        nCurrentSize = qMin((qint64)nBufferSize, nCurrentSize);
+    if ((!(pState->bIsFinished)) && (!(pPdStruct->bIsStop))) {
+        qint64 nBufferEnd = pState->nBufferOffset + pState->nBufferDataSize;
 
-        if (read_array_process(_nOffset, pBuffer, nCurrentSize, pPdStruct) != nCurrentSize) {
-            bReadError = true;
-            break;
+        // One buffer per call at most, so callers get regular progress
+        if (nCurrentOffset >= nBufferEnd) {
+            qint64 nCurrentSize = qMin((qint64)pState->baBuffer.size(), nEnd - nCurrentOffset);
+
+            if (read_array_process(nCurrentOffset, pBuffer, nCurrentSize, pPdStruct) == nCurrentSize) {
+                pState->nBufferOffset = nCurrentOffset;
+                pState->nBufferDataSize = nCurrentSize;
+                nBufferEnd = nCurrentOffset + nCurrentSize;
+            } else {
+                pState->bIsReadError = true;
+                pState->bIsFinished = true;
+            }
         }
 
-        for (qint64 i = 0; i < nCurrentSize; i++) {
-            bool bIsEnd = ((i == (nCurrentSize - 1)) && (_nSize == nCurrentSize));
-            qint32 nParity = (_nOffset + i) % 2;
+        for (; (!(pState->bIsFinished)) && (nCurrentOffset < nBufferEnd) && (nCurrentRecords < nBatchSize); nCurrentOffset++) {
+            bool bIsEnd = (nCurrentOffset == (nEnd - 1));
+            qint32 nParity = nCurrentOffset % 2;
 
-            char cSymbol = *(pBuffer + i);
+            char cSymbol = *(pBuffer + (nCurrentOffset - pState->nBufferOffset));
 
             bool bIsAnsiSymbol = false;
             bool bLongString = false;
 
-            if (ssOptions.bAnsi) {
+            if (pSsOptions->bAnsi) {
                 bIsAnsiSymbol = isAnsiSymbol((quint8)cSymbol);
             }
 
             if (bIsAnsiSymbol) {
                 if (nCurrentAnsiSize == 0) {
-                    nCurrentAnsiOffset = _nOffset + i;
+                    nCurrentAnsiOffset = nCurrentOffset;
                 }
 
-                if (nCurrentAnsiSize < ssOptions.nMaxLenght) {
+                if (nCurrentAnsiSize < pSsOptions->nMaxLenght) {
                     *(pAnsiBuffer + nCurrentAnsiSize) = cSymbol;
                 } else {
                     bIsAnsiSymbol = false;
@@ -4536,21 +5331,21 @@ QVector<XBinary::MS_RECORD> XBinary::multiSearch_allStrings(_MEMORY_MAP *pMemory
             }
 
             if ((!bIsAnsiSymbol) || (bIsEnd)) {
-                if (nCurrentAnsiSize >= ssOptions.nMinLenght) {
-                    if (nCurrentAnsiSize - 1 < ssOptions.nMaxLenght) {
+                if (nCurrentAnsiSize >= pSsOptions->nMinLenght) {
+                    if (nCurrentAnsiSize - 1 < pSsOptions->nMaxLenght) {
                         pAnsiBuffer[nCurrentAnsiSize] = 0;
                     } else {
-                        pAnsiBuffer[ssOptions.nMaxLenght] = 0;
+                        pAnsiBuffer[pSsOptions->nMaxLenght] = 0;
                     }
 
-                    if (ssOptions.bAnsi) {
+                    if (pSsOptions->bAnsi) {
                         QString sString;
 
                         sString = pAnsiBuffer;
 
                         bool bAdd = true;
 
-                        if (ssOptions.bNullTerminated && cSymbol && (!bLongString)) {
+                        if (pSsOptions->bNullTerminated && cSymbol && (!bLongString)) {
                             bAdd = false;
                         }
 
@@ -4566,11 +5361,14 @@ QVector<XBinary::MS_RECORD> XBinary::multiSearch_allStrings(_MEMORY_MAP *pMemory
                                 record.nRelOffset = nCurrentAnsiOffset;
                             }
 
-                            if (_addMultiSearchStringRecord(&listResult, &record, sString, &ssOptions)) {
+                            if (_addMultiSearchStringRecord(pListRecords, &record, sString, pSsOptions)) {
                                 nCurrentRecords++;
+                                pState->nNumberOfRecords++;
                             }
 
-                            if (nCurrentRecords >= ssOptions.nLimit) {
+                            if ((pState->nLimit != -1) && (pState->nNumberOfRecords >= pState->nLimit)) {
+                                pState->bIsLimit = true;
+                                pState->bIsFinished = true;
                                 break;
                             }
                         }
@@ -4585,21 +5383,21 @@ QVector<XBinary::MS_RECORD> XBinary::multiSearch_allStrings(_MEMORY_MAP *pMemory
 
                 bool bIsUnicodeSymbol = false;
 
-                if (ssOptions.bUnicode) {
+                if (pSsOptions->bUnicode) {
                     bIsUnicodeSymbol = isUnicodeSymbol(nCode, true);
                 }
 
-                if (nCurrentUnicodeSize[nParity] >= ssOptions.nMaxLenght) {
+                if (nCurrentUnicodeSize[nParity] >= pSsOptions->nMaxLenght) {
                     bIsUnicodeSymbol = false;
                     bLongString = true;
                 }
 
                 if (bIsUnicodeSymbol) {
                     if (nCurrentUnicodeSize[nParity] == 0) {
-                        nCurrentUnicodeOffset[nParity] = _nOffset - 1 + i;
+                        nCurrentUnicodeOffset[nParity] = nCurrentOffset - 1;
                     }
 
-                    if (nCurrentUnicodeSize[nParity] < ssOptions.nMaxLenght) {
+                    if (nCurrentUnicodeSize[nParity] < pSsOptions->nMaxLenght) {
                         *(pUnicodeBuffer[nParity] + nCurrentUnicodeSize[nParity]) = nCode;
                     }
 
@@ -4607,19 +5405,19 @@ QVector<XBinary::MS_RECORD> XBinary::multiSearch_allStrings(_MEMORY_MAP *pMemory
                 }
 
                 if ((!bIsUnicodeSymbol) || (bIsEnd)) {
-                    if (nCurrentUnicodeSize[nParity] >= ssOptions.nMinLenght) {
-                        if (nCurrentUnicodeSize[nParity] - 1 < ssOptions.nMaxLenght) {
+                    if (nCurrentUnicodeSize[nParity] >= pSsOptions->nMinLenght) {
+                        if (nCurrentUnicodeSize[nParity] - 1 < pSsOptions->nMaxLenght) {
                             pUnicodeBuffer[nParity][nCurrentUnicodeSize[nParity]] = 0;
                         } else {
-                            pUnicodeBuffer[nParity][ssOptions.nMaxLenght] = 0;
+                            pUnicodeBuffer[nParity][pSsOptions->nMaxLenght] = 0;
                         }
 
-                        if (ssOptions.bUnicode) {
+                        if (pSsOptions->bUnicode) {
                             QString sString = QString::fromUtf16(pUnicodeBuffer[nParity]);  // TODO Check Qt6
 
                             bool bAdd = true;
 
-                            if (ssOptions.bNullTerminated && nCode && (!bLongString)) {
+                            if (pSsOptions->bNullTerminated && nCode && (!bLongString)) {
                                 bAdd = false;
                             }
 
@@ -4635,11 +5433,14 @@ QVector<XBinary::MS_RECORD> XBinary::multiSearch_allStrings(_MEMORY_MAP *pMemory
                                     record.nRelOffset = nCurrentUnicodeOffset[nParity];
                                 }
 
-                                if (_addMultiSearchStringRecord(&listResult, &record, sString, &ssOptions)) {
+                                if (_addMultiSearchStringRecord(pListRecords, &record, sString, pSsOptions)) {
                                     nCurrentRecords++;
+                                    pState->nNumberOfRecords++;
                                 }
 
-                                if (nCurrentRecords >= ssOptions.nLimit) {
+                                if ((pState->nLimit != -1) && (pState->nNumberOfRecords >= pState->nLimit)) {
+                                    pState->bIsLimit = true;
+                                    pState->bIsFinished = true;
                                     break;
                                 }
                             }
@@ -4649,38 +5450,36 @@ QVector<XBinary::MS_RECORD> XBinary::multiSearch_allStrings(_MEMORY_MAP *pMemory
                     if (bIsEnd) {
                         qint32 nO = (nParity == 1) ? (0) : (1);
 
-                        if (nCurrentUnicodeSize[nO] >= ssOptions.nMinLenght) {
-                            if (nCurrentUnicodeSize[nO] - 1 < ssOptions.nMaxLenght) {
+                        if (nCurrentUnicodeSize[nO] >= pSsOptions->nMinLenght) {
+                            if (nCurrentUnicodeSize[nO] - 1 < pSsOptions->nMaxLenght) {
                                 pUnicodeBuffer[nO][nCurrentUnicodeSize[nO]] = 0;
                             } else {
-                                pUnicodeBuffer[nO][ssOptions.nMaxLenght] = 0;
+                                pUnicodeBuffer[nO][pSsOptions->nMaxLenght] = 0;
                             }
 
-                            if (ssOptions.bUnicode) {
+                            if (pSsOptions->bUnicode) {
                                 QString sString = QString::fromUtf16(pUnicodeBuffer[nO]);  // TODO Check Qt6
 
-                                bool bAdd = true;
-
-                                if (bAdd) {
-                                    MS_RECORD record = {};
-                                    record.nValueType = VT_U;
-                                    record.nSize = nCurrentUnicodeSize[nO] * 2;
-                                    record.nRegionIndex = getMemoryIndexByOffset(pMemoryMap, nCurrentUnicodeOffset[nO]);
-                                    // record.sString = sString;
+                                MS_RECORD record = {};
+                                record.nValueType = VT_U;
+                                record.nSize = nCurrentUnicodeSize[nO] * 2;
+                                record.nRegionIndex = getMemoryIndexByOffset(pMemoryMap, nCurrentUnicodeOffset[nO]);
 
-                                    if (record.nRegionIndex != -1) {
-                                        record.nRelOffset = nCurrentUnicodeOffset[nO] - pMemoryMap->listRecords.at(record.nRegionIndex).nOffset;
-                                    } else {
-                                        record.nRelOffset = nCurrentUnicodeOffset[nO];
-                                    }
+                                if (record.nRegionIndex != -1) {
+                                    record.nRelOffset = nCurrentUnicodeOffset[nO] - pMemoryMap->listRecords.at(record.nRegionIndex).nOffset;
+                                } else {
+                                    record.nRelOffset = nCurrentUnicodeOffset[nO];
+                                }
 
-                                    if (_addMultiSearchStringRecord(&listResult, &record, sString, &ssOptions)) {
-                                        nCurrentRecords++;
-                                    }
+                                if (_addMultiSearchStringRecord(pListRecords, &record, sString, pSsOptions)) {
+                                    nCurrentRecords++;
+                                    pState->nNumberOfRecords++;
+                                }
 
-                                    if (nCurrentRecords >= ssOptions.nLimit) {
-                                        break;
-                                    }
+                                if ((pState->nLimit != -1) && (pState->nNumberOfRecords >= pState->nLimit)) {
+                                    pState->bIsLimit = true;
+                                    pState->bIsFinished = true;
+                                    break;
                                 }
                             }
                         }
@@ -4697,31 +5496,77 @@ QVector<XBinary::MS_RECORD> XBinary::multiSearch_allStrings(_MEMORY_MAP *pMemory
             }
         }
 
-        _nSize -= nCurrentSize;
-        _nOffset += nCurrentSize;
-        _nRawOffset += nCurrentSize;
+        if ((!(pState->bIsFinished)) && (nCurrentOffset >= nEnd)) {
+            pState->bIsFinished = true;
+        }
+    }
 
-        XBinary::setPdStructCurrent(pPdStruct, _nFreeIndex, _nOffset - nOffset);
+    pState->nCurrentOffset = nCurrentOffset;
+    pState->nCurrentAnsiSize = nCurrentAnsiSize;
+    pState->nCurrentAnsiOffset = nCurrentAnsiOffset;
+    pState->nCurrentUnicodeSize[0] = nCurrentUnicodeSize[0];
+    pState->nCurrentUnicodeSize[1] = nCurrentUnicodeSize[1];
+    pState->nCurrentUnicodeOffset[0] = nCurrentUnicodeOffset[0];
+    pState->nCurrentUnicodeOffset[1] = nCurrentUnicodeOffset[1];
+    pState->cPrevSymbol = cPrevSymbol;
+    pState->bIsStart = bIsStart;
 
-        if (nCurrentRecords >= ssOptions.nLimit) {
-            pPdStruct->sInfoString = QString("%1: %2").arg(tr("Maximum"), QString::number(nCurrentRecords));
+    return (!(pState->bIsFinished)) && (!(pPdStruct->bIsStop));
+}
 
-            break;
+qint64 XBinary::multiSearch_allStringsToSink(_MEMORY_MAP *pMemoryMap, qint64 nOffset, qint64 nSize, STRINGSEARCH_OPTIONS ssOptions, MS_RECORD_SINK pSink,
+                                             void *pUserData, qint32 nBatchSize, PDSTRUCT *pPdStruct)
+{
+    qint64 nResult = 0;
+
+    PDSTRUCT pdStructEmpty = XBinary::createPdStruct();
+
+    if (!pPdStruct) {
+        pPdStruct = &pdStructEmpty;
+    }
+
+    if (nBatchSize <= 0) {
+        nBatchSize = _XBINARY_STRINGS_BATCH_SIZE;
+    }
+
+    STRINGSCAN_STATE state = multiSearch_allStringsBegin(pMemoryMap, nOffset, nSize, ssOptions);
+
+    qint32 _nFreeIndex = XBinary::getFreeIndex(pPdStruct);
+
+    XBinary::setPdStructInit(pPdStruct, _nFreeIndex, state.nSize);
+
+    QVector<MS_RECORD> listRecords;
+    listRecords.reserve(nBatchSize + 2);  // A byte can end up to three strings
+
+    bool bContinue = true;
+
+    while (bContinue) {
+        bContinue = multiSearch_allStringsNext(&state, &listRecords, nBatchSize - listRecords.size(), pPdStruct);
+
+        if ((listRecords.size() >= nBatchSize) || ((!bContinue) && (!listRecords.isEmpty()))) {
+            nResult += listRecords.size();
+
+            if (!pSink(pUserData, listRecords)) {
+                bContinue = false;
+            }
+
+            listRecords.clear();  // Keeps the capacity
         }
+
+        XBinary::setPdStructCurrent(pPdStruct, _nFreeIndex, state.nCurrentOffset - state.nOffset);
     }
 
-    if (bReadError) {
-        pPdStruct->sInfoString = tr("Read error");
+    if (state.bIsLimit) {
+        pPdStruct->sInfoString = QString("%1: %2").arg(tr("Maximum"), QString::number(state.nNumberOfRecords));
     }
 
-    delete[] pBuffer;
-    delete[] pAnsiBuffer;
-    delete[] pUnicodeBuffer[0];
-    delete[] pUnicodeBuffer[1];
+    if (state.bIsReadError) {
+        pPdStruct->sInfoString = tr("Read error");
+    }
 
     XBinary::setPdStructFinished(pPdStruct, _nFreeIndex);
 
-    return listResult;
+    return nResult;
 }
 
 QVector<XBinary::MS_RECORD> XBinary::multiSearch_allStrings2(_MEMORY_MAP *pMemoryMap, qint64 nOffset, qint64 nSize, STRINGSEARCH_OPTIONS ssOptions, PDSTRUCT *pPdStruct)
@@ -4781,6 +5626,344 @@ QVector<XBinary::MS_RECORD> XBinary::multiSearch_allStrings2(_MEMORY_MAP *pMemor
     return listResult;
 }
 
+// Read size of multiSearch_ansiStrings/multiSearch_unicodeStrings; parallel ANSI parts start on these boundaries
+static const qint32 _XBINARY_STRINGS_BUFFER_SIZE = 0x10000;
+
+// pData points to byte X - 3. True if no string of the scanner can run across byte X - 1, whatever came before.
+static bool _x_isStringSplitPoint(XBinary::STRINGSCAN stringScan, const char *pData, const XBinary::STRINGSEARCH_OPTIONS &ssOptions)
+{
+    bool bResult = true;
+
+    bool bAnsi = (stringScan == XBinary::STRINGSCAN_ALL) ? (ssOptions.bAnsi) : (stringScan == XBinary::STRINGSCAN_ANSI);
+    bool bUnicode = (stringScan == XBinary::STRINGSCAN_ALL) ? (ssOptions.bUnicode) : (stringScan == XBinary::STRINGSCAN_UNICODE);
+
+    if (bAnsi) {
+        bResult = !XBinary::isAnsiSymbol((quint8)pData[2]);
+    }
+
+    if (bResult && bUnicode) {
+        quint16 nCode1 = 0;
+        quint16 nCode2 = 0;
+
+        if (stringScan == XBinary::STRINGSCAN_ALL) {
+            // Same arithmetic as multiSearch_allStrings
+            nCode1 = pData[0] + (pData[1] << 8);
+            nCode2 = pData[1] + (pData[2] << 8);
+        } else {
+            nCode1 = (quint8)pData[0] + ((quint8)pData[1] << 8);
+            nCode2 = (quint8)pData[1] + ((quint8)pData[2] << 8);
+        }
+
+        bResult = (!XBinary::isUnicodeSymbol(nCode1, true)) && (!XBinary::isUnicodeSymbol(nCode2, true));
+    }
+
+    return bResult;
+}
+
+struct _XBINARY_STRINGS_STATE {
+    XBinary::STRINGSCAN stringScan;
+    XBinary::STRINGSEARCH_OPTIONS ssOptions;
+    qint32 nNumberOfParts;
+    const qint64 *pPartOffsets;
+    const qint64 *pPartSizes;
+    XBinary::_MEMORY_MAP *pMemoryMap;  // Shared by the parts; memory map lookups only read it
+    XBinary::PDSTRUCT *pPdStructs;
+    QVector<XBinary::MS_RECORD> *pResults;
+    QAtomicInt nNextPart;
+    QAtomicInteger<qint64> nProcessed;
+};
+
+class _XBinaryStringsWorker : public QRunnable {
+public:
+    _XBinaryStringsWorker(XBinary *pBinary, _XBINARY_STRINGS_STATE *pState)
+    {
+        m_pBinary = pBinary;
+        m_pState = pState;
+    }
+
+    virtual void run()
+    {
+        while (true) {
+            qint32 nPart = m_pState->nNextPart.fetchAndAddOrdered(1);
+
+            if (nPart >= m_pState->nNumberOfParts) {
+                break;
+            }
+
+            XBinary::_MEMORY_MAP *pMemoryMap = m_pState->pMemoryMap;
+            XBinary::PDSTRUCT *pPdStruct = &(m_pState->pPdStructs[nPart]);
+            qint64 nOffset = m_pState->pPartOffsets[nPart];
+            qint64 nSize = m_pState->pPartSizes[nPart];
+
+            if (!(pPdStruct->bIsStop)) {
+                if (m_pState->stringScan == XBinary::STRINGSCAN_ANSI) {
+                    m_pState->pResults[nPart] = m_pBinary->multiSearch_ansiStrings(pMemoryMap, nOffset, nSize, m_pState->ssOptions, pPdStruct);
+                } else if (m_pState->stringScan == XBinary::STRINGSCAN_UNICODE) {
+                    m_pState->pResults[nPart] = m_pBinary->multiSearch_unicodeStrings(pMemoryMap, nOffset, nSize, m_pState->ssOptions, pPdStruct);
+                } else {
+                    m_pState->pResults[nPart] = m_pBinary->multiSearch_allStrings(pMemoryMap, nOffset, nSize, m_pState->ssOptions, pPdStruct);
+                }
+            }
+
+            m_pState->nProcessed.fetchAndAddOrdered(nSize);
+        }
+    }
+
+private:
+    XBinary *m_pBinary;
+    _XBINARY_STRINGS_STATE *m_pState;
+};
+
+QVector<XBinary::MS_RECORD> XBinary::multiSearch_allStringsParallel(_MEMORY_MAP *pMemoryMap, qint64 nOffset, qint64 nSize, STRINGSEARCH_OPTIONS ssOptions,
+                                                                     qint32 nNumberOfThreads, PDSTRUCT *pPdStruct)
+{
+    return _multiSearch_stringsParallel(STRINGSCAN_ALL, pMemoryMap, nOffset, nSize, ssOptions, nNumberOfThreads, pPdStruct);
+}
+
+QVector<XBinary::MS_RECORD> XBinary::multiSearch_allStrings2Parallel(_MEMORY_MAP *pMemoryMap, qint64 nOffset, qint64 nSize, STRINGSEARCH_OPTIONS ssOptions,
+                                                                      qint32 nNumberOfThreads, PDSTRUCT *pPdStruct)
+{
+    // Same steps as multiSearch_allStrings2
+    QVector<XBinary::MS_RECORD> listResult;
+
+    PDSTRUCT pdStructEmpty = XBinary::createPdStruct();
+
+    if (!pPdStruct) {
+        pPdStruct = &pdStructEmpty;
+    }
+
+    qint32 nTotalLimit = ssOptions.nLimit;
+
+    if (ssOptions.bAnsi) {
+        STRINGSEARCH_OPTIONS ansiOptions = ssOptions;
+        ansiOptions.bUnicode = false;
+        ansiOptions.bAnsi = true;
+
+        QVector<XBinary::MS_RECORD> listAnsi = _multiSearch_stringsParallel(STRINGSCAN_ANSI, pMemoryMap, nOffset, nSize, ansiOptions, nNumberOfThreads, pPdStruct);
+        listResult.append(listAnsi);
+
+        if (nTotalLimit > 0) {
+            nTotalLimit -= listAnsi.size();
+            if (nTotalLimit <= 0) {
+                nTotalLimit = 0;
+            }
+        }
+    }
+
+    if (ssOptions.bUnicode && (nTotalLimit != 0)) {
+        STRINGSEARCH_OPTIONS unicodeOptions = ssOptions;
+        unicodeOptions.bAnsi = false;
+        unicodeOptions.bUnicode = true;
+        unicodeOptions.nLimit = nTotalLimit;
+
+        QVector<XBinary::MS_RECORD> listUnicode =
+            _multiSearch_stringsParallel(STRINGSCAN_UNICODE, pMemoryMap, nOffset, nSize, unicodeOptions, nNumberOfThreads, pPdStruct);
+        listResult.append(listUnicode);
+    }
+
+    if (listResult.size() > 1) {
+        std::sort(listResult.begin(), listResult.end(), compareMS_RECORD);
+    }
+
+    if (ssOptions.nLimit > 0 && listResult.size() > ssOptions.nLimit) {
+        listResult.resize(ssOptions.nLimit);
+        pPdStruct->sInfoString = QString("%1: %2").arg(tr("Maximum"), QString::number(ssOptions.nLimit));
+    }
+
+    return listResult;
+}
+
+QList<qint64> XBinary::_getStringSplitPoints(STRINGSCAN stringScan, qint64 nOffset, qint64 nSize, const STRINGSEARCH_OPTIONS &ssOptions, PDSTRUCT *pPdStruct)
+{
+    QList<qint64> listResult;
+
+    qint64 nEnd = nOffset + nSize;
+
+    // One split point X per chunk, X + 1 <= nEnd
+    for (qint64 nTarget = nOffset + _XBINARY_PARALLEL_SEARCH_CHUNK; (nTarget < nEnd - 1) && isPdStructNotCanceled(pPdStruct);
+         nTarget += _XBINARY_PARALLEL_SEARCH_CHUNK) {
+        qint64 nUpper = qMin(nTarget + _XBINARY_PARALLEL_SEARCH_CHUNK, nEnd - 1);
+        qint64 nSplit = -1;
+
+        if (stringScan == STRINGSCAN_ANSI) {
+            // multiSearch_ansiStrings behaves differently at its own buffer ends, so parts start where the serial scan starts a buffer
+            for (qint64 nStart = nTarget; (nStart + 2 < nUpper) && (nSplit == -1); nStart += _XBINARY_STRINGS_BUFFER_SIZE) {
+                char pData[3] = {};
+
+                if (read_array(nStart - 2, pData, 3) == 3) {
+                    if (_x_isStringSplitPoint(stringScan, pData, ssOptions)) {
+                        nSplit = nStart + 1;
+                    }
+                }
+            }
+        } else {
+            for (qint64 nWindow = nTarget - 3; (nWindow + 3 < nUpper) && (nSplit == -1); nWindow += 0x1000) {
+                QByteArray baData = read_array(nWindow, qMin((qint64)0x1000 + 3, nUpper - nWindow));
+                qint32 nDataSize = baData.size();
+
+                for (qint32 j = 3; (j < nDataSize) && (nSplit == -1); j++) {
+                    if (_x_isStringSplitPoint(stringScan, baData.constData() + j - 3, ssOptions)) {
+                        nSplit = nWindow + j;
+                    }
+                }
+            }
+        }
+
+        if (nSplit != -1) {
+            listResult.append(nSplit);
+        }
+    }
+
+    return listResult;
+}
+
+QVector<XBinary::MS_RECORD> XBinary::_multiSearch_stringsParallel(STRINGSCAN stringScan, _MEMORY_MAP *pMemoryMap, qint64 nOffset, qint64 nSize,
+                                                                  STRINGSEARCH_OPTIONS ssOptions, qint32 nNumberOfThreads, PDSTRUCT *pPdStruct)
+{
+    QVector<MS_RECORD> listResult;
+
+    PDSTRUCT pdStructEmpty = XBinary::createPdStruct();
+
+    if (!pPdStruct) {
+        pPdStruct = &pdStructEmpty;
+    }
+
+    OFFSETSIZE osRegion = convertOffsetAndSize(nOffset, nSize);
+
+    nOffset = osRegion.nOffset;
+    nSize = osRegion.nSize;
+
+    if (nNumberOfThreads <= 0) {
+        nNumberOfThreads = qMax(1, QThread::idealThreadCount());
+    }
+
+    QList<qint64> listSplits;
+
+    if ((nNumberOfThreads > 1) && (ssOptions.nLimit > 0) && (nSize >= _XBINARY_PARALLEL_SEARCH_MIN) && _isConcurrentReadSafe()) {
+        listSplits = _getStringSplitPoints(stringScan, nOffset, nSize, ssOptions, pPdStruct);
+    }
+
+    if (listSplits.isEmpty()) {
+        if (stringScan == STRINGSCAN_ANSI) {
+            listResult = multiSearch_ansiStrings(pMemoryMap, nOffset, nSize, ssOptions, pPdStruct);
+        } else if (stringScan == STRINGSCAN_UNICODE) {
+            listResult = multiSearch_unicodeStrings(pMemoryMap, nOffset, nSize, ssOptions, pPdStruct);
+        } else {
+            listResult = multiSearch_allStrings(pMemoryMap, nOffset, nSize, ssOptions, pPdStruct);
+        }
+
+        return listResult;
+    }
+
+    // Part i scans [X(i) - 1, X(i + 1) + 1). The serial scanner is idle at X(i) - 1 whatever came before, so the part
+    // reproduces the serial records; the extra byte keeps X(i + 1) - 1 from being treated as the end of the data.
+    // Records that start at or after X(i + 1) - 1 belong to the next part.
+    qint32 nNumberOfParts = listSplits.count() + 1;
+
+    QVector<qint64> listPartOffsets(nNumberOfParts);
+    QVector<qint64> listPartSizes(nNumberOfParts);
+    QVector<qint64> listOwnedEnds(nNumberOfParts);
+
+    for (qint32 i = 0; i < nNumberOfParts; i++) {
+        qint64 nPartStart = (i == 0) ? (nOffset) : (listSplits.at(i - 1) - 1);
+        qint64 nPartEnd = (i == nNumberOfParts - 1) ? (nOffset + nSize) : (listSplits.at(i) + 1);
+
+        listPartOffsets[i] = nPartStart;
+        listPartSizes[i] = nPartEnd - nPartStart;
+        listOwnedEnds[i] = (i == nNumberOfParts - 1) ? (nOffset + nSize) : (listSplits.at(i) - 1);
+    }
+
+    // Index the map before the threads share it
+    _prepareMemoryIndex(pMemoryMap);
+
+    QVector<PDSTRUCT> listPdStructs(nNumberOfParts, XBinary::createPdStruct());
+    QVector<QVector<MS_RECORD>> listResults(nNumberOfParts);
+
+    for (qint32 i = 0; i < nNumberOfParts; i++) {
+        listPdStructs[i].nBufferSize = pPdStruct->nBufferSize;
+        listPdStructs[i].nFileBufferSize = pPdStruct->nFileBufferSize;
+    }
+
+    _XBINARY_STRINGS_STATE state;
+    state.stringScan = stringScan;
+    state.ssOptions = ssOptions;
+    state.nNumberOfParts = nNumberOfParts;
+    state.pPartOffsets = listPartOffsets.constData();
+    state.pPartSizes = listPartSizes.constData();
+    state.pMemoryMap = pMemoryMap;
+    state.pPdStructs = listPdStructs.data();
+    state.pResults = listResults.data();
+    state.nNextPart.storeRelease(0);
+    state.nProcessed.storeRelease(0);
+
+    qint32 _nFreeIndex = XBinary::getFreeIndex(pPdStruct);
+    XBinary::setPdStructInit(pPdStruct, _nFreeIndex, nSize);
+
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(qMin(nNumberOfThreads, nNumberOfParts));
+
+    for (qint32 i = 0; i < threadPool.maxThreadCount(); i++) {
+        threadPool.start(new _XBinaryStringsWorker(this, &state));
+    }
+
+    bool bIsStopForwarded = false;
+
+    while (!threadPool.waitForDone(_XBINARY_PARALLEL_SEARCH_POLL_MS)) {
+        if ((!bIsStopForwarded) && (pPdStruct->bIsStop)) {
+            for (qint32 i = 0; i < nNumberOfParts; i++) {
+                state.pPdStructs[i].bIsStop = true;
+            }
+
+            bIsStopForwarded = true;
+        }
+
+        XBinary::setPdStructCurrent(pPdStruct, _nFreeIndex, state.nProcessed.loadAcquire());
+    }
+
+    // Parts in order give the serial order; a stopped part ends the list like a stopped serial scan
+    bool bReadError = false;
+
+    for (qint32 i = 0; (i < nNumberOfParts) && (listResult.size() < ssOptions.nLimit); i++) {
+        const QVector<MS_RECORD> &listPart = listResults.at(i);
+        qint32 nNumberOfRecords = listPart.size();
+
+        for (qint32 j = 0; (j < nNumberOfRecords) && (listResult.size() < ssOptions.nLimit); j++) {
+            const MS_RECORD &record = listPart.at(j);
+
+            qint64 nRecordOffset = record.nRelOffset;
+
+            if (record.nRegionIndex != -1) {
+                nRecordOffset += pMemoryMap->listRecords.at(record.nRegionIndex).nOffset;
+            }
+
+            if (nRecordOffset < listOwnedEnds.at(i)) {
+                listResult.append(record);
+            }
+        }
+
+        if (listPdStructs.at(i).sInfoString == tr("Read error")) {
+            bReadError = true;
+            break;
+        }
+
+        if (listPdStructs.at(i).bIsStop) {
+            break;
+        }
+    }
+
+    if (listResult.size() >= ssOptions.nLimit) {
+        pPdStruct->sInfoString = QString("%1: %2").arg(tr("Maximum"), QString::number(listResult.size()));
+    }
+
+    if (bReadError) {
+        pPdStruct->sInfoString = tr("Read error");
+    }
+
+    XBinary::setPdStructFinished(pPdStruct, _nFreeIndex);
+
+    return listResult;
+}
+
 static qint32 _x_get_simd_threshold()
 {
     qint32 nSimdThreshold = 4;
@@ -4821,7 +6004,7 @@ QVector<XBinary::MS_RECORD> XBinary::multiSearch_ansiStrings(_MEMORY_MAP *pMemor
 
     bool bReadError = false;
 
-    const qint32 BUFFER_SIZE = 0x10000;  // 64KB chunks for efficient processing
+    const qint32 BUFFER_SIZE = _XBINARY_STRINGS_BUFFER_SIZE;  // 64KB chunks for efficient processing
 
     char *pBuffer = new char[BUFFER_SIZE];
     char *pAnsiBuffer = new char[ssOptions.nMaxLenght + 1];
@@ -5148,7 +6331,7 @@ QVector<XBinary::MS_RECORD> XBinary::multiSearch_unicodeStrings(_MEMORY_MAP *pMe
 
     bool bReadError = false;
 
-    const qint32 BUFFER_SIZE = 0x10000;  // 64KB chunks for efficient processing
+    const qint32 BUFFER_SIZE = _XBINARY_STRINGS_BUFFER_SIZE;  // 64KB chunks for efficient processing
 
     char *pBuffer = new char[BUFFER_SIZE];
     quint16 *pUnicodeBuffer[2];  // Two buffers for even/odd parity
@@ -5174,6 +6357,8 @@ QVector<XBinary::MS_RECORD> XBinary::multiSearch_unicodeStrings(_MEMORY_MAP *pMe
 
     bool bIsStart = true;  // Track if we're at the start of processing
 
+    qint32 nSimdThreshold = _x_get_simd_threshold();
+
     while ((_nSize > 0) && (!(pPdStruct->bIsStop))) {
         qint64 nCurrentSize = qMin((qint64)BUFFER_SIZE, _nSize);
 
@@ -5189,6 +6374,39 @@ QVector<XBinary::MS_RECORD> XBinary::multiSearch_unicodeStrings(_MEMORY_MAP *pMe
             bool bIsEnd = ((i == (nCurrentSize - 1)) && (_nSize == nCurrentSize));
             qint32 nParity = (_nOffset + i) % 2;  // Track even/odd byte position
 
+#ifdef USE_XSIMD
+            // The code unit completed at byte i starts at i - 1, so both fast paths need it in this buffer
+            if ((!bIsStart) && (i > 0) && (nCurrentSize - i > nSimdThreshold)) {
+                qint32 nOtherParity = (nParity == 1) ? 0 : 1;
+                qint64 nNext = i;
+
+                if ((nCurrentUnicodeSize[0] == 0) && (nCurrentUnicodeSize[1] == 0)) {
+                    // No string in progress: bytes before the next symbol change nothing
+                    qint64 nSymbol = xsimd_find_unicode_symbol(pBuffer + i - 1, nCurrentSize - i + 1, 20, 0);
+
+                    nNext = (nSymbol == -1) ? (nCurrentSize) : (i + nSymbol);
+                } else if ((nCurrentUnicodeSize[nParity] > 0) && (nCurrentUnicodeSize[nOtherParity] == 0) &&
+                           (nCurrentUnicodeSize[nParity] < ssOptions.nMaxLenght)) {
+                    // Plain run of the current string; it stops before the last byte of the buffer, so it never ends the data
+                    qint64 nRun = xsimd_count_unicode_run(pBuffer + i - 1, nCurrentSize - i, 20, 0);
+                    nRun = qMin(nRun, ssOptions.nMaxLenght - nCurrentUnicodeSize[nParity]);
+
+                    for (qint64 j = 0; j < nRun; j++) {
+                        pUnicodeBuffer[nParity][nCurrentUnicodeSize[nParity] + j] = (quint8)pBuffer[i - 1 + 2 * j] + ((quint8)pBuffer[i + 2 * j] << 8);
+                    }
+
+                    nCurrentUnicodeSize[nParity] += nRun;
+                    nNext = i + 2 * nRun;
+                }
+
+                if (nNext > i) {
+                    cPrevSymbol = pBuffer[nNext - 1];
+                    i = nNext - 1;
+                    continue;
+                }
+            }
+#endif
+
             if (!bIsStart) {
                 // Build 16-bit Unicode character (little-endian by default)
                 quint16 nCode = (quint8)cPrevSymbol + ((quint8)cSymbol << 8);
@@ -5340,7 +6558,7 @@ QVector<XBinary::MS_RECORD> XBinary::multiSearch_unicodeStrings(_MEMORY_MAP *pMe
 
 QVector<XBinary::MS_RECORD> XBinary::multiSearch_signature(qint64 nOffset, qint64 nSize, qint32 nLimit, const QString &sSignature, quint32 nInfo, PDSTRUCT *pPdStruct)
 {
-    _MEMORY_MAP memoryMap = getMemoryMap(MAPMODE_UNKNOWN, pPdStruct);
+    _MEMORY_MAP memoryMap = getCachedMemoryMap(MAPMODE_UNKNOWN, pPdStruct);
 
     return multiSearch_signature(&memoryMap, nOffset, nSize, nLimit, sSignature, nInfo, pPdStruct);
 }
@@ -5383,26 +6601,403 @@ QVector<XBinary::MS_RECORD> XBinary::multiSearch_signature(_MEMORY_MAP *pMemoryM
         record.nInfo = nInfo;
         record.nRegionIndex = getMemoryIndexByOffset(pMemoryMap, nSignatureOffset);
 
-        if (record.nRegionIndex != -1) {
-            record.nRelOffset = nSignatureOffset - pMemoryMap->listRecords.at(record.nRegionIndex).nOffset;
-        } else {
-            record.nRelOffset = nSignatureOffset;
-        }
+        if (record.nRegionIndex != -1) {
+            record.nRelOffset = nSignatureOffset - pMemoryMap->listRecords.at(record.nRegionIndex).nOffset;
+        } else {
+            record.nRelOffset = nSignatureOffset;
+        }
+
+        listResult.append(record);
+
+        nCurrentRecords++;
+
+        if (nCurrentRecords >= nLimit) {
+            pPdStruct->sInfoString = QString("%1: %2").arg(tr("Maximum"), QString::number(nCurrentRecords));
+
+            break;
+        }
+
+        _nOffset = nSignatureOffset + nSignatureSize;
+        _nSize = nSize - (_nOffset - nOffset);
+
+        XBinary::setPdStructCurrent(pPdStruct, _nFreeIndex, _nOffset - nOffset);
+    }
+
+    XBinary::setPdStructFinished(pPdStruct, _nFreeIndex);
+
+    return listResult;
+}
+
+// Longer anchors hardly reduce false hits further but make the automaton bigger
+static const qint32 _XMULTISIGNATURE_ANCHOR_MAX = 16;
+
+XBinary::MULTISIGNATURE XBinary::createMultiSignature(const QList<COMPILED_SIGNATURE> &listSignatures)
+{
+    MULTISIGNATURE result = {};
+
+    qint32 nNumberOfSignatures = listSignatures.count();
+
+    result.listSignatures.reserve(nNumberOfSignatures);
+    result.listAnchorDeltas.fill(-1, nNumberOfSignatures);
+    result.listAnchorSizes.fill(0, nNumberOfSignatures);
+
+    // Trie of the anchors
+    QVector<QMap<quint8, qint32>> listChildren;
+    QVector<QList<qint32>> listOwnOutputs;
+
+    listChildren.append(QMap<quint8, qint32>());
+    listOwnOutputs.append(QList<qint32>());
+
+    for (qint32 i = 0; i < nNumberOfSignatures; i++) {
+        const COMPILED_SIGNATURE &compiledSignature = listSignatures.at(i);
+
+        result.listSignatures.append(compiledSignature);
+
+        if ((!compiledSignature.bIsValid) || compiledSignature.listRecords.isEmpty()) {
+            continue;
+        }
+
+        // Only records at a fixed distance from the start can serve as the anchor
+        qint32 nAnchorIndex = -1;
+        qint64 nAnchorDelta = 0;
+        qint64 nCurrentDelta = 0;
+
+        qint32 nNumberOfRecords = compiledSignature.listRecords.count();
+
+        for (qint32 j = 0; j < nNumberOfRecords; j++) {
+            const SIGNATURE_RECORD &record = compiledSignature.listRecords.at(j);
+
+            if ((record.st == ST_FINDBYTES) || (record.st == ST_ADDRESS) || (record.st == ST_RELOFFSET)) {
+                break;
+            }
+
+            if ((record.st == ST_COMPAREBYTES) &&
+                ((nAnchorIndex == -1) || (record.baData.size() > compiledSignature.listRecords.at(nAnchorIndex).baData.size()))) {
+                nAnchorIndex = j;
+                nAnchorDelta = nCurrentDelta;
+            }
+
+            nCurrentDelta += record.nWindowSize;
+        }
+
+        if ((nAnchorIndex == -1) || compiledSignature.listRecords.at(nAnchorIndex).baData.isEmpty()) {
+            result.listUnanchored.append(i);
+            continue;
+        }
+
+        const QByteArray &baAnchor = compiledSignature.listRecords.at(nAnchorIndex).baData;
+        qint32 nAnchorSize = qMin(baAnchor.size(), _XMULTISIGNATURE_ANCHOR_MAX);
+
+        result.listAnchorDeltas[i] = nAnchorDelta;
+        result.listAnchorSizes[i] = nAnchorSize;
+
+        qint32 nState = 0;
+
+        for (qint32 j = 0; j < nAnchorSize; j++) {
+            quint8 nByte = (quint8)baAnchor.at(j);
+
+            qint32 nNext = listChildren.at(nState).value(nByte, -1);
+
+            if (nNext == -1) {
+                nNext = listChildren.count();
+                listChildren[nState].insert(nByte, nNext);
+                listChildren.append(QMap<quint8, qint32>());
+                listOwnOutputs.append(QList<qint32>());
+            }
+
+            nState = nNext;
+        }
+
+        listOwnOutputs[nState].append(i);
+    }
+
+    qint32 nNumberOfStates = listChildren.count();
+
+    // Flatten the trie
+    result.listRootNext.fill(0, 256);
+    result.listEdgeFirst.resize(nNumberOfStates);
+    result.listEdgeCount.resize(nNumberOfStates);
+    result.listFail.fill(0, nNumberOfStates);
+    result.listOutputFirst.resize(nNumberOfStates);
+    result.listOutputCount.resize(nNumberOfStates);
+    result.listOutputLink.fill(-1, nNumberOfStates);
+
+    for (qint32 i = 0; i < nNumberOfStates; i++) {
+        result.listEdgeFirst[i] = result.listEdgeBytes.count();
+        result.listEdgeCount[i] = listChildren.at(i).count();
+
+        QMapIterator<quint8, qint32> iter(listChildren.at(i));
+
+        while (iter.hasNext()) {
+            iter.next();
+
+            result.listEdgeBytes.append(iter.key());
+            result.listEdgeTargets.append(iter.value());
+
+            if (i == 0) {
+                result.listRootNext[iter.key()] = iter.value();
+            }
+        }
+
+        result.listOutputFirst[i] = result.listOutputSignatures.count();
+        result.listOutputCount[i] = listOwnOutputs.at(i).count();
+        qint32 nNumberOfOutputs = listOwnOutputs.at(i).count();
+
+        for (qint32 j = 0; j < nNumberOfOutputs; j++) {
+            result.listOutputSignatures.append(listOwnOutputs.at(i).at(j));
+        }
+    }
+
+    // Failure links, breadth first
+    QList<qint32> listQueue;
+
+    QMapIterator<quint8, qint32> iterRoot(listChildren.at(0));
+
+    while (iterRoot.hasNext()) {
+        iterRoot.next();
+        listQueue.append(iterRoot.value());
+    }
+
+    for (qint32 i = 0; i < listQueue.count(); i++) {
+        qint32 nState = listQueue.at(i);
+
+        QMapIterator<quint8, qint32> iter(listChildren.at(nState));
+
+        while (iter.hasNext()) {
+            iter.next();
+
+            quint8 nByte = iter.key();
+            qint32 nChild = iter.value();
+            qint32 nFail = result.listFail.at(nState);
+
+            while ((nFail != 0) && (!listChildren.at(nFail).contains(nByte))) {
+                nFail = result.listFail.at(nFail);
+            }
+
+            nFail = listChildren.at(nFail).value(nByte, 0);
+
+            result.listFail[nChild] = nFail;
+            result.listOutputLink[nChild] = result.listOutputCount.at(nFail) ? nFail : result.listOutputLink.at(nFail);
+
+            listQueue.append(nChild);
+        }
+    }
+
+    return result;
+}
+
+XBinary::MULTISIGNATURE XBinary::createMultiSignature(const QList<QString> &listSignatures)
+{
+    QList<COMPILED_SIGNATURE> listCompiled;
+
+    qint32 nNumberOfSignatures = listSignatures.count();
+
+    for (qint32 i = 0; i < nNumberOfSignatures; i++) {
+        listCompiled.append(getCompiledSignature(listSignatures.at(i)));
+    }
+
+    return createMultiSignature(listCompiled);
+}
+
+static inline qint32 _x_getMultiSignatureNextState(const XBinary::MULTISIGNATURE *pMultiSignature, qint32 nState, quint8 nByte)
+{
+    while (nState != 0) {
+        qint32 nFirst = pMultiSignature->listEdgeFirst.at(nState);
+        qint32 nCount = pMultiSignature->listEdgeCount.at(nState);
+        const quint8 *pEdgeBytes = pMultiSignature->listEdgeBytes.constData() + nFirst;
+
+        for (qint32 i = 0; (i < nCount) && (pEdgeBytes[i] <= nByte); i++) {
+            if (pEdgeBytes[i] == nByte) {
+                return pMultiSignature->listEdgeTargets.at(nFirst + i);
+            }
+        }
+
+        nState = pMultiSignature->listFail.at(nState);
+    }
+
+    return pMultiSignature->listRootNext.at(nByte);
+}
+
+static bool _x_compareMultiSignatureMatch(const XBinary::MULTISIGNATURE_MATCH &match1, const XBinary::MULTISIGNATURE_MATCH &match2)
+{
+    if (match1.nOffset != match2.nOffset) {
+        return match1.nOffset < match2.nOffset;
+    }
+
+    return match1.nSignatureIndex < match2.nSignatureIndex;
+}
+
+QVector<XBinary::MULTISIGNATURE_MATCH> XBinary::multiSearch_signatures(_MEMORY_MAP *pMemoryMap, qint64 nOffset, qint64 nSize, const MULTISIGNATURE *pMultiSignature,
+                                                                       qint32 nLimit, PDSTRUCT *pPdStruct)
+{
+    PDSTRUCT pdStructEmpty = XBinary::createPdStruct();
+
+    if (!pPdStruct) {
+        pPdStruct = &pdStructEmpty;
+    }
+
+    QVector<MULTISIGNATURE_MATCH> listResult;
+
+    qint64 _nTotalSize = getSize();
+
+    if (nSize == -1) {
+        nSize = _nTotalSize - nOffset;
+    }
+
+    if (nOffset + nSize > _nTotalSize) {
+        nSize = _nTotalSize - nOffset;
+    }
+
+    if ((nOffset < 0) || (nSize <= 0)) {
+        return listResult;
+    }
+
+    qint32 _nFreeIndex = XBinary::getFreeIndex(pPdStruct);
+    XBinary::setPdStructInit(pPdStruct, _nFreeIndex, nSize);
+
+    bool bLimit = false;
+
+    // Signatures without a literal anchor, e.g. starting with an address; only the first nLimit matches of each can be in the result
+    qint32 nNumberOfUnanchored = pMultiSignature->listUnanchored.count();
+
+    for (qint32 i = 0; (i < nNumberOfUnanchored) && isPdStructNotCanceled(pPdStruct); i++) {
+        qint32 nSignatureIndex = pMultiSignature->listUnanchored.at(i);
+        const COMPILED_SIGNATURE &compiledSignature = pMultiSignature->listSignatures.at(nSignatureIndex);
+
+        qint64 _nOffset = nOffset;
+        qint32 nNumberOfMatches = 0;
+
+        while ((_nOffset < nOffset + nSize) && ((nLimit == -1) || (nNumberOfMatches < nLimit)) && isPdStructNotCanceled(pPdStruct)) {
+            qint64 nResultSize = 0;
+            qint64 nResultOffset = find_signature(pMemoryMap, _nOffset, nOffset + nSize - _nOffset, compiledSignature, &nResultSize, pPdStruct);
+
+            if (nResultOffset == -1) {
+                break;
+            }
+
+            MULTISIGNATURE_MATCH match = {};
+            match.nSignatureIndex = nSignatureIndex;
+            match.nOffset = nResultOffset;
+            match.nSize = nResultSize;
+
+            listResult.append(match);
+            nNumberOfMatches++;
+
+            _nOffset = nResultOffset + 1;
+        }
+    }
+
+    // One pass over the region; the automaton state carries over buffer boundaries, so buffers do not overlap
+    if (pMultiSignature->listOutputSignatures.count()) {
+        // A match is reported when its anchor ends, at most nMaxLead bytes after its start
+        qint64 nMaxLead = 1;
+        qint32 nNumberOfSignatures = pMultiSignature->listSignatures.count();
+
+        for (qint32 i = 0; i < nNumberOfSignatures; i++) {
+            if (pMultiSignature->listAnchorDeltas.at(i) != -1) {
+                nMaxLead = qMax(nMaxLead, pMultiSignature->listAnchorDeltas.at(i) + pMultiSignature->listAnchorSizes.at(i));
+            }
+        }
+
+        qint64 nBufferSize = getBufferSize(pPdStruct);
+        char *pBuffer = nullptr;
+
+        if (!m_pConstMemory) {
+            pBuffer = new char[nBufferSize];
+        }
+
+        qint32 nState = 0;
+        qint64 nCurrentOffset = nOffset;
+        qint64 nEndOffset = nOffset + nSize;
+        // As in find_signature, only the start of a match has to be in the region; its anchor may end past it
+        qint64 nScanEndOffset = qMin(nEndOffset + nMaxLead - 1, _nTotalSize);
+
+        while ((nCurrentOffset < nScanEndOffset) && (!bLimit) && isPdStructNotCanceled(pPdStruct)) {
+            qint64 nTemp = qMin(nBufferSize, nScanEndOffset - nCurrentOffset);
+            const char *pData = nullptr;
+
+            if (m_pConstMemory) {
+                pData = (const char *)m_pConstMemory + nCurrentOffset;
+            } else {
+                if (read_array_process(nCurrentOffset, pBuffer, nTemp, pPdStruct) != nTemp) {
+                    pPdStruct->sInfoString = tr("Read error");
+                    break;
+                }
+
+                pData = pBuffer;
+            }
+
+            for (qint64 i = 0; i < nTemp; i++) {
+                nState = _x_getMultiSignatureNextState(pMultiSignature, nState, (quint8)pData[i]);
+
+                qint32 nOutputState = pMultiSignature->listOutputCount.at(nState) ? nState : pMultiSignature->listOutputLink.at(nState);
+
+                while (nOutputState != -1) {
+                    qint32 nFirst = pMultiSignature->listOutputFirst.at(nOutputState);
+                    qint32 nCount = pMultiSignature->listOutputCount.at(nOutputState);
+
+                    for (qint32 j = 0; j < nCount; j++) {
+                        qint32 nSignatureIndex = pMultiSignature->listOutputSignatures.at(nFirst + j);
+                        qint64 nStart = nCurrentOffset + i + 1 - pMultiSignature->listAnchorSizes.at(nSignatureIndex) -
+                                        pMultiSignature->listAnchorDeltas.at(nSignatureIndex);
+
+                        if ((nStart >= nOffset) && (nStart < nEndOffset)) {
+                            const COMPILED_SIGNATURE &compiledSignature = pMultiSignature->listSignatures.at(nSignatureIndex);
+
+                            bool bIsMatch = false;
+
+                            if (compiledSignature.bIsMasked) {
+                                bIsMatch = _compareMaskedSignature(compiledSignature, nStart);
+                            } else {
+                                bIsMatch = _compareSignature(pMemoryMap, &(compiledSignature.listRecords), nStart, pPdStruct);
+                            }
+
+                            if (bIsMatch) {
+                                MULTISIGNATURE_MATCH match = {};
+                                match.nSignatureIndex = nSignatureIndex;
+                                match.nOffset = nStart;
+                                match.nSize = compiledSignature.nResultSize;
+
+                                listResult.append(match);
+                            }
+                        }
+                    }
+
+                    nOutputState = pMultiSignature->listOutputLink.at(nOutputState);
+                }
+            }
 
-        listResult.append(record);
+            nCurrentOffset += nTemp;
 
-        nCurrentRecords++;
+            if ((nLimit > 0) && (listResult.count() >= nLimit)) {
+                // Keep the nLimit lowest matches; stop once no later match can start before the last of them
+                std::nth_element(listResult.begin(), listResult.begin() + (nLimit - 1), listResult.end(), _x_compareMultiSignatureMatch);
+                listResult.resize(nLimit);
 
-        if (nCurrentRecords >= nLimit) {
-            pPdStruct->sInfoString = QString("%1: %2").arg(tr("Maximum"), QString::number(nCurrentRecords));
+                qint64 nLastOffset = listResult.at(nLimit - 1).nOffset;
 
-            break;
+                if ((nCurrentOffset < nScanEndOffset) && (nLastOffset < nCurrentOffset + 1 - nMaxLead)) {
+                    bLimit = true;
+                }
+            }
+
+            XBinary::setPdStructCurrent(pPdStruct, _nFreeIndex, qMin(nCurrentOffset, nEndOffset) - nOffset);
         }
 
-        _nOffset = nSignatureOffset + nSignatureSize;
-        _nSize = nSize - (_nOffset - nOffset);
+        if (!m_pConstMemory) {
+            delete[] pBuffer;
+        }
+    }
 
-        XBinary::setPdStructCurrent(pPdStruct, _nFreeIndex, _nOffset - nOffset);
+    std::sort(listResult.begin(), listResult.end(), _x_compareMultiSignatureMatch);
+
+    if ((nLimit != -1) && (listResult.count() > nLimit)) {
+        listResult.resize(nLimit);
+        bLimit = true;
+    }
+
+    if (bLimit) {
+        pPdStruct->sInfoString = QString("%1: %2").arg(tr("Maximum"), QString::number(listResult.count()));
     }
 
     XBinary::setPdStructFinished(pPdStruct, _nFreeIndex);
@@ -5413,7 +7008,7 @@ QVector<XBinary::MS_RECORD> XBinary::multiSearch_signature(_MEMORY_MAP *pMemoryM
 QVector<XBinary::MS_RECORD> XBinary::multiSearch_value(qint64 nOffset, qint64 nSize, qint32 nLimit, QVariant varValue, VT valueType, bool bIsBigEndian,
                                                        PDSTRUCT *pPdStruct)
 {
-    _MEMORY_MAP memoryMap = getMemoryMap(MAPMODE_UNKNOWN, pPdStruct);
+    _MEMORY_MAP memoryMap = getCachedMemoryMap(MAPMODE_UNKNOWN, pPdStruct);
 
     return multiSearch_value(&memoryMap, nOffset, nSize, nLimit, varValue, valueType, bIsBigEndian, pPdStruct);
 }
@@ -5909,21 +7504,172 @@ bool XBinary::isSignaturePresent(_MEMORY_MAP *pMemoryMap, qint64 nOffset, qint64
     return (find_signature(pMemoryMap, nOffset, nSize, sSignature, &nResultSize, pPdStruct) != -1);
 }
 
+bool XBinary::isSignaturePresent(_MEMORY_MAP *pMemoryMap, qint64 nOffset, qint64 nSize, const COMPILED_SIGNATURE &compiledSignature, PDSTRUCT *pPdStruct)
+{
+    qint64 nResultSize = 0;
+
+    return (find_signature(pMemoryMap, nOffset, nSize, compiledSignature, &nResultSize, pPdStruct) != -1);
+}
+
 bool XBinary::isSignatureValid(const QString &sSignature, PDSTRUCT *pPdStruct)
 {
     bool bResult = false;
 
     if (sSignature.size()) {
-        QString _sSignature = convertSignature(sSignature);
+        COMPILED_SIGNATURE compiledSignature = getCompiledSignature(sSignature);
 
-        bResult = true;
+        if (compiledSignature.sInfoString.size()) {
+            setPdStructInfoString(pPdStruct, compiledSignature.sInfoString);
+        }
 
-        QList<SIGNATURE_RECORD> listSignatureRecords = getSignatureRecords(_sSignature, &bResult, pPdStruct);
+        bResult = compiledSignature.bIsValid;
     }
 
     return bResult;
 }
 
+XBinary::COMPILED_SIGNATURE XBinary::compileSignature(const QString &sSignature)
+{
+    COMPILED_SIGNATURE result = {};
+
+    result.sSignature = sSignature;
+    result.bIsValid = true;
+    result.stSearch = ST_COMPAREBYTES;
+
+    QString _sSignature = convertSignature(sSignature);
+
+    bool bIsDelta = _sSignature.contains(QChar('+'));
+
+    if (_sSignature.contains(QChar('$')) || _sSignature.contains(QChar('#')) || bIsDelta) {
+        result.nResultSize = 1;
+    } else {
+        // Fix size
+        result.nResultSize = _sSignature.size() / 2;
+    }
+
+    PDSTRUCT pdStruct = XBinary::createPdStruct();
+
+    result.listRecords = getSignatureRecords(_sSignature, &result.bIsValid, &pdStruct);
+    result.sInfoString = pdStruct.sInfoString;
+
+    if (_sSignature.contains(QChar('.')) || _sSignature.contains(QChar('$')) || _sSignature.contains(QChar('#')) || bIsDelta || _sSignature.contains(QChar('*')) ||
+        _sSignature.contains(QChar('%')) || _sSignature.contains(QChar('!')) || _sSignature.contains(QChar('_')) || _sSignature.contains(QChar('&'))) {
+        if (!bIsDelta) {
+            qint32 nNumberOfRecords = result.listRecords.count();
+            qint64 nCurrentDelta = 0;
+
+            for (qint32 i = 0; i < nNumberOfRecords; i++) {
+                const SIGNATURE_RECORD &record = result.listRecords.at(i);
+
+                if ((record.st == ST_ADDRESS) || (record.st == ST_RELOFFSET)) {
+                    break;
+                } else if ((record.nWindowSize > result.nSearchMaxSize) &&
+                           ((record.st == ST_COMPAREBYTES) || (record.st == ST_FINDBYTES) || (record.st == ST_NOTNULL) || (record.st == ST_ANSI) ||
+                            (record.st == ST_NOTANSI) || (record.st == ST_NOTANSIANDNULL) || (record.st == ST_ANSINUMBER))) {
+                    result.nSearchMaxSize = record.nWindowSize;
+                    result.stSearch = record.st;
+                    result.nSearchDelta = nCurrentDelta;
+                    result.nSearchFirstIndex = i;
+                }
+
+                nCurrentDelta += record.nWindowSize;
+            }
+        }
+    } else {
+        result.bIsPlain = true;
+        result.baPlain = QByteArray::fromHex(QByteArray(_sSignature.toLatin1().data()));
+    }
+
+    if ((!result.bIsPlain) && result.bIsValid && (!bIsDelta)) {
+        // Bytes and skips only: flatten into pattern + mask
+        qint32 nNumberOfRecords = result.listRecords.count();
+        bool bIsMasked = (nNumberOfRecords > 0);
+
+        for (qint32 i = 0; (i < nNumberOfRecords) && bIsMasked; i++) {
+            const SIGNATURE_RECORD &record = result.listRecords.at(i);
+
+            if (record.st == ST_COMPAREBYTES) {
+                result.baMaskedPattern.append(record.baData);
+                result.baMask.append(QByteArray(record.baData.size(), (char)0xFF));
+            } else if ((record.st == ST_SKIP) && (record.nWindowSize > 0)) {
+                result.baMaskedPattern.append(QByteArray(record.nWindowSize, 0));
+                result.baMask.append(QByteArray(record.nWindowSize, 0));
+            } else {
+                bIsMasked = false;
+            }
+        }
+
+        if (bIsMasked) {
+            result.bIsMasked = true;
+        } else {
+            result.baMaskedPattern.clear();
+            result.baMask.clear();
+        }
+    }
+
+    return result;
+}
+
+struct XSIGNATURE_CACHE {
+    QReadWriteLock lock;
+    QHash<QString, XBinary::COMPILED_SIGNATURE> hashSignatures;
+};
+
+// Signatures built at run time must not grow the cache without bound
+static const qint32 _XSIGNATURE_CACHE_MAX = 0x10000;
+
+static XSIGNATURE_CACHE *_x_getSignatureCache()
+{
+    static XSIGNATURE_CACHE cache;
+
+    return &cache;
+}
+
+XBinary::COMPILED_SIGNATURE XBinary::getCompiledSignature(const QString &sSignature)
+{
+    COMPILED_SIGNATURE result = {};
+
+    XSIGNATURE_CACHE *pCache = _x_getSignatureCache();
+    bool bFound = false;
+
+    pCache->lock.lockForRead();
+
+    QHash<QString, COMPILED_SIGNATURE>::const_iterator iter = pCache->hashSignatures.constFind(sSignature);
+
+    if (iter != pCache->hashSignatures.constEnd()) {
+        result = iter.value();
+        bFound = true;
+    }
+
+    pCache->lock.unlock();
+
+    if (!bFound) {
+        // Compiled outside the lock; two threads racing on the same string produce identical results
+        result = compileSignature(sSignature);
+
+        pCache->lock.lockForWrite();
+
+        if (pCache->hashSignatures.count() >= _XSIGNATURE_CACHE_MAX) {
+            pCache->hashSignatures.clear();
+        }
+
+        pCache->hashSignatures.insert(sSignature, result);
+
+        pCache->lock.unlock();
+    }
+
+    return result;
+}
+
+void XBinary::clearCompiledSignatureCache()
+{
+    XSIGNATURE_CACHE *pCache = _x_getSignatureCache();
+
+    pCache->lock.lockForWrite();
+    pCache->hashSignatures.clear();
+    pCache->lock.unlock();
+}
+
 bool XBinary::createFile(const QString &sFileName, qint64 nFileSize)
 {
     bool bResult = false;
@@ -6563,6 +8309,25 @@ bool XBinary::compareMemory(char *pMemory1, const char *pMemory2, qint64 nSize)
 #endif
 }
 
+bool XBinary::compareMemoryMasked(const char *pMemory, const char *pPattern, const char *pMask, qint64 nSize)
+{
+#ifdef USE_XSIMD
+    return xsimd_compare_masked(pMemory, pPattern, pMask, nSize) != 0;
+#else
+    const quint8 *pData = (const quint8 *)pMemory;
+    const quint8 *pPatternData = (const quint8 *)pPattern;
+    const quint8 *pMaskData = (const quint8 *)pMask;
+
+    for (qint64 i = 0; i < nSize; i++) {
+        if ((pData[i] ^ pPatternData[i]) & pMaskData[i]) {
+            return false;
+        }
+    }
+
+    return true;
+#endif
+}
+
 bool XBinary::compareMemoryByteI(quint8 *pMemory, const quint8 *pMemoryU, const quint8 *pMemoryL, qint64 nSize)
 {
     bool bResult = true;
@@ -6613,41 +8378,41 @@ bool XBinary::isOffsetValid(qint64 nOffset)
 
 bool XBinary::isAddressValid(XADDR nAddress)
 {
-    _MEMORY_MAP memoryMap = getMemoryMap();
+    _MEMORY_MAP memoryMap = getCachedMemoryMap();
 
     return isAddressValid(&memoryMap, nAddress);
 }
 
 bool XBinary::isRelAddressValid(qint64 nRelAddress)
 {
-    _MEMORY_MAP memoryMap = getMemoryMap();
+    _MEMORY_MAP memoryMap = getCachedMemoryMap();
 
     return isRelAddressValid(&memoryMap, nRelAddress);
 }
 
 XADDR XBinary::offsetToAddress(qint64 nOffset)
 {
-    _MEMORY_MAP memoryMap = getMemoryMap();
+    _MEMORY_MAP memoryMap = getCachedMemoryMap();
 
     return offsetToAddress(&memoryMap, nOffset);
 }
 
 qint64 XBinary::addressToOffset(quint64 nAddress)
 {
-    _MEMORY_MAP memoryMap = getMemoryMap();
+    _MEMORY_MAP memoryMap = getCachedMemoryMap();
     return addressToOffset(&memoryMap, nAddress);
 }
 
 XADDR XBinary::offsetToRelAddress(qint64 nOffset)
 {
-    _MEMORY_MAP memoryMap = getMemoryMap();
+    _MEMORY_MAP memoryMap = getCachedMemoryMap();
 
     return offsetToRelAddress(&memoryMap, nOffset);
 }
 
 qint64 XBinary::relAddressToOffset(qint64 nRelAddress)
 {
-    _MEMORY_MAP memoryMap = getMemoryMap();
+    _MEMORY_MAP memoryMap = getCachedMemoryMap();
 
     return relAddressToOffset(&memoryMap, nRelAddress);
 }
@@ -6664,16 +8429,7 @@ bool XBinary::isOffsetValid(XBinary::_MEMORY_MAP *pMemoryMap, qint64 nOffset)
     if (pMemoryMap->nBinarySize) {
         bResult = ((nOffset >= 0) && (nOffset < pMemoryMap->nBinarySize));
     } else {
-        qint32 nNumberOfRecords = pMemoryMap->listRecords.count();
-
-        for (qint32 i = 0; i < nNumberOfRecords; i++) {
-            if (pMemoryMap->listRecords.at(i).nSize && (pMemoryMap->listRecords.at(i).nOffset != -1)) {
-                if ((pMemoryMap->listRecords.at(i).nOffset <= nOffset) && (nOffset < pMemoryMap->listRecords.at(i).nOffset + pMemoryMap->listRecords.at(i).nSize)) {
-                    bResult = true;
-                    break;
-                }
-            }
-        }
+        bResult = (_findMemoryRecord(pMemoryMap, nOffset, false, MEMORY_LOOKUP_FIRST) != -1);
     }
 
     return bResult;
@@ -6686,7 +8442,7 @@ bool XBinary::isOffsetAndSizeValid(XBinary::_MEMORY_MAP *pMemoryMap, XBinary::OF
 
 bool XBinary::isOffsetAndSizeValid(qint64 nOffset, qint64 nSize)
 {
-    XBinary::_MEMORY_MAP memoryMap = getMemoryMap();
+    XBinary::_MEMORY_MAP memoryMap = getCachedMemoryMap();
 
     return isOffsetAndSizeValid(&memoryMap, nOffset, nSize);
 }
@@ -6721,16 +8477,7 @@ bool XBinary::isAddressValid(XBinary::_MEMORY_MAP *pMemoryMap, XADDR nAddress)
     if (pMemoryMap->nImageSize) {
         bResult = ((pMemoryMap->nModuleAddress <= nAddress) && (nAddress < (pMemoryMap->nModuleAddress + pMemoryMap->nImageSize)));
     } else {
-        qint32 nNumberOfRecords = pMemoryMap->listRecords.count();
-
-        for (qint32 i = 0; i < nNumberOfRecords; i++) {
-            if (pMemoryMap->listRecords.at(i).nSize && (pMemoryMap->listRecords.at(i).nAddress != (XADDR)-1)) {
-                if ((pMemoryMap->listRecords.at(i).nAddress <= nAddress) && (nAddress < pMemoryMap->listRecords.at(i).nAddress + pMemoryMap->listRecords.at(i).nSize)) {
-                    bResult = true;
-                    break;
-                }
-            }
-        }
+        bResult = (_findMemoryRecord(pMemoryMap, nAddress, true, MEMORY_LOOKUP_FIRST) != -1);
     }
 
     return bResult;
@@ -6759,8 +8506,6 @@ XADDR XBinary::offsetToAddress(XBinary::_MEMORY_MAP *pMemoryMap, qint64 nOffset)
 {
     XADDR nResult = -1;
 
-    qint32 nNumberOfRecords = pMemoryMap->listRecords.count();
-
     //    for (qint32 i = 0; i < nNumberOfRecords; i++) {
     //        if (pMemoryMap->listRecords.at(i).nSize && (pMemoryMap->listRecords.at(i).nOffset != -1) && (pMemoryMap->listRecords.at(i).nAddress != -1)) {
     //            if ((pMemoryMap->listRecords.at(i).nOffset <= nOffset) && (nOffset < pMemoryMap->listRecords.at(i).nOffset + pMemoryMap->listRecords.at(i).nSize)) {
@@ -6772,12 +8517,15 @@ XADDR XBinary::offsetToAddress(XBinary::_MEMORY_MAP *pMemoryMap, qint64 nOffset)
 
     // From the last to the fist
 
-    for (qint32 i = nNumberOfRecords - 1; i >= 0; i--) {
-        if (pMemoryMap->listRecords.at(i).nSize && (pMemoryMap->listRecords.at(i).nOffset != -1) && (pMemoryMap->listRecords.at(i).nAddress != (XADDR)-1)) {
-            if ((pMemoryMap->listRecords.at(i).nOffset <= nOffset) && (nOffset < pMemoryMap->listRecords.at(i).nOffset + pMemoryMap->listRecords.at(i).nSize)) {
-                nResult = (nOffset - pMemoryMap->listRecords.at(i).nOffset) + pMemoryMap->listRecords.at(i).nAddress;
-                break;
-            }
+    qint32 nRecord = _findMemoryRecord(pMemoryMap, nOffset, false, MEMORY_LOOKUP_LASTMAPPED);
+
+    if (nRecord != -1) {
+        const _MEMORY_MAP_COMPACT *pCompact = _getCompactMemoryMap(pMemoryMap);
+
+        if (pCompact) {
+            nResult = (nOffset - pCompact->listOffsets.at(nRecord)) + pCompact->listAddresses.at(nRecord);
+        } else {
+            nResult = (nOffset - pMemoryMap->listRecords.at(nRecord).nOffset) + pMemoryMap->listRecords.at(nRecord).nAddress;
         }
     }
 
@@ -6826,14 +8574,15 @@ qint64 XBinary::addressToOffset(XBinary::_MEMORY_MAP *pMemoryMap, XADDR nAddress
     //     }
     // }
 
-    qint32 nNumberOfRecords = pMemoryMap->listRecords.count();
+    qint32 nRecord = _findMemoryRecord(pMemoryMap, nAddress, true, MEMORY_LOOKUP_LASTMAPPED);
 
-    for (qint32 i = nNumberOfRecords - 1; i >= 0; i--) {
-        if (pMemoryMap->listRecords.at(i).nSize && (pMemoryMap->listRecords.at(i).nAddress != (XADDR)-1) && (pMemoryMap->listRecords.at(i).nOffset != -1)) {
-            if ((pMemoryMap->listRecords.at(i).nAddress <= nAddress) && (nAddress < pMemoryMap->listRecords.at(i).nAddress + pMemoryMap->listRecords.at(i).nSize)) {
-                nResult = (nAddress - pMemoryMap->listRecords.at(i).nAddress) + pMemoryMap->listRecords.at(i).nOffset;
-                break;
-            }
+    if (nRecord != -1) {
+        const _MEMORY_MAP_COMPACT *pCompact = _getCompactMemoryMap(pMemoryMap);
+
+        if (pCompact) {
+            nResult = (nAddress - pCompact->listAddresses.at(nRecord)) + pCompact->listOffsets.at(nRecord);
+        } else {
+            nResult = (nAddress - pMemoryMap->listRecords.at(nRecord).nAddress) + pMemoryMap->listRecords.at(nRecord).nOffset;
         }
     }
 
@@ -6908,156 +8657,385 @@ XADDR XBinary::getSegmentAddress(quint16 nSegment, quint16 nAddress)
 {
     XADDR nResult = nSegment * 16 + nAddress;
 
-    if (nResult >= 0x100000) {
-        nResult -= 0x100000;
+    if (nResult >= 0x100000) {
+        nResult -= 0x100000;
+    }
+
+    return nResult;
+}
+
+XBinary::_MEMORY_RECORD XBinary::getMemoryRecordByIndex(_MEMORY_MAP *pMemoryMap, qint32 nIndex)
+{
+    _MEMORY_RECORD result = {};
+
+    if ((nIndex >= 0) && (nIndex < pMemoryMap->listRecords.count())) {
+        result = pMemoryMap->listRecords.at(nIndex);
+    }
+
+    return result;
+}
+
+qint32 XBinary::getMemoryIndexByOffset(_MEMORY_MAP *pMemoryMap, qint64 nOffset)
+{
+    qint32 nResult = _findMemoryRecord(pMemoryMap, nOffset, false, MEMORY_LOOKUP_FIRST);
+
+    return nResult;
+}
+
+XBinary::_MEMORY_RECORD XBinary::getMemoryRecordByOffset(XBinary::_MEMORY_MAP *pMemoryMap, qint64 nOffset)
+{
+    _MEMORY_RECORD result = {};
+
+    qint32 nRecord = _findMemoryRecord(pMemoryMap, nOffset, false, MEMORY_LOOKUP_FIRST);
+
+    if (nRecord != -1) {
+        result = pMemoryMap->listRecords.at(nRecord);
+    }
+
+    return result;
+}
+
+XBinary::_MEMORY_RECORD XBinary::getMemoryRecordByAddress(XBinary::_MEMORY_MAP *pMemoryMap, XADDR nAddress)
+{
+    _MEMORY_RECORD result = {};
+
+    qint32 nRecord = _findMemoryRecord(pMemoryMap, nAddress, true, MEMORY_LOOKUP_FIRST);
+
+    if (nRecord != -1) {
+        result = pMemoryMap->listRecords.at(nRecord);
+    }
+
+    return result;
+}
+
+XBinary::_MEMORY_RECORD XBinary::getMemoryRecordByRelAddress(XBinary::_MEMORY_MAP *pMemoryMap, qint64 nRelAddress)
+{
+    _MEMORY_RECORD result = {};
+
+    XADDR nAddress = relAddressToAddress(pMemoryMap, nRelAddress);
+
+    if (nAddress != (XADDR)-1) {
+        result = getMemoryRecordByAddress(pMemoryMap, nAddress);
+    }
+
+    return result;
+}
+
+qint32 XBinary::addressToFileTypeNumber(_MEMORY_MAP *pMemoryMap, XADDR nAddress)
+{
+    qint32 nResult = 0;
+
+    qint32 nRecord = _findMemoryRecord(pMemoryMap, nAddress, true, MEMORY_LOOKUP_FIRST);
+
+    if (nRecord != -1) {
+        const _MEMORY_MAP_COMPACT *pCompact = _getCompactMemoryMap(pMemoryMap);
+
+        if (pCompact) {
+            nResult = pCompact->listFilePartNumbers.at(nRecord);
+        } else {
+            nResult = pMemoryMap->listRecords.at(nRecord).nFilePartNumber;
+        }
+    }
+
+    return nResult;
+}
+
+qint32 XBinary::relAddressToFileTypeNumber(_MEMORY_MAP *pMemoryMap, qint64 nRelAddress)
+{
+    qint32 nResult = 0;
+
+    XADDR nAddress = relAddressToAddress(pMemoryMap, nRelAddress);
+
+    if (nAddress != (XADDR)-1) {
+        nResult = addressToFileTypeNumber(pMemoryMap, nAddress);
+    }
+
+    return nResult;
+}
+
+bool XBinary::isAddressInHeader(_MEMORY_MAP *pMemoryMap, XADDR nAddress)
+{
+    bool bResult = false;
+
+    qint32 nRecord = _findMemoryRecord(pMemoryMap, nAddress, true, MEMORY_LOOKUP_FIRST);
+
+    if (nRecord != -1) {
+        const _MEMORY_MAP_COMPACT *pCompact = _getCompactMemoryMap(pMemoryMap);
+
+        if (pCompact) {
+            bResult = (pCompact->listFileParts.at(nRecord) == (quint32)FILEPART_HEADER);
+        } else {
+            bResult = (pMemoryMap->listRecords.at(nRecord).filePart == FILEPART_HEADER);
+        }
+    }
+
+    return bResult;
+}
+
+bool XBinary::isRelAddressInHeader(_MEMORY_MAP *pMemoryMap, qint64 nRelAddress)
+{
+    bool bResult = false;
+
+    XADDR nAddress = relAddressToAddress(pMemoryMap, nRelAddress);
+
+    if (nAddress != (XADDR)-1) {
+        bResult = isAddressInHeader(pMemoryMap, nAddress);
+    }
+
+    return bResult;
+}
+
+QString XBinary::getLoadSectionNameByOffset(_MEMORY_MAP *pMemoryMap, qint64 nOffset)
+{
+    QString sResult;
+
+    qint32 nRecord = _findMemoryRecord(pMemoryMap, nOffset, false, MEMORY_LOOKUP_FIRSTMAPPED);
+
+    if (nRecord != -1) {
+        sResult = pMemoryMap->listRecords.at(nRecord).sName;
+    }
+
+    return sResult;
+}
+
+void XBinary::_buildCompactMemoryMap(QList<_MEMORY_RECORD> *pListRecords, _MEMORY_MAP_COMPACT *pCompact)
+{
+    qint32 nNumberOfRecords = pListRecords->count();
+
+    *pCompact = _MEMORY_MAP_COMPACT();
+
+    pCompact->listOffsets.resize(nNumberOfRecords);
+    pCompact->listAddresses.resize(nNumberOfRecords);
+    pCompact->listSizes.resize(nNumberOfRecords);
+    pCompact->listFileParts.resize(nNumberOfRecords);
+    pCompact->listFilePartNumbers.resize(nNumberOfRecords);
+    pCompact->listIndexes.resize(nNumberOfRecords);
+    pCompact->baIsVirtual.resize(nNumberOfRecords);
+
+    for (qint32 i = 0; i < nNumberOfRecords; i++) {
+        const _MEMORY_RECORD &record = pListRecords->at(i);
+
+        pCompact->listOffsets[i] = record.nOffset;
+        pCompact->listAddresses[i] = record.nAddress;
+        pCompact->listSizes[i] = record.nSize;
+        pCompact->listFileParts[i] = (quint32)record.filePart;
+        pCompact->listFilePartNumbers[i] = record.nFilePartNumber;
+        pCompact->listIndexes[i] = record.nIndex;
+        pCompact->baIsVirtual.setBit(i, record.bIsVirtual);
     }
-
-    return nResult;
 }
 
-XBinary::_MEMORY_RECORD XBinary::getMemoryRecordByIndex(_MEMORY_MAP *pMemoryMap, qint32 nIndex)
+const XBinary::_MEMORY_MAP_COMPACT *XBinary::_getCompactMemoryMap(const _MEMORY_MAP *pMemoryMap)
 {
-    _MEMORY_RECORD result = {};
+    const _MEMORY_MAP_COMPACT *pResult = nullptr;
 
-    if ((nIndex >= 0) && (nIndex < pMemoryMap->listRecords.count())) {
-        result = pMemoryMap->listRecords.at(nIndex);
+    if (_isMemoryIndexValid(pMemoryMap)) {
+        pResult = &(pMemoryMap->index.compact);
     }
 
-    return result;
+    return pResult;
 }
 
-qint32 XBinary::getMemoryIndexByOffset(_MEMORY_MAP *pMemoryMap, qint64 nOffset)
+void XBinary::_buildMemorySegments(QList<_MEMORY_RECORD> *pListRecords, bool bAddress, QVector<_MEMORY_SEGMENT> *pListSegments)
 {
-    qint32 nResult = -1;
+    pListSegments->clear();
 
-    qint32 nNumberOfRecords = pMemoryMap->listRecords.count();
+    // Sweep over record boundaries; a negative record number closes the record
+    QVector<QPair<XADDR, qint32>> listEvents;
+
+    qint32 nNumberOfRecords = pListRecords->count();
 
     for (qint32 i = 0; i < nNumberOfRecords; i++) {
-        if (pMemoryMap->listRecords.at(i).nSize && (pMemoryMap->listRecords.at(i).nOffset != -1)) {
-            if ((pMemoryMap->listRecords.at(i).nOffset <= nOffset) && (nOffset < pMemoryMap->listRecords.at(i).nOffset + pMemoryMap->listRecords.at(i).nSize)) {
-                nResult = i;
-                break;
-            }
+        const _MEMORY_RECORD &record = pListRecords->at(i);
+
+        XADDR nStart = bAddress ? record.nAddress : (XADDR)record.nOffset;
+
+        if ((record.nSize > 0) && (nStart != (XADDR)-1)) {
+            listEvents.append(qMakePair(nStart, i + 1));
+            listEvents.append(qMakePair(nStart + record.nSize, -(i + 1)));
         }
     }
 
-    return nResult;
-}
+    std::sort(listEvents.begin(), listEvents.end());
 
-XBinary::_MEMORY_RECORD XBinary::getMemoryRecordByOffset(XBinary::_MEMORY_MAP *pMemoryMap, qint64 nOffset)
-{
-    _MEMORY_RECORD result = {};
+    QMap<qint32, bool> mapActive;
+    QMap<qint32, bool> mapActiveMapped;
 
-    qint32 nNumberOfRecords = pMemoryMap->listRecords.count();
+    qint32 nNumberOfEvents = listEvents.count();
 
-    for (qint32 i = 0; i < nNumberOfRecords; i++) {
-        if (pMemoryMap->listRecords.at(i).nSize && (pMemoryMap->listRecords.at(i).nOffset != -1)) {
-            if ((pMemoryMap->listRecords.at(i).nOffset <= nOffset) && (nOffset < pMemoryMap->listRecords.at(i).nOffset + pMemoryMap->listRecords.at(i).nSize)) {
-                result = pMemoryMap->listRecords.at(i);
-                break;
+    for (qint32 i = 0; i < nNumberOfEvents;) {
+        XADDR nPos = listEvents.at(i).first;
+
+        for (; (i < nNumberOfEvents) && (listEvents.at(i).first == nPos); i++) {
+            qint32 nRecord = qAbs(listEvents.at(i).second) - 1;
+            bool bIsMapped = (pListRecords->at(nRecord).nOffset != -1) && (pListRecords->at(nRecord).nAddress != (XADDR)-1);
+
+            if (listEvents.at(i).second > 0) {
+                mapActive.insert(nRecord, true);
+
+                if (bIsMapped) mapActiveMapped.insert(nRecord, true);
+            } else {
+                mapActive.remove(nRecord);
+                mapActiveMapped.remove(nRecord);
             }
         }
-    }
-
-    return result;
-}
 
-XBinary::_MEMORY_RECORD XBinary::getMemoryRecordByAddress(XBinary::_MEMORY_MAP *pMemoryMap, XADDR nAddress)
-{
-    _MEMORY_RECORD result = {};
+        if ((i < nNumberOfEvents) && (!mapActive.isEmpty())) {
+            _MEMORY_SEGMENT segment = {};
+            segment.nStart = nPos;
+            segment.nEnd = listEvents.at(i).first;
+            segment.nFirst = mapActive.firstKey();
+            segment.nFirstMapped = mapActiveMapped.isEmpty() ? -1 : mapActiveMapped.firstKey();
+            segment.nLastMapped = mapActiveMapped.isEmpty() ? -1 : mapActiveMapped.lastKey();
 
-    qint32 nNumberOfRecords = pMemoryMap->listRecords.count();
+            if (!pListSegments->isEmpty()) {
+                _MEMORY_SEGMENT &segmentPrev = pListSegments->last();
 
-    for (qint32 i = 0; i < nNumberOfRecords; i++) {
-        if (pMemoryMap->listRecords.at(i).nSize && (pMemoryMap->listRecords.at(i).nAddress != (XADDR)-1)) {
-            if ((pMemoryMap->listRecords.at(i).nAddress <= nAddress) && (nAddress < pMemoryMap->listRecords.at(i).nAddress + pMemoryMap->listRecords.at(i).nSize)) {
-                result = pMemoryMap->listRecords.at(i);
-                break;
+                if ((segmentPrev.nEnd == segment.nStart) && (segmentPrev.nFirst == segment.nFirst) && (segmentPrev.nFirstMapped == segment.nFirstMapped) &&
+                    (segmentPrev.nLastMapped == segment.nLastMapped)) {
+                    segmentPrev.nEnd = segment.nEnd;
+                    continue;
+                }
             }
+
+            pListSegments->append(segment);
         }
     }
-
-    return result;
 }
 
-XBinary::_MEMORY_RECORD XBinary::getMemoryRecordByRelAddress(XBinary::_MEMORY_MAP *pMemoryMap, qint64 nRelAddress)
+bool XBinary::_prepareMemoryIndex(_MEMORY_MAP *pMemoryMap)
 {
-    _MEMORY_RECORD result = {};
+    bool bResult = false;
 
-    XADDR nAddress = relAddressToAddress(pMemoryMap, nRelAddress);
+    qint32 nNumberOfRecords = pMemoryMap->listRecords.count();
 
-    if (nAddress != (XADDR)-1) {
-        result = getMemoryRecordByAddress(pMemoryMap, nAddress);
+    // Small maps: a linear scan is cheaper than building the index
+    if (nNumberOfRecords >= 16) {
+        _MEMORY_INDEX *pIndex = &(pMemoryMap->index);
+
+        if (!_isMemoryIndexValid(pMemoryMap)) {
+            _buildMemorySegments(&(pMemoryMap->listRecords), false, &(pIndex->listOffsetSegments));
+            _buildMemorySegments(&(pMemoryMap->listRecords), true, &(pIndex->listAddressSegments));
+            _buildCompactMemoryMap(&(pMemoryMap->listRecords), &(pIndex->compact));
+            pIndex->nNumberOfRecords = nNumberOfRecords;
+        }
+
+        bResult = true;
     }
 
-    return result;
+    return bResult;
 }
 
-qint32 XBinary::addressToFileTypeNumber(_MEMORY_MAP *pMemoryMap, XADDR nAddress)
+void XBinary::resetMemoryIndex(_MEMORY_MAP *pMemoryMap)
 {
-    _MEMORY_RECORD mm = getMemoryRecordByAddress(pMemoryMap, nAddress);
-
-    return mm.nFilePartNumber;
-    ;
+    pMemoryMap->index = _MEMORY_INDEX();
 }
 
-qint32 XBinary::relAddressToFileTypeNumber(_MEMORY_MAP *pMemoryMap, qint64 nRelAddress)
+bool XBinary::_isMemoryIndexValid(const _MEMORY_MAP *pMemoryMap)
 {
-    _MEMORY_RECORD mm = getMemoryRecordByRelAddress(pMemoryMap, nRelAddress);
-
-    return mm.nFilePartNumber;
+    // Records edited in place are not detected; whoever edits them resets the index (resetMemoryIndex)
+    return (pMemoryMap->index.nNumberOfRecords != -1) && (pMemoryMap->index.nNumberOfRecords == pMemoryMap->listRecords.count());
 }
 
-bool XBinary::isAddressInHeader(_MEMORY_MAP *pMemoryMap, XADDR nAddress)
+qint32 XBinary::_findMemoryRecord(const _MEMORY_MAP *pMemoryMap, XADDR nValue, bool bAddress, MEMORY_LOOKUP lookup)
 {
-    bool bResult = false;
+    qint32 nResult = -1;
 
-    _MEMORY_RECORD mm = getMemoryRecordByAddress(pMemoryMap, nAddress);
+    qint32 nNumberOfRecords = pMemoryMap->listRecords.count();
 
-    if (mm.filePart == FILEPART_HEADER) {
-        bResult = true;
-    }
+    // The map is shared between threads and must not be changed here; without an index scan the records
+    if (!_isMemoryIndexValid(pMemoryMap)) {
+        bool bReverse = (lookup == MEMORY_LOOKUP_LASTMAPPED);
+        bool bMapped = (lookup != MEMORY_LOOKUP_FIRST);
 
-    return bResult;
-}
+        for (qint32 j = 0; j < nNumberOfRecords; j++) {
+            qint32 i = bReverse ? (nNumberOfRecords - 1 - j) : j;
 
-bool XBinary::isRelAddressInHeader(_MEMORY_MAP *pMemoryMap, qint64 nRelAddress)
-{
-    bool bResult = false;
+            const _MEMORY_RECORD &record = pMemoryMap->listRecords.at(i);
 
-    _MEMORY_RECORD mm = getMemoryRecordByRelAddress(pMemoryMap, nRelAddress);
+            if (record.nSize && ((!bMapped) || ((record.nOffset != -1) && (record.nAddress != (XADDR)-1)))) {
+                XADDR nStart = bAddress ? record.nAddress : (XADDR)record.nOffset;
 
-    if (mm.filePart == FILEPART_HEADER) {
-        bResult = true;
-    }
+                if ((nStart != (XADDR)-1) && (nStart <= nValue) && (nValue < nStart + record.nSize)) {
+                    nResult = i;
+                    break;
+                }
+            }
+        }
+    } else {
+        // Segment of the last hit of this thread; checked against the bounds before use, so it may come from another map
+        static thread_local qint32 _nLastOffsetSegment = -1;
+        static thread_local qint32 _nLastAddressSegment = -1;
 
-    return bResult;
-}
+        const _MEMORY_INDEX *pIndex = &(pMemoryMap->index);
 
-QString XBinary::getLoadSectionNameByOffset(_MEMORY_MAP *pMemoryMap, qint64 nOffset)
-{
-    QString sResult;
+        const QVector<_MEMORY_SEGMENT> *pListSegments = bAddress ? &(pIndex->listAddressSegments) : &(pIndex->listOffsetSegments);
+        qint32 *pnLastSegment = bAddress ? &_nLastAddressSegment : &_nLastOffsetSegment;
 
-    qint32 nNumberOfRecords = pMemoryMap->listRecords.count();
+        qint32 nNumberOfSegments = pListSegments->count();
+        qint32 nSegment = *pnLastSegment;
 
-    for (qint32 i = 0; i < nNumberOfRecords; i++) {
-        if (pMemoryMap->listRecords.at(i).nSize && (pMemoryMap->listRecords.at(i).nOffset != -1) && (pMemoryMap->listRecords.at(i).nAddress != (XADDR)-1)) {
-            if ((pMemoryMap->listRecords.at(i).nOffset <= nOffset) && (nOffset < pMemoryMap->listRecords.at(i).nOffset + pMemoryMap->listRecords.at(i).nSize)) {
-                sResult = pMemoryMap->listRecords.at(i).sName;
-                break;
+        // Lookups usually hit the same record several times in a row
+        if ((nSegment < 0) || (nSegment >= nNumberOfSegments) || (nValue < pListSegments->at(nSegment).nStart) || (nValue >= pListSegments->at(nSegment).nEnd)) {
+            nSegment = -1;
+
+            qint32 nLow = 0;
+            qint32 nHigh = nNumberOfSegments - 1;
+
+            while (nLow <= nHigh) {
+                qint32 nMiddle = nLow + (nHigh - nLow) / 2;
+
+                if (pListSegments->at(nMiddle).nStart <= nValue) {
+                    nSegment = nMiddle;
+                    nLow = nMiddle + 1;
+                } else {
+                    nHigh = nMiddle - 1;
+                }
+            }
+
+            if ((nSegment != -1) && (nValue >= pListSegments->at(nSegment).nEnd)) {
+                nSegment = -1;
+            }
+
+            if (nSegment != -1) {
+                *pnLastSegment = nSegment;
+            }
+        }
+
+        if (nSegment != -1) {
+            if (lookup == MEMORY_LOOKUP_FIRST) {
+                nResult = pListSegments->at(nSegment).nFirst;
+            } else if (lookup == MEMORY_LOOKUP_FIRSTMAPPED) {
+                nResult = pListSegments->at(nSegment).nFirstMapped;
+            } else if (lookup == MEMORY_LOOKUP_LASTMAPPED) {
+                nResult = pListSegments->at(nSegment).nLastMapped;
             }
         }
     }
 
-    return sResult;
+    return nResult;
 }
 
 bool XBinary::isSolidAddressRange(XBinary::_MEMORY_MAP *pMemoryMap, quint64 nAddress, qint64 nSize)
 {
     bool bResult = false;
 
-    qint32 nIndex1 = getMemoryRecordByAddress(pMemoryMap, nAddress).nIndex;
-    qint32 nIndex2 = getMemoryRecordByAddress(pMemoryMap, nAddress + nSize - 1).nIndex;
+    // Only the record indexes are compared; an address outside the map counts as index 0
+    qint32 nRecord1 = _findMemoryRecord(pMemoryMap, nAddress, true, MEMORY_LOOKUP_FIRST);
+    qint32 nRecord2 = _findMemoryRecord(pMemoryMap, nAddress + nSize - 1, true, MEMORY_LOOKUP_FIRST);
+
+    const _MEMORY_MAP_COMPACT *pCompact = _getCompactMemoryMap(pMemoryMap);
+
+    qint32 nIndex1 = 0;
+    qint32 nIndex2 = 0;
+
+    if (pCompact) {
+        nIndex1 = (nRecord1 != -1) ? pCompact->listIndexes.at(nRecord1) : 0;
+        nIndex2 = (nRecord2 != -1) ? pCompact->listIndexes.at(nRecord2) : 0;
+    } else {
+        nIndex1 = (nRecord1 != -1) ? pMemoryMap->listRecords.at(nRecord1).nIndex : 0;
+        nIndex2 = (nRecord2 != -1) ? pMemoryMap->listRecords.at(nRecord2).nIndex : 0;
+    }
 
     bResult = (nIndex1 == nIndex2);
 
@@ -7066,21 +9044,21 @@ bool XBinary::isSolidAddressRange(XBinary::_MEMORY_MAP *pMemoryMap, quint64 nAdd
 
 QString XBinary::getMemoryRecordInfoByOffset(qint64 nOffset)
 {
-    _MEMORY_MAP memoryMap = getMemoryMap();
+    _MEMORY_MAP memoryMap = getCachedMemoryMap();
 
     return getMemoryRecordInfoByOffset(&memoryMap, nOffset);
 }
 
 QString XBinary::getMemoryRecordInfoByAddress(XADDR nAddress)
 {
-    _MEMORY_MAP memoryMap = getMemoryMap();
+    _MEMORY_MAP memoryMap = getCachedMemoryMap();
 
     return getMemoryRecordInfoByAddress(&memoryMap, nAddress);
 }
 
 QString XBinary::getMemoryRecordInfoByRelAddress(qint64 nRelAddress)
 {
-    _MEMORY_MAP memoryMap = getMemoryMap();
+    _MEMORY_MAP memoryMap = getCachedMemoryMap();
 
     return getMemoryRecordInfoByRelAddress(&memoryMap, nRelAddress);
 }
@@ -7290,6 +9268,71 @@ QList<XBinary::MAPMODE> XBinary::getMapModesList()
     return listResult;
 }
 
+XBinary::_MEMORY_MAP XBinary::getCachedMemoryMap(MAPMODE mapMode, PDSTRUCT *pPdStruct)
+{
+    _MEMORY_MAP result = {};
+
+    bool bIsCached = false;
+
+    if (m_bMemoryMapCache) {
+        m_memoryMapCacheMutex.lock();
+
+        if (m_mapMemoryMapCache.contains(mapMode)) {
+            result = m_mapMemoryMapCache.value(mapMode);
+            bIsCached = true;
+        }
+
+        m_memoryMapCacheMutex.unlock();
+    }
+
+    if (!bIsCached) {
+        result = getMemoryMap(mapMode, pPdStruct);
+
+        // A canceled build may be incomplete
+        if (m_bMemoryMapCache && isPdStructNotCanceled(pPdStruct)) {
+            // Build the lookup index once, before the map is shared; copies share it
+            _prepareMemoryIndex(&result);
+
+            m_memoryMapCacheMutex.lock();
+            m_mapMemoryMapCache.insert(mapMode, result);
+            m_memoryMapCacheMutex.unlock();
+        }
+    }
+
+    return result;
+}
+
+void XBinary::setMemoryMapCacheEnabled(bool bState)
+{
+    m_bMemoryMapCache = bState;
+
+    if (!bState) {
+        resetMemoryMapCache();
+    }
+}
+
+bool XBinary::isMemoryMapCacheEnabled()
+{
+    return m_bMemoryMapCache;
+}
+
+void XBinary::setSearchThreads(qint32 nNumberOfThreads)
+{
+    m_nSearchThreads = nNumberOfThreads;
+}
+
+qint32 XBinary::getSearchThreads()
+{
+    return m_nSearchThreads;
+}
+
+void XBinary::resetMemoryMapCache()
+{
+    m_memoryMapCacheMutex.lock();
+    m_mapMemoryMapCache.clear();
+    m_memoryMapCacheMutex.unlock();
+}
+
 XBinary::_MEMORY_MAP XBinary::getMemoryMap(MAPMODE mapMode, PDSTRUCT *pPdStruct)
 {
     Q_UNUSED(mapMode)
@@ -7326,10 +9369,15 @@ qint32 XBinary::getNumberOfPhysicalRecords(XBinary::_MEMORY_MAP *pMemoryMap)
     qint32 nResult = 0;
 
     qint32 nNumberOfRecords = pMemoryMap->listRecords.count();
+    const _MEMORY_MAP_COMPACT *pCompact = _getCompactMemoryMap(pMemoryMap);
 
-    for (qint32 i = 0; i < nNumberOfRecords; i++) {
-        if (!pMemoryMap->listRecords.at(i).bIsVirtual) {
-            nResult++;
+    if (pCompact) {
+        nResult = nNumberOfRecords - pCompact->baIsVirtual.count(true);
+    } else {
+        for (qint32 i = 0; i < nNumberOfRecords; i++) {
+            if (!pMemoryMap->listRecords.at(i).bIsVirtual) {
+                nResult++;
+            }
         }
     }
 
@@ -7341,10 +9389,15 @@ qint32 XBinary::getNumberOfVirtualRecords(_MEMORY_MAP *pMemoryMap)
     qint32 nResult = 0;
 
     qint32 nNumberOfRecords = pMemoryMap->listRecords.count();
+    const _MEMORY_MAP_COMPACT *pCompact = _getCompactMemoryMap(pMemoryMap);
 
-    for (qint32 i = 0; i < nNumberOfRecords; i++) {
-        if (pMemoryMap->listRecords.at(i).bIsVirtual) {
-            nResult++;
+    if (pCompact) {
+        nResult = pCompact->baIsVirtual.count(true);
+    } else {
+        for (qint32 i = 0; i < nNumberOfRecords; i++) {
+            if (pMemoryMap->listRecords.at(i).bIsVirtual) {
+                nResult++;
+            }
         }
     }
 
@@ -7356,10 +9409,21 @@ qint32 XBinary::getNumberOfMemoryMapFileParts(_MEMORY_MAP *pMemoryMap, FILEPART
     qint32 nResult = 0;
 
     qint32 nNumberOfRecords = pMemoryMap->listRecords.count();
+    const _MEMORY_MAP_COMPACT *pCompact = _getCompactMemoryMap(pMemoryMap);
 
-    for (qint32 i = 0; i < nNumberOfRecords; i++) {
-        if ((pMemoryMap->listRecords.at(i).filePart == filePart) && (!pMemoryMap->listRecords.at(i).bIsVirtual)) {
-            nResult++;
+    if (pCompact) {
+        const quint32 *pFileParts = pCompact->listFileParts.constData();
+
+        for (qint32 i = 0; i < nNumberOfRecords; i++) {
+            if ((pFileParts[i] == (quint32)filePart) && (!pCompact->baIsVirtual.testBit(i))) {
+                nResult++;
+            }
+        }
+    } else {
+        for (qint32 i = 0; i < nNumberOfRecords; i++) {
+            if ((pMemoryMap->listRecords.at(i).filePart == filePart) && (!pMemoryMap->listRecords.at(i).bIsVirtual)) {
+                nResult++;
+            }
         }
     }
 
@@ -7371,10 +9435,21 @@ qint64 XBinary::getRecordsTotalRowSize(_MEMORY_MAP *pMemoryMap)
     qint64 nResult = 0;
 
     qint32 nNumberOfRecords = pMemoryMap->listRecords.count();
+    const _MEMORY_MAP_COMPACT *pCompact = _getCompactMemoryMap(pMemoryMap);
 
-    for (qint32 i = 0; i < nNumberOfRecords; i++) {
-        if (!pMemoryMap->listRecords.at(i).bIsVirtual) {
-            nResult += pMemoryMap->listRecords.at(i).nSize;
+    if (pCompact) {
+        const qint64 *pSizes = pCompact->listSizes.constData();
+
+        for (qint32 i = 0; i < nNumberOfRecords; i++) {
+            if (!pCompact->baIsVirtual.testBit(i)) {
+                nResult += pSizes[i];
+            }
+        }
+    } else {
+        for (qint32 i = 0; i < nNumberOfRecords; i++) {
+            if (!pMemoryMap->listRecords.at(i).bIsVirtual) {
+                nResult += pMemoryMap->listRecords.at(i).nSize;
+            }
         }
     }
 
@@ -7389,6 +9464,7 @@ XADDR XBinary::getBaseAddress()
 void XBinary::setBaseAddress(XADDR nBaseAddress)
 {
     this->m_nBaseAddress = nBaseAddress;
+    resetMemoryMapCache();
 }
 
 qint64 XBinary::getImageSize()
@@ -7404,6 +9480,7 @@ bool XBinary::isImage()
 void XBinary::setIsImage(bool bValue)
 {
     m_bIsImage = bValue;
+    resetMemoryMapCache();
 }
 
 void XBinary::setMultiSearchCallbackState(bool bState)
@@ -7413,27 +9490,30 @@ void XBinary::setMultiSearchCallbackState(bool bState)
 
 bool XBinary::compareSignature(const QString &sSignature, qint64 nOffset)
 {
-    _MEMORY_MAP memoryMap = getMemoryMap();
+    _MEMORY_MAP memoryMap = getCachedMemoryMap();
 
     return compareSignature(&memoryMap, sSignature, nOffset);
 }
 
 bool XBinary::compareSignature(_MEMORY_MAP *pMemoryMap, const QString &sSignature, qint64 nOffset, PDSTRUCT *pPdStruct)
 {
-    bool bResult = false;
-
-    QString sOrigin = sSignature;
-
-    QString _sSignature = convertSignature(sSignature);
+    return compareSignature(pMemoryMap, getCompiledSignature(sSignature), nOffset, pPdStruct);
+}
 
-    bool bValid = true;
+bool XBinary::compareSignature(_MEMORY_MAP *pMemoryMap, const COMPILED_SIGNATURE &compiledSignature, qint64 nOffset, PDSTRUCT *pPdStruct)
+{
+    bool bResult = false;
 
-    QList<SIGNATURE_RECORD> listSignatureRecords = getSignatureRecords(_sSignature, &bValid, pPdStruct);
+    if (compiledSignature.sInfoString.size()) {
+        setPdStructInfoString(pPdStruct, compiledSignature.sInfoString);
+    }
 
-    if (listSignatureRecords.count()) {
-        bResult = _compareSignature(pMemoryMap, &listSignatureRecords, nOffset, pPdStruct);
+    if (compiledSignature.bIsMasked) {
+        bResult = _compareMaskedSignature(compiledSignature, nOffset);
+    } else if (compiledSignature.listRecords.count()) {
+        bResult = _compareSignature(pMemoryMap, &(compiledSignature.listRecords), nOffset, pPdStruct);
     } else {
-        _errorMessage(QString("%1: %2").arg(tr("Invalid signature"), sOrigin));
+        _errorMessage(QString("%1: %2").arg(tr("Invalid signature"), compiledSignature.sSignature));
     }
 
     return bResult;
@@ -7484,7 +9564,7 @@ QString XBinary::_createSignature(const QString &sSignature1, const QString &sSi
 
 bool XBinary::compareSignatureOnAddress(const QString &sSignature, XADDR nAddress)
 {
-    XBinary::_MEMORY_MAP memoryMap = getMemoryMap();
+    XBinary::_MEMORY_MAP memoryMap = getCachedMemoryMap();
 
     return compareSignatureOnAddress(&memoryMap, sSignature, nAddress);
 }
@@ -7504,7 +9584,7 @@ bool XBinary::compareSignatureOnAddress(XBinary::_MEMORY_MAP *pMemoryMap, const
 
 qint64 XBinary::_getEntryPointOffset()
 {
-    XBinary::_MEMORY_MAP memoryMap = getMemoryMap();
+    XBinary::_MEMORY_MAP memoryMap = getCachedMemoryMap();
 
     return getEntryPointOffset(&memoryMap);
 }
@@ -7521,7 +9601,7 @@ void XBinary::setEntryPointOffset(qint64 nEntryPointOffset)
 
 XADDR XBinary::getEntryPointAddress()
 {
-    XBinary::_MEMORY_MAP memoryMap = getMemoryMap();
+    XBinary::_MEMORY_MAP memoryMap = getCachedMemoryMap();
 
     return getEntryPointAddress(&memoryMap);
 }
@@ -7538,7 +9618,7 @@ XADDR XBinary::_getEntryPointAddress()
 
 qint64 XBinary::getEntryPointRVA()
 {
-    XBinary::_MEMORY_MAP memoryMap = getMemoryMap();
+    XBinary::_MEMORY_MAP memoryMap = getCachedMemoryMap();
 
     return getEntryPointRVA(&memoryMap);
 }
@@ -7553,14 +9633,24 @@ XADDR XBinary::getLowestAddress(XBinary::_MEMORY_MAP *pMemoryMap)
     XADDR nResult = -1;
 
     qint32 nNumberOfRecords = pMemoryMap->listRecords.count();
+    const _MEMORY_MAP_COMPACT *pCompact = _getCompactMemoryMap(pMemoryMap);
 
-    for (qint32 i = 0; i < nNumberOfRecords; i++) {
-        if (pMemoryMap->listRecords.at(i).nAddress != (XADDR)-1) {
-            if (nResult == (XADDR)-1) {
-                nResult = pMemoryMap->listRecords.at(i).nAddress;
-            }
+    if (pCompact) {
+        // -1 is the largest XADDR, so records without an address never win
+        const XADDR *pAddresses = pCompact->listAddresses.constData();
+
+        for (qint32 i = 0; i < nNumberOfRecords; i++) {
+            nResult = qMin(pAddresses[i], nResult);
+        }
+    } else {
+        for (qint32 i = 0; i < nNumberOfRecords; i++) {
+            if (pMemoryMap->listRecords.at(i).nAddress != (XADDR)-1) {
+                if (nResult == (XADDR)-1) {
+                    nResult = pMemoryMap->listRecords.at(i).nAddress;
+                }
 
-            nResult = qMin(pMemoryMap->listRecords.at(i).nAddress, nResult);
+                nResult = qMin(pMemoryMap->listRecords.at(i).nAddress, nResult);
+            }
         }
     }
 
@@ -7572,11 +9662,24 @@ qint64 XBinary::getTotalVirtualSize(XBinary::_MEMORY_MAP *pMemoryMap)
     qint64 nResult = 0;
 
     qint32 nNumberOfRecords = pMemoryMap->listRecords.count();
+    const _MEMORY_MAP_COMPACT *pCompact = _getCompactMemoryMap(pMemoryMap);
 
-    for (qint32 i = 0; i < nNumberOfRecords; i++) {
-        if (pMemoryMap->listRecords.at(i).filePart != FILEPART_OVERLAY)  // TODO Check ELF, MachO -1
-        {
-            nResult += pMemoryMap->listRecords.at(i).nSize;
+    if (pCompact) {
+        const qint64 *pSizes = pCompact->listSizes.constData();
+        const quint32 *pFileParts = pCompact->listFileParts.constData();
+
+        for (qint32 i = 0; i < nNumberOfRecords; i++) {
+            if (pFileParts[i] != (quint32)FILEPART_OVERLAY)  // TODO Check ELF, MachO -1
+            {
+                nResult += pSizes[i];
+            }
+        }
+    } else {
+        for (qint32 i = 0; i < nNumberOfRecords; i++) {
+            if (pMemoryMap->listRecords.at(i).filePart != FILEPART_OVERLAY)  // TODO Check ELF, MachO -1
+            {
+                nResult += pMemoryMap->listRecords.at(i).nSize;
+            }
         }
     }
 
@@ -7605,6 +9708,7 @@ quint64 XBinary::positionToVirtualAddress(_MEMORY_MAP *pMemoryMap, qint64 nPosit
 void XBinary::setModuleAddress(quint64 nValue)
 {
     this->m_nModuleAddress = nValue;
+    resetMemoryMapCache();
 }
 
 XADDR XBinary::getModuleAddress()
@@ -7617,21 +9721,126 @@ XADDR XBinary::getModuleAddress()
         nResult = getBaseAddress();
     }
 
-    return nResult;
+    return nResult;
+}
+
+bool XBinary::compareEntryPoint(const QString &sSignature, qint64 nOffset)
+{
+    XBinary::_MEMORY_MAP memoryMap = getCachedMemoryMap();
+
+    return compareEntryPoint(&memoryMap, sSignature, nOffset);
+}
+
+bool XBinary::compareEntryPoint(XBinary::_MEMORY_MAP *pMemoryMap, const QString &sSignature, qint64 nOffset)
+{
+    qint64 nEPOffset = getEntryPointOffset(pMemoryMap) + nOffset;
+
+    return compareSignature(pMemoryMap, sSignature, nEPOffset);
+}
+
+bool XBinary::compareEntryPoint(XBinary::_MEMORY_MAP *pMemoryMap, const COMPILED_SIGNATURE &compiledSignature, qint64 nOffset)
+{
+    qint64 nEPOffset = getEntryPointOffset(pMemoryMap) + nOffset;
+
+    return compareSignature(pMemoryMap, compiledSignature, nEPOffset);
+}
+
+static void _x_getSignatureSpans(const QList<XBinary::SIGNATURE_RECORD> &listRecords, qint64 *pnHeadSize, qint64 *pnJumpSize)
+{
+    // Head: bytes from the start up to and including the first jump operand. Jump: the widest run after a jump.
+    bool bIsHead = true;
+    qint64 nCurrent = 0;
+    qint32 nNumberOfRecords = listRecords.count();
+
+    for (qint32 i = 0; i < nNumberOfRecords; i++) {
+        const XBinary::SIGNATURE_RECORD &record = listRecords.at(i);
+
+        if (record.st == XBinary::ST_COMPAREBYTES) {
+            nCurrent += record.baData.size();
+        } else if (record.st == XBinary::ST_FINDBYTES) {
+            nCurrent += record.nFindDelta + record.baData.size();
+        } else if ((record.st == XBinary::ST_RELOFFSET) || (record.st == XBinary::ST_ADDRESS)) {
+            nCurrent += record.nSizeOfAddr;
+        } else {
+            nCurrent += record.nWindowSize;
+        }
+
+        if ((record.st == XBinary::ST_RELOFFSET) || (record.st == XBinary::ST_ADDRESS) || (i == nNumberOfRecords - 1)) {
+            if (bIsHead) {
+                *pnHeadSize = qMax(*pnHeadSize, nCurrent);
+                bIsHead = false;
+            } else {
+                *pnJumpSize = qMax(*pnJumpSize, nCurrent);
+            }
+
+            nCurrent = 0;
+        }
+    }
+}
+
+QBitArray XBinary::compareEntryPoints(_MEMORY_MAP *pMemoryMap, const QList<COMPILED_SIGNATURE> &listSignatures, qint64 nOffset, PDSTRUCT *pPdStruct)
+{
+    PDSTRUCT pdStructEmpty = XBinary::createPdStruct();
+
+    if (!pPdStruct) {
+        pPdStruct = &pdStructEmpty;
+    }
+
+    qint32 nNumberOfSignatures = listSignatures.count();
+
+    QBitArray baResult(nNumberOfSignatures);
+
+    if (nNumberOfSignatures) {
+        qint64 nEPOffset = getEntryPointOffset(pMemoryMap) + nOffset;
+
+        qint64 nHeadSize = 0;
+        qint64 nJumpSize = 0;
+
+        for (qint32 i = 0; i < nNumberOfSignatures; i++) {
+            _x_getSignatureSpans(listSignatures.at(i).listRecords, &nHeadSize, &nJumpSize);
+        }
+
+        SIGNATURE_WINDOWS windows = {};
+
+        // One read covers every signature at the entry point; jump targets get windows wide enough for any signature tail
+        if (nHeadSize > 0) {
+            windows.nReadSize = nHeadSize;
+            _getSignatureWindowData(&windows, nEPOffset, 1);
+        }
+
+        windows.nReadSize = nJumpSize;
+
+        for (qint32 i = 0; (i < nNumberOfSignatures) && isPdStructNotCanceled(pPdStruct); i++) {
+            const COMPILED_SIGNATURE &compiledSignature = listSignatures.at(i);
+
+            bool bResult = false;
+
+            if (compiledSignature.bIsMasked) {
+                bResult = _compareMaskedSignature(compiledSignature, nEPOffset, &windows);
+            } else if (compiledSignature.listRecords.count()) {
+                bResult = _compareSignature(pMemoryMap, &(compiledSignature.listRecords), nEPOffset, pPdStruct, &windows);
+            } else {
+                _errorMessage(QString("%1: %2").arg(tr("Invalid signature"), compiledSignature.sSignature));
+            }
+
+            baResult.setBit(i, bResult);
+        }
+    }
+
+    return baResult;
 }
 
-bool XBinary::compareEntryPoint(const QString &sSignature, qint64 nOffset)
+QBitArray XBinary::compareEntryPoints(_MEMORY_MAP *pMemoryMap, const QList<QString> &listSignatures, qint64 nOffset, PDSTRUCT *pPdStruct)
 {
-    XBinary::_MEMORY_MAP memoryMap = getMemoryMap();
+    QList<COMPILED_SIGNATURE> listCompiled;
 
-    return compareEntryPoint(&memoryMap, sSignature, nOffset);
-}
+    qint32 nNumberOfSignatures = listSignatures.count();
 
-bool XBinary::compareEntryPoint(XBinary::_MEMORY_MAP *pMemoryMap, const QString &sSignature, qint64 nOffset)
-{
-    qint64 nEPOffset = getEntryPointOffset(pMemoryMap) + nOffset;
+    for (qint32 i = 0; i < nNumberOfSignatures; i++) {
+        listCompiled.append(getCompiledSignature(listSignatures.at(i)));
+    }
 
-    return compareSignature(pMemoryMap, sSignature, nEPOffset);
+    return compareEntryPoints(pMemoryMap, listCompiled, nOffset, pPdStruct);
 }
 
 bool XBinary::moveMemory(qint64 nSourceOffset, qint64 nDestOffset, qint64 nSize)
@@ -7835,6 +10044,196 @@ bool XBinary::patchFromFile(const QString &sFileName, qint64 nDataOffset, qint64
     return bResult;
 }
 
+// Checks done after the signature matched
+enum XMAGIC_CHECK {
+    XMAGIC_CHECK_NONE = 0,
+    XMAGIC_CHECK_TAR,   // Needs a whole header block
+    XMAGIC_CHECK_DER,   // ASN.1 length and OID tag
+    XMAGIC_CHECK_RIFF,  // Subtype at offset 8
+};
+
+struct XMAGIC_RECORD {
+    XBinary::FT fileTypeGroup;  // FT_UNKNOWN if none
+    XBinary::FT fileType;
+    qint64 nOffset;  // Negative: from the end of the file
+    const char *pszSignature;
+    XMAGIC_CHECK check;
+};
+
+// Order matters: the first matching record wins
+static const XMAGIC_RECORD _TABLE_XBINARY_MAGIC[] = {
+    {XBinary::FT_ARCHIVE, XBinary::FT_ZIP, 0, "'PK'0304", XMAGIC_CHECK_NONE},
+    {XBinary::FT_ARCHIVE, XBinary::FT_ZIP, 0, "'PK'0506", XMAGIC_CHECK_NONE},
+    {XBinary::FT_ARCHIVE, XBinary::FT_GZIP, 0, "1F8B08", XMAGIC_CHECK_NONE},
+    {XBinary::FT_ARCHIVE, XBinary::FT_ZLIB, 0, "7801", XMAGIC_CHECK_NONE},
+    {XBinary::FT_ARCHIVE, XBinary::FT_ZLIB, 0, "785E", XMAGIC_CHECK_NONE},
+    {XBinary::FT_ARCHIVE, XBinary::FT_ZLIB, 0, "789C", XMAGIC_CHECK_NONE},
+    {XBinary::FT_ARCHIVE, XBinary::FT_ZLIB, 0, "78DA", XMAGIC_CHECK_NONE},
+    {XBinary::FT_ARCHIVE, XBinary::FT_LHA, 0, "....'-lh'..2d", XMAGIC_CHECK_NONE},
+    {XBinary::FT_ARCHIVE, XBinary::FT_LHA, 0, "....'-lz'..2d", XMAGIC_CHECK_NONE},
+    {XBinary::FT_ARCHIVE, XBinary::FT_LHA, 0, "....'-pm'..2d", XMAGIC_CHECK_NONE},
+    {XBinary::FT_ARCHIVE, XBinary::FT_AR, 0, "'!<arch>'0a", XMAGIC_CHECK_NONE},  // TODO DEB
+    {XBinary::FT_ARCHIVE, XBinary::FT_TAR, 0x100, "00'ustar'", XMAGIC_CHECK_TAR},
+    {XBinary::FT_ARCHIVE, XBinary::FT_RAR, 0, "'RE~^'", XMAGIC_CHECK_NONE},
+    {XBinary::FT_ARCHIVE, XBinary::FT_RAR, 0, "'Rar!'1A07", XMAGIC_CHECK_NONE},
+    {XBinary::FT_ARCHIVE, XBinary::FT_CAB, 0, "'MSCF'00000000", XMAGIC_CHECK_NONE},
+    {XBinary::FT_ARCHIVE, XBinary::FT_7Z, 0, "'7z'BCAF271C", XMAGIC_CHECK_NONE},
+    {XBinary::FT_ARCHIVE, XBinary::FT_LZIP, 0, "'LZIP'", XMAGIC_CHECK_NONE},
+    {XBinary::FT_ARCHIVE, XBinary::FT_CPIO, 0, "303730373031", XMAGIC_CHECK_NONE},  // 070701
+    {XBinary::FT_ARCHIVE, XBinary::FT_CPIO, 0, "303730373032", XMAGIC_CHECK_NONE},  // 070702
+    {XBinary::FT_ARCHIVE, XBinary::FT_CPIO, 0, "303730373037", XMAGIC_CHECK_NONE},  // 070707
+    {XBinary::FT_ARCHIVE, XBinary::FT_MINIDUMP, 0, "'MDMP'", XMAGIC_CHECK_NONE},
+    {XBinary::FT_ARCHIVE, XBinary::FT_DMG, -512, "'koly'", XMAGIC_CHECK_NONE},  // koly block at the end
+    {XBinary::FT_IMAGE, XBinary::FT_PNG, 0, "89'PNG\r\n'1A0A", XMAGIC_CHECK_NONE},
+    {XBinary::FT_IMAGE, XBinary::FT_JPEG, 0, "FFD8FFE0....'JFIF'00", XMAGIC_CHECK_NONE},
+    {XBinary::FT_IMAGE, XBinary::FT_JPEG, 0, "FFD8FFE1....'Exif'00", XMAGIC_CHECK_NONE},
+    {XBinary::FT_IMAGE, XBinary::FT_JPEG, 0, "FFD8FFDB", XMAGIC_CHECK_NONE},
+    {XBinary::FT_IMAGE, XBinary::FT_GIF, 0, "'GIF87a'", XMAGIC_CHECK_NONE},
+    {XBinary::FT_IMAGE, XBinary::FT_GIF, 0, "'GIF89a'", XMAGIC_CHECK_NONE},
+    {XBinary::FT_IMAGE, XBinary::FT_BMP, 0, "'BM'..................000000", XMAGIC_CHECK_NONE},
+    {XBinary::FT_IMAGE, XBinary::FT_TIFF, 0, "'MM'002A", XMAGIC_CHECK_NONE},
+    {XBinary::FT_IMAGE, XBinary::FT_TIFF, 0, "'II'2A00", XMAGIC_CHECK_NONE},
+    {XBinary::FT_IMAGE, XBinary::FT_ICO, 0, "00000100", XMAGIC_CHECK_NONE},
+    {XBinary::FT_IMAGE, XBinary::FT_CUR, 0, "00000200", XMAGIC_CHECK_NONE},
+    {XBinary::FT_IMAGE, XBinary::FT_ICC, 0, "........................'mntr'", XMAGIC_CHECK_NONE},
+    {XBinary::FT_ARCHIVE, XBinary::FT_ISO9660, 0x8001, "4344303031", XMAGIC_CHECK_NONE},  // "CD001"
+    {XBinary::FT_ARCHIVE, XBinary::FT_UDF, 256 * 2048, "0002", XMAGIC_CHECK_NONE},     // Anchor at sector 256
+    {XBinary::FT_AUDIO, XBinary::FT_MP3, 0, "'ID3'..00", XMAGIC_CHECK_NONE},
+    {XBinary::FT_VIDEO, XBinary::FT_MP4, 0, "000000..'ftyp'", XMAGIC_CHECK_NONE},
+    {XBinary::FT_AUDIO, XBinary::FT_XM, 0, "'Extended Module'", XMAGIC_CHECK_NONE},
+    {XBinary::FT_UNKNOWN, XBinary::FT_DEX, 0, "'dex\n'......00", XMAGIC_CHECK_NONE},
+    {XBinary::FT_UNKNOWN, XBinary::FT_ANDROIDXML, 0, "00000800........0100", XMAGIC_CHECK_NONE},
+    {XBinary::FT_UNKNOWN, XBinary::FT_ANDROIDXML, 0, "03000800........0100", XMAGIC_CHECK_NONE},
+    {XBinary::FT_UNKNOWN, XBinary::FT_ANDROIDASRC, 0, "02000C00........0100", XMAGIC_CHECK_NONE},
+    {XBinary::FT_DOCUMENT, XBinary::FT_PDF, 0, "'%PDF'", XMAGIC_CHECK_NONE},
+    {XBinary::FT_DOCUMENT, XBinary::FT_DER, 0, "30", XMAGIC_CHECK_DER},
+    {XBinary::FT_UNKNOWN, XBinary::FT_RIFF, 0, "'RIFF'", XMAGIC_CHECK_RIFF},  // TODO AIFF
+    {XBinary::FT_UNKNOWN, XBinary::FT_RIFF, 0, "'RIFX'", XMAGIC_CHECK_RIFF},
+    {XBinary::FT_UNKNOWN, XBinary::FT_BWDOS16M, 0, "'BW'....00..00000000", XMAGIC_CHECK_NONE},
+    {XBinary::FT_UNKNOWN, XBinary::FT_CFBF, 0, "D0CF11E0A1B11AE1", XMAGIC_CHECK_NONE},
+    {XBinary::FT_UNKNOWN, XBinary::FT_TTF, 0, "'OTTO'00", XMAGIC_CHECK_NONE},
+    {XBinary::FT_UNKNOWN, XBinary::FT_TTF, 0, "0001000000", XMAGIC_CHECK_NONE},
+    {XBinary::FT_UNKNOWN, XBinary::FT_DJVU, 0, "'AT&TFORM'", XMAGIC_CHECK_NONE},
+    {XBinary::FT_UNKNOWN, XBinary::FT_DJVU, 0, "'SDJVFORM'", XMAGIC_CHECK_NONE},
+    {XBinary::FT_ARCHIVE, XBinary::FT_SZDD, 0, "'SZDD'88F027'3A'", XMAGIC_CHECK_NONE},
+    {XBinary::FT_ARCHIVE, XBinary::FT_BZIP2, 0, "'BZh'..314159265359", XMAGIC_CHECK_NONE},
+    {XBinary::FT_ARCHIVE, XBinary::FT_BZIP2, 0, "'BZh'..17724538509000000000", XMAGIC_CHECK_NONE},
+    {XBinary::FT_ARCHIVE, XBinary::FT_XZ, 0, "FD'7zXZ'00", XMAGIC_CHECK_NONE},
+};
+
+struct XMAGIC_COMPILED {
+    QByteArray baSignature;
+    QByteArray baMask;  // 0xFF: compare the byte, 0x00: any byte
+};
+
+struct XMAGIC_DISPATCH {
+    QVector<XMAGIC_COMPILED> listRecords;
+    QVector<qint32> listCandidates[256];  // Records that can match a file with this first byte
+};
+
+static quint8 _x_hexToNibble(char cSymbol)
+{
+    quint8 nResult = 0;
+
+    if ((cSymbol >= '0') && (cSymbol <= '9')) {
+        nResult = cSymbol - '0';
+    } else if ((cSymbol >= 'A') && (cSymbol <= 'F')) {
+        nResult = cSymbol - 'A' + 10;
+    } else if ((cSymbol >= 'a') && (cSymbol <= 'f')) {
+        nResult = cSymbol - 'a' + 10;
+    }
+
+    return nResult;
+}
+
+// Same syntax as compareSignature(): hex bytes, '..' for any byte, quoted text
+static XMAGIC_COMPILED _x_compileMagic(const char *pszSignature)
+{
+    XMAGIC_COMPILED result;
+
+    const char *pCurrent = pszSignature;
+
+    while (*pCurrent) {
+        if (*pCurrent == '\'') {
+            pCurrent++;
+
+            while (*pCurrent && (*pCurrent != '\'')) {
+                result.baSignature.append(*pCurrent);
+                result.baMask.append((char)0xFF);
+                pCurrent++;
+            }
+
+            if (*pCurrent) {
+                pCurrent++;
+            }
+        } else if (pCurrent[1]) {
+            if (*pCurrent == '.') {
+                result.baSignature.append((char)0);
+                result.baMask.append((char)0);
+            } else {
+                result.baSignature.append((char)((_x_hexToNibble(pCurrent[0]) << 4) | _x_hexToNibble(pCurrent[1])));
+                result.baMask.append((char)0xFF);
+            }
+
+            pCurrent += 2;
+        } else {
+            break;
+        }
+    }
+
+    return result;
+}
+
+static XMAGIC_DISPATCH _x_createMagicDispatch()
+{
+    XMAGIC_DISPATCH result;
+
+    qint32 nNumberOfRecords = sizeof(_TABLE_XBINARY_MAGIC) / sizeof(XMAGIC_RECORD);
+
+    for (qint32 i = 0; i < nNumberOfRecords; i++) {
+        XMAGIC_COMPILED compiled = _x_compileMagic(_TABLE_XBINARY_MAGIC[i].pszSignature);
+
+        result.listRecords.append(compiled);
+
+        if ((_TABLE_XBINARY_MAGIC[i].nOffset == 0) && (!compiled.baMask.isEmpty()) && (compiled.baMask.at(0) != 0)) {
+            result.listCandidates[(quint8)compiled.baSignature.at(0)].append(i);
+        } else {
+            // The first byte of the file is not fixed by this record
+            for (qint32 j = 0; j < 256; j++) {
+                result.listCandidates[j].append(i);
+            }
+        }
+    }
+
+    return result;
+}
+
+static const XMAGIC_DISPATCH *_x_getMagicDispatch()
+{
+    // Built on the first call; C++11 makes the initialization thread-safe
+    static const XMAGIC_DISPATCH dispatch = _x_createMagicDispatch();
+
+    return &dispatch;
+}
+
+static bool _x_compareMagic(const char *pData, const XMAGIC_COMPILED *pCompiled)
+{
+    bool bResult = true;
+
+    qint32 nSize = pCompiled->baSignature.size();
+    const char *pSignature = pCompiled->baSignature.constData();
+    const char *pMask = pCompiled->baMask.constData();
+
+    for (qint32 i = 0; i < nSize; i++) {
+        if ((pData[i] ^ pSignature[i]) & pMask[i]) {
+            bResult = false;
+            break;
+        }
+    }
+
+    return bResult;
+}
+
 QSet<XBinary::FT> XBinary::getFileTypes(bool bExtra)
 {
     QSet<XBinary::FT> stResult;
@@ -7862,7 +10261,7 @@ QSet<XBinary::FT> XBinary::getFileTypes(bool bExtra)
             {
                 pOffset += nLfanew;
                 bIsNewHeaderValid = true;
-            } else {
+            } else if (isReadBudgetAvailable(FT_PE)) {
                 qint64 nNtHeadersSize = 4 + sizeof(XPE_DEF::IMAGE_FILE_HEADER);
 
                 baNewHeader = read_array(nLfanew, nNtHeadersSize);
@@ -7914,7 +10313,8 @@ QSet<XBinary::FT> XBinary::getFileTypes(bool bExtra)
                         bool bBW = false;
                         bool b16M = false;
                         bool b4G = false;
-                        while (true) {
+                        // Extender headers are chained by file offsets; a corrupted chain is only bounded by the read budget
+                        while (isReadBudgetAvailable(FT_DOS16M)) {
                             quint16 nSignature = read_uint16(nSignatureOffset);
 
                             if (nSignature == 0x5742) {  // BW
@@ -8024,167 +10424,111 @@ QSet<XBinary::FT> XBinary::getFileTypes(bool bExtra)
     }
 
     if ((!bAllFound) && bExtra) {
-        _MEMORY_MAP memoryMap = XBinary::getSimpleMemoryMap();
         UNICODE_TYPE unicodeType = getUnicodeType(&baHeader);
 
-        bAllFound = true;
+        // Only the records that can match the first byte are tried; most of them are checked in baHeader
+        const XMAGIC_DISPATCH *pDispatch = _x_getMagicDispatch();
+        quint8 nFirstByte = baHeader.size() ? (quint8)baHeader.at(0) : 0;
+        const QVector<qint32> *pListCandidates = &(pDispatch->listCandidates[nFirstByte]);
 
-        if (compareSignature(&memoryMap, "'PK'0304", 0) || compareSignature(&memoryMap, "'PK'0506", 0))  // TODO baHeader
-        {
-            stResult.insert(FT_ARCHIVE);
-            stResult.insert(FT_ZIP);
-            // TODO Check APK, JAR
-            // TODO basic ZIP
-        } else if (compareSignature(&memoryMap, "1F8B08")) {
-            stResult.insert(FT_ARCHIVE);
-            stResult.insert(FT_GZIP);
-        } else if (compareSignature(&memoryMap, "7801") || compareSignature(&memoryMap, "785E") || compareSignature(&memoryMap, "789C") ||
-                   compareSignature(&memoryMap, "78DA")) {
-            stResult.insert(FT_ARCHIVE);
-            stResult.insert(FT_ZLIB);
-        } else if (compareSignature(&memoryMap, "....'-lh'..2d") || compareSignature(&memoryMap, "....'-lz'..2d") || compareSignature(&memoryMap, "....'-pm'..2d")) {
-            stResult.insert(FT_ARCHIVE);
-            stResult.insert(FT_LHA);
-        } else if (compareSignature(&memoryMap, "'!<arch>'0a")) {
-            stResult.insert(FT_ARCHIVE);
-            stResult.insert(FT_AR);
-            // TODO DEB
-        } else if ((memoryMap.nBinarySize >= 0x200) && compareSignature(&memoryMap, "00'ustar'", 0x100)) {
-            stResult.insert(FT_ARCHIVE);
-            stResult.insert(FT_TAR);
-        } else if (compareSignature(&memoryMap, "'RE~^'") || compareSignature(&memoryMap, "'Rar!'1A07")) {
-            stResult.insert(FT_ARCHIVE);
-            stResult.insert(FT_RAR);
-        } else if (compareSignature(&memoryMap, "'MSCF'00000000", 0)) {
-            stResult.insert(FT_ARCHIVE);
-            stResult.insert(FT_CAB);
-        } else if (compareSignature(&memoryMap, "'7z'BCAF271C", 0)) {
-            stResult.insert(FT_ARCHIVE);
-            stResult.insert(FT_7Z);
-        } else if (compareSignature(&memoryMap, "'LZIP'", 0)) {
-            stResult.insert(FT_ARCHIVE);
-            stResult.insert(FT_LZIP);
-        } else if (compareSignature(&memoryMap, "303730373031", 0) || compareSignature(&memoryMap, "303730373032", 0) ||
-                   compareSignature(&memoryMap, "303730373037", 0)) {
-            // CPIO formats: 070701, 070702, 070707
-            stResult.insert(FT_ARCHIVE);
-            stResult.insert(FT_CPIO);
-        } else if (compareSignature(&memoryMap, "'MDMP'", 0)) {
-            // Windows MiniDump format
-            stResult.insert(FT_ARCHIVE);
-            stResult.insert(FT_MINIDUMP);
-        } else if (compareSignature(&memoryMap, "'koly'", nSize - 512)) {
-            // Apple Disk Image format (koly block at end)
-            stResult.insert(FT_ARCHIVE);
-            stResult.insert(FT_DMG);
-        } else if (compareSignature(&memoryMap, "89'PNG\r\n'1A0A", 0)) {
-            stResult.insert(FT_IMAGE);
-            stResult.insert(FT_PNG);
-        } else if (compareSignature(&memoryMap, "FFD8FFE0....'JFIF'00", 0) || compareSignature(&memoryMap, "FFD8FFE1....'Exif'00", 0) ||
-                   compareSignature(&memoryMap, "FFD8FFDB", 0)) {
-            stResult.insert(FT_IMAGE);
-            stResult.insert(FT_JPEG);
-        } else if (compareSignature(&memoryMap, "'GIF87a'", 0) || compareSignature(&memoryMap, "'GIF89a'", 0)) {
-            stResult.insert(FT_IMAGE);
-            stResult.insert(FT_GIF);
-        } else if (compareSignature(&memoryMap, "'BM'..................000000", 0)) {
-            stResult.insert(FT_IMAGE);
-            stResult.insert(FT_BMP);
-        } else if (compareSignature(&memoryMap, "'MM'002A", 0) || compareSignature(&memoryMap, "'II'2A00", 0)) {
-            stResult.insert(FT_IMAGE);
-            stResult.insert(FT_TIFF);
-        } else if (compareSignature(&memoryMap, "00000100", 0)) {
-            stResult.insert(FT_IMAGE);
-            stResult.insert(FT_ICO);
-        } else if (compareSignature(&memoryMap, "00000200", 0)) {
-            stResult.insert(FT_IMAGE);
-            stResult.insert(FT_CUR);
-        } else if (compareSignature(&memoryMap, "........................'mntr'", 0)) {
-            stResult.insert(FT_IMAGE);
-            stResult.insert(FT_ICC);
-        } else if (compareSignature(&memoryMap, "4344303031", 0x8001, 0)) {  // "CD001" at offset 0x8001
-            stResult.insert(FT_ARCHIVE);
-            stResult.insert(FT_ISO9660);
-        } else if (compareSignature(&memoryMap, "0002", 256 * 2048, 0)) {  // UDF Anchor at sector 256
-            stResult.insert(FT_ARCHIVE);
-            stResult.insert(FT_UDF);
-        } else if (compareSignature(&memoryMap, "'ID3'..00", 0)) {
-            stResult.insert(FT_AUDIO);
-            stResult.insert(FT_MP3);
-        } else if (compareSignature(&memoryMap, "000000..'ftyp'", 0)) {
-            stResult.insert(FT_VIDEO);
-            stResult.insert(FT_MP4);
-        } else if (compareSignature(&memoryMap, "'Extended Module'", 0)) {
-            stResult.insert(FT_AUDIO);
-            stResult.insert(FT_XM);
-        } else if (compareSignature(&memoryMap, "'dex\n'......00")) {
-            stResult.insert(FT_DEX);
-        } else if (compareSignature(&memoryMap, "00000800........0100") || compareSignature(&memoryMap, "03000800........0100")) {
-            stResult.insert(FT_ANDROIDXML);
-        } else if (compareSignature(&memoryMap, "02000C00........0100")) {
-            stResult.insert(FT_ANDROIDASRC);
-        } else if (compareSignature(&memoryMap, "'%PDF'", 0)) {
-            stResult.insert(FT_DOCUMENT);
-            stResult.insert(FT_PDF);
-        } else if ((compareSignature(&memoryMap, "30", 0)) && (nSize >= 4)) {
-            // Minimal DER/ASN.1 check: first byte is a tag, second is definite length short form (<0x80)
-            // or long form (>=0x80) followed by that many length bytes; ensure it fits into the file.
-            // quint8 nTag = _read_uint8(pOffset);
-            PACKED_UINT packedLen = _read_acn1_integer(pOffset + 1, nSize - 1);
-
-            if ((packedLen.bIsValid) && (packedLen.nByteSize > 0) && (1 + packedLen.nByteSize + packedLen.nValue <= (quint64)nSize)) {
-                bool bDer = false;
-
-                if (_read_uint8(pOffset + 1 + packedLen.nByteSize) == 0x06) {
-                    // OID
-                    bDer = true;
+        qint32 nNumberOfCandidates = pListCandidates->count();
+
+        for (qint32 i = 0; i < nNumberOfCandidates; i++) {
+            qint32 nRecord = pListCandidates->at(i);
+            const XMAGIC_RECORD *pRecord = &(_TABLE_XBINARY_MAGIC[nRecord]);
+            const XMAGIC_COMPILED *pCompiled = &(pDispatch->listRecords.at(nRecord));
+
+            qint64 nSignatureOffset = (pRecord->nOffset >= 0) ? pRecord->nOffset : (nSize + pRecord->nOffset);
+            qint64 nSignatureSize = pCompiled->baSignature.size();
+
+            if ((nSignatureOffset < 0) || (nSignatureOffset + nSignatureSize > nSize)) {
+                continue;
+            }
+
+            if ((pRecord->check == XMAGIC_CHECK_TAR) && (nSize < 0x200)) {
+                continue;
+            }
+
+            if ((pRecord->check == XMAGIC_CHECK_DER) && (nSize < 4)) {
+                continue;
+            }
+
+            QByteArray baSignatureData;
+            const char *pSignatureData = nullptr;
+
+            if (nSignatureOffset + nSignatureSize <= baHeader.size()) {
+                pSignatureData = baHeader.constData() + nSignatureOffset;
+            } else {
+                if (!isReadBudgetAvailable(pRecord->fileType)) {
+                    continue;
                 }
 
-                if (bDer) {
-                    stResult.insert(FT_DOCUMENT);
-                    stResult.insert(FT_DER);
-                } else {
-                    bAllFound = false;
+                baSignatureData = read_array(nSignatureOffset, nSignatureSize);
+
+                if (baSignatureData.size() != nSignatureSize) {
+                    continue;
+                }
+
+                pSignatureData = baSignatureData.constData();
+            }
+
+            if (!_x_compareMagic(pSignatureData, pCompiled)) {
+                continue;
+            }
+
+            bAllFound = true;
+
+            if (pRecord->check == XMAGIC_CHECK_DER) {
+                // Minimal DER/ASN.1 check: first byte is a tag, second is definite length short form (<0x80)
+                // or long form (>=0x80) followed by that many length bytes; ensure it fits into the file.
+                // quint8 nTag = _read_uint8(pOffset);
+                PACKED_UINT packedLen = _read_acn1_integer(pOffset + 1, nSize - 1);
+
+                if ((packedLen.bIsValid) && (packedLen.nByteSize > 0) && (1 + packedLen.nByteSize + packedLen.nValue <= (quint64)nSize)) {
+                    bool bDer = false;
+
+                    if (_read_uint8(pOffset + 1 + packedLen.nByteSize) == 0x06) {
+                        // OID
+                        bDer = true;
+                    }
+
+                    if (bDer) {
+                        stResult.insert(pRecord->fileTypeGroup);
+                        stResult.insert(pRecord->fileType);
+                    } else {
+                        bAllFound = false;
+                    }
+                }
+            } else {
+                if (pRecord->fileTypeGroup != FT_UNKNOWN) {
+                    stResult.insert(pRecord->fileTypeGroup);
                 }
+
+                stResult.insert(pRecord->fileType);
             }
-        } else if (compareSignature(&memoryMap, "'RIFF'", 0) || compareSignature(&memoryMap, "'RIFX'", 0)) {
-            // TODO AIFF
-            stResult.insert(FT_RIFF);
-            if (compareSignature(&memoryMap, "'RIFF'........'AVI '", 0)) {
-                stResult.insert(FT_VIDEO);
-                stResult.insert(FT_AVI);
-            } else if (compareSignature(&memoryMap, "'RIFF'........'WEBPVP8'", 0)) {
-                stResult.insert(FT_IMAGE);
-                stResult.insert(FT_WEBP);
-            } else if (compareSignature(&memoryMap, "'RIFF'........'WAVE'", 0)) {
-                stResult.insert(FT_AUDIO);
-                stResult.insert(FT_WAV);
-            } /*else if (compareSignature(&memoryMap, "'RIFF'........'ACON'", 0)) {
-                stResult.insert(FT_IMAGE);
-                stResult.insert(FT_ANI);
-            }*/
-        } else if (compareSignature(&memoryMap, "'BW'....00..00000000", 0)) {
-            stResult.insert(FT_BWDOS16M);
-        } else if (compareSignature(&memoryMap, "D0CF11E0A1B11AE1", 0)) {
-            stResult.insert(FT_CFBF);
-        } else if (compareSignature(&memoryMap, "'OTTO'00", 0) || compareSignature(&memoryMap, "0001000000", 0)) {
-            stResult.insert(FT_TTF);
-        } else if (compareSignature(&memoryMap, "'AT&TFORM'", 0) || compareSignature(&memoryMap, "'SDJVFORM'", 0)) {
-            stResult.insert(FT_DJVU);
-        } else if (compareSignature(&memoryMap, "'SZDD'88F027'3A'", 0)) {
-            stResult.insert(FT_ARCHIVE);
-            stResult.insert(FT_SZDD);
-        } else if (compareSignature(&memoryMap, "'BZh'..314159265359", 0) || compareSignature(&memoryMap, "'BZh'..17724538509000000000")) {
-            stResult.insert(FT_ARCHIVE);
-            stResult.insert(FT_BZIP2);
-        } else if (compareSignature(&memoryMap, "FD'7zXZ'00", 0)) {
-            stResult.insert(FT_ARCHIVE);
-            stResult.insert(FT_XZ);
-        } else {
-            bAllFound = false;
+
+            if ((pRecord->check == XMAGIC_CHECK_RIFF) && (baHeader.size() >= 12) && baHeader.startsWith("RIFF")) {
+                const char *pSubType = baHeader.constData() + 8;
+
+                if (memcmp(pSubType, "AVI ", 4) == 0) {
+                    stResult.insert(FT_VIDEO);
+                    stResult.insert(FT_AVI);
+                } else if ((baHeader.size() >= 15) && (memcmp(pSubType, "WEBPVP8", 7) == 0)) {
+                    stResult.insert(FT_IMAGE);
+                    stResult.insert(FT_WEBP);
+                } else if (memcmp(pSubType, "WAVE", 4) == 0) {
+                    stResult.insert(FT_AUDIO);
+                    stResult.insert(FT_WAV);
+                } /*else if (memcmp(pSubType, "ACON", 4) == 0) {
+                    stResult.insert(FT_IMAGE);
+                    stResult.insert(FT_ANI);
+                }*/
+            }
+
+            break;
         }
 
-        if (!bAllFound) {
+        if ((!bAllFound) && isReadBudgetAvailable(FT_MACHOFAT)) {
             if (nSize >= (qint64)sizeof(XMACH_DEF::fat_header) + (qint64)sizeof(XMACH_DEF::fat_arch)) {
                 if (read_uint32(0, true) == XMACH_DEF::S_FAT_MAGIC) {
                     if (read_uint32(4, true) < 10) {
@@ -8202,7 +10546,7 @@ QSet<XBinary::FT> XBinary::getFileTypes(bool bExtra)
             }
         }
 
-        if (!bAllFound) {
+        if ((!bAllFound) && isReadBudgetAvailable(FT_JAVACLASS)) {
             if (nSize >= 24) {
                 if (read_uint32(0, true) == 0xCAFEBABE) {
                     if (read_uint32(4, true) > 10) {
@@ -8213,7 +10557,7 @@ QSet<XBinary::FT> XBinary::getFileTypes(bool bExtra)
             }
         }
 
-        if (!bAllFound) {
+        if ((!bAllFound) && isReadBudgetAvailable(FT_PYC)) {
             if (nSize >= 12) {
                 if (read_uint16(2) == 0x0A0D) {
                     // XPYC validation check
@@ -10398,7 +12742,7 @@ void XBinary::_infoMessage(const QString &sInfoMessage)
 
 qint64 XBinary::_calculateRawSize(PDSTRUCT *pPdStruct)
 {
-    _MEMORY_MAP memoryMap = getMemoryMap(MAPMODE_UNKNOWN, pPdStruct);
+    _MEMORY_MAP memoryMap = getCachedMemoryMap(MAPMODE_UNKNOWN, pPdStruct);
 
     return _calculateRawSize(&memoryMap, pPdStruct);
 }
@@ -10581,7 +12925,7 @@ bool XBinary::_addCheckFormatTest(QList<FMT_MSG> *pListFmtMsgs, bool *pbContinue
 void XBinary::dumpMemoryMap()
 {
 #ifdef QT_DEBUG
-    _MEMORY_MAP memoryMap = getMemoryMap(MAPMODE_UNKNOWN);
+    _MEMORY_MAP memoryMap = getCachedMemoryMap(MAPMODE_UNKNOWN);
 
     qDebug("%s", memoryMap.bIsImage ? "Image" : "File");
     qDebug("Binary Size: %s", valueToHex(memoryMap.nBinarySize).toLatin1().data());
@@ -10619,7 +12963,7 @@ void XBinary::dumpMemoryMap()
 void XBinary::dumpHeaders()
 {
 #ifdef QT_DEBUG
-    XBinary::_MEMORY_MAP memoryMap = getMemoryMap();
+    XBinary::_MEMORY_MAP memoryMap = getCachedMemoryMap();
 
     XBinary::DATA_HEADERS_OPTIONS dataHeaderOptions = {};
     dataHeaderOptions.locType = XBinary::LT_OFFSET;
@@ -11059,6 +13403,21 @@ bool XBinary::isUTF8TextType(QByteArray *pbaData)
     qint32 nValidChars = 0;
     qint32 nMultiByteChars = 0;
     qint32 nPrintableChars = 0;
+
+#ifdef USE_XSIMD
+    xsimd_int64 nChars = 0;
+    xsimd_int64 nMultiByte = 0;
+    xsimd_int64 nControl = 0;
+
+    // Null bytes and invalid sequences end the valid prefix
+    if (xsimd_count_utf8_prefix(pDataOffset + nStartOffset, nDataSize - nStartOffset, &nChars, &nMultiByte, &nControl) != nDataSize - nStartOffset) {
+        return false;
+    }
+
+    nValidChars = (qint32)nChars;
+    nMultiByteChars = (qint32)nMultiByte;
+    nPrintableChars = (qint32)(nChars - nMultiByte - nControl);  // Printable ASCII, TAB, LF and CR
+#else
     qint32 nNullBytes = 0;
 
     for (qint32 i = nStartOffset; i < nDataSize;) {
@@ -11099,6 +13458,9 @@ bool XBinary::isUTF8TextType(QByteArray *pbaData)
             if (byte == 0xE0 && pDataOffset[i + 1] < 0xA0) {
                 return false;  // Overlong 3-byte sequence
             }
+            if (byte == 0xED && pDataOffset[i + 1] > 0x9F) {
+                return false;  // UTF-16 surrogate
+            }
             nMultiByteChars++;
             nValidChars++;
             i += 3;
@@ -11122,6 +13484,7 @@ bool XBinary::isUTF8TextType(QByteArray *pbaData)
             return false;
         }
     }
+#endif
 
     // For UTF-8 detection, we need either:
     // 1. UTF-8 BOM present, or
@@ -11354,10 +13717,35 @@ bool XBinary::resize(QIODevice *pDevice, qint64 nSize)
     if (sClassName == "QFile") {
         bResult = ((QFile *)pDevice)->resize(nSize);
     } else if (sClassName == "QBuffer") {
-        ((QBuffer *)pDevice)->buffer().resize((qint32)nSize);
-        bResult = true;
+        // Read-only buffers are read directly from memory (XIODevice::getDeviceMemory)
+        if (pDevice->isWritable()) {
+            ((QBuffer *)pDevice)->buffer().resize((qint32)nSize);
+            bResult = true;
+        }
     } else if (sClassName == "QTemporaryFile") {
         bResult = ((QTemporaryFile *)pDevice)->resize(nSize);
+    } else if (sClassName == "XOverlayDevice") {
+        bResult = ((XOverlayDevice *)pDevice)->resize(nSize);
+    }
+
+    if (bResult) {
+        XPageCache::removeDevice(pDevice);
+    }
+
+    return bResult;
+}
+
+bool XBinary::resize(qint64 nSize)
+{
+    bool bResult = false;
+
+    if (m_pDevice) {
+        bResult = resize(m_pDevice, nSize);
+    }
+
+    if (bResult) {
+        // Size, memory pointer and memory maps describe the old contents
+        setDevice(m_pDevice);
     }
 
     return bResult;
@@ -11699,7 +14087,7 @@ qint64 XBinary::getOverlaySize(PDSTRUCT *pPdStruct)
         pPdStruct = &pdStructEmpty;
     }
 
-    _MEMORY_MAP memoryMap = getMemoryMap(MAPMODE_UNKNOWN, pPdStruct);
+    _MEMORY_MAP memoryMap = getCachedMemoryMap(MAPMODE_UNKNOWN, pPdStruct);
 
     return getOverlaySize(&memoryMap, pPdStruct);
 }
@@ -11725,7 +14113,7 @@ qint64 XBinary::getOverlayOffset(PDSTRUCT *pPdStruct)
         pPdStruct = &pdStructEmpty;
     }
 
-    _MEMORY_MAP memoryMap = getMemoryMap(MAPMODE_UNKNOWN, pPdStruct);
+    _MEMORY_MAP memoryMap = getCachedMemoryMap(MAPMODE_UNKNOWN, pPdStruct);
 
     return getOverlayOffset(&memoryMap, pPdStruct);
 }
@@ -11750,7 +14138,7 @@ bool XBinary::isOverlayPresent(PDSTRUCT *pPdStruct)
         pPdStruct = &pdStructEmpty;
     }
 
-    _MEMORY_MAP memoryMap = getMemoryMap(MAPMODE_UNKNOWN, pPdStruct);
+    _MEMORY_MAP memoryMap = getCachedMemoryMap(MAPMODE_UNKNOWN, pPdStruct);
 
     return isOverlayPresent(&memoryMap, pPdStruct);
 }
@@ -11762,7 +14150,7 @@ bool XBinary::isOverlayPresent(XBinary::_MEMORY_MAP *pMemoryMap, PDSTRUCT *pPdSt
 
 bool XBinary::compareOverlay(const QString &sSignature, qint64 nOffset, PDSTRUCT *pPdStruct)
 {
-    _MEMORY_MAP memoryMap = getMemoryMap(MAPMODE_UNKNOWN, pPdStruct);
+    _MEMORY_MAP memoryMap = getCachedMemoryMap(MAPMODE_UNKNOWN, pPdStruct);
 
     return compareOverlay(&memoryMap, sSignature, nOffset, pPdStruct);
 }
@@ -11786,7 +14174,7 @@ bool XBinary::addOverlay(char *pData, qint64 nDataSize, PDSTRUCT *pPdStruct)
 
     qint64 nRawSize = getOverlayOffset(pPdStruct);
 
-    if (resize(getDevice(), nRawSize + nDataSize)) {
+    if (resize(nRawSize + nDataSize)) {
         if (nDataSize) {
             write_array(nRawSize, pData, nDataSize);
 
@@ -11814,7 +14202,7 @@ bool XBinary::addOverlay(const QString &sFileName, PDSTRUCT *pPdStruct)
         qint64 nRawSize = getOverlayOffset(pPdStruct);
         qint64 nDataSize = file.size();
 
-        if (resize(getDevice(), nRawSize + nDataSize)) {
+        if (resize(nRawSize + nDataSize)) {
             if (nDataSize) {
                 bResult = copyDeviceMemory(&file, 0, getDevice(), nRawSize, nDataSize);
             }
@@ -11833,7 +14221,7 @@ bool XBinary::removeOverlay()
 
 bool XBinary::isSignatureInFilePartPresent(qint32 nFilePartNumber, const QString &sSignature)
 {
-    _MEMORY_MAP memoryMap = getMemoryMap();
+    _MEMORY_MAP memoryMap = getCachedMemoryMap();
 
     return isSignatureInFilePartPresent(&memoryMap, nFilePartNumber, sSignature);
 }
@@ -12489,7 +14877,7 @@ QString XBinary::osNameIdToString(OSNAME osName)
 
 XBinary::DM XBinary::getDisasmMode()
 {
-    _MEMORY_MAP memoryMap = getMemoryMap();
+    _MEMORY_MAP memoryMap = getCachedMemoryMap();
 
     return getDisasmMode(&memoryMap);
 }
@@ -13127,10 +15515,14 @@ QList<quint32> XBinary::get_uint32_list(qint64 nOffset, qint32 nNumberOfRecords,
 {
     QList<quint32> listResult;
 
-    for (qint32 i = 0; i < nNumberOfRecords; i++) {
-        quint32 nRecord = read_uint32(nOffset + i * sizeof(quint32), bIsBigEndian);
+    if (nNumberOfRecords > 0) {
+        QVector<quint32> listRecords(nNumberOfRecords);
+
+        qint64 nCount = read_uint32_array(nOffset, listRecords.data(), nNumberOfRecords, bIsBigEndian);
 
-        listResult.append(nRecord);
+        for (qint32 i = 0; i < nNumberOfRecords; i++) {
+            listResult.append((i < nCount) ? listRecords.at(i) : 0);
+        }
     }
 
     return listResult;
@@ -13140,10 +15532,14 @@ QList<quint64> XBinary::get_uint64_list(qint64 nOffset, qint32 nNumberOfRecords,
 {
     QList<quint64> listResult;
 
-    for (qint32 i = 0; i < nNumberOfRecords; i++) {
-        quint64 nRecord = read_uint64(nOffset + i * sizeof(quint64), bIsBigEndian);
+    if (nNumberOfRecords > 0) {
+        QVector<quint64> listRecords(nNumberOfRecords);
+
+        qint64 nCount = read_uint64_array(nOffset, listRecords.data(), nNumberOfRecords, bIsBigEndian);
 
-        listResult.append(nRecord);
+        for (qint32 i = 0; i < nNumberOfRecords; i++) {
+            listResult.append((i < nCount) ? listRecords.at(i) : 0);
+        }
     }
 
     return listResult;
@@ -13988,6 +16384,11 @@ XBinary::PDSTRUCT XBinary::createPdStruct()
 
     result.bIsStop = false;
     result.nFinished = false;
+    result.nReadBudgetBytes = 0;
+    result.nReadBudgetCalls = 0;
+    result.nBytesRead = 0;
+    result.nReadCalls = 0;
+    result.bIsBudgetExceeded = false;
 
     for (qint32 i = 0; i < N_NUMBER_PDRECORDS; i++) {
         result._pdRecord[i].bIsValid = false;
@@ -14111,7 +16512,7 @@ bool XBinary::isPdStructNotCanceled(PDSTRUCT *pPdStruct)
     bool bResult = true;
 
     if (pPdStruct) {
-        if (pPdStruct->bIsStop) {
+        if (pPdStruct->bIsStop || pPdStruct->bIsBudgetExceeded) {
             bResult = false;
         }
     }
@@ -14183,6 +16584,93 @@ void XBinary::invokePdStructCallback(PDSTRUCT *pPdStruct, qint32 nMinIntervalMs)
     }
 }
 
+// Per thread, so that nested XBinary instances and devices created during one detection share the budget
+static thread_local XBinary::PDSTRUCT *_x_pReadBudgetPdStruct = nullptr;
+
+void XBinary::setPdStructReadBudget(PDSTRUCT *pPdStruct, qint64 nBytes, qint64 nCalls)
+{
+    if (pPdStruct) {
+        pPdStruct->nReadBudgetBytes = nBytes;
+        pPdStruct->nReadBudgetCalls = nCalls;
+        pPdStruct->nBytesRead = 0;
+        pPdStruct->nReadCalls = 0;
+        pPdStruct->bIsBudgetExceeded = false;
+        pPdStruct->listSkippedChecks.clear();
+    }
+}
+
+bool XBinary::isPdStructBudgetExceeded(PDSTRUCT *pPdStruct)
+{
+    bool bResult = false;
+
+    if (pPdStruct) {
+        bResult = pPdStruct->bIsBudgetExceeded;
+    }
+
+    return bResult;
+}
+
+XBinary::PDSTRUCT *XBinary::beginReadBudget(PDSTRUCT *pPdStruct)
+{
+    PDSTRUCT *pResult = _x_pReadBudgetPdStruct;
+
+    // A nested call without its own budget must not lift the budget of the outer one
+    if (pPdStruct && ((_x_pReadBudgetPdStruct == nullptr) || pPdStruct->nReadBudgetBytes || pPdStruct->nReadBudgetCalls)) {
+        _x_pReadBudgetPdStruct = pPdStruct;
+    }
+
+    return pResult;
+}
+
+void XBinary::endReadBudget(PDSTRUCT *pPrevious)
+{
+    _x_pReadBudgetPdStruct = pPrevious;
+}
+
+XBinary::PDSTRUCT *XBinary::getReadBudget()
+{
+    return _x_pReadBudgetPdStruct;
+}
+
+bool XBinary::isReadBudgetAvailable(FT fileType)
+{
+    bool bResult = true;
+
+    PDSTRUCT *pPdStruct = _x_pReadBudgetPdStruct;
+
+    if (pPdStruct && pPdStruct->bIsBudgetExceeded) {
+        if (!pPdStruct->listSkippedChecks.contains(fileType)) {
+            pPdStruct->listSkippedChecks.append(fileType);
+        }
+
+        bResult = false;
+    }
+
+    return bResult;
+}
+
+bool XBinary::_chargeReadBudget(qint64 nSize)
+{
+    bool bResult = true;
+
+    PDSTRUCT *pPdStruct = _x_pReadBudgetPdStruct;
+
+    if (pPdStruct) {
+        if (pPdStruct->bIsBudgetExceeded) {
+            bResult = false;
+        } else if ((pPdStruct->nReadBudgetBytes && (pPdStruct->nBytesRead + nSize > pPdStruct->nReadBudgetBytes)) ||
+                   (pPdStruct->nReadBudgetCalls && (pPdStruct->nReadCalls + 1 > pPdStruct->nReadBudgetCalls))) {
+            pPdStruct->bIsBudgetExceeded = true;
+            bResult = false;
+        } else {
+            pPdStruct->nBytesRead += nSize;
+            pPdStruct->nReadCalls++;
+        }
+    }
+
+    return bResult;
+}
+
 XBinary::REGION_FILL XBinary::getRegionFill(qint64 nOffset, qint64 nSize, qint32 nAlignment)
 {
     REGION_FILL result = {};
@@ -14506,7 +16994,87 @@ QList<XBinary::SIGNATURE_RECORD> XBinary::getSignatureRecords(const QString &sSi
     return listResult;
 }
 
-bool XBinary::_compareSignature(_MEMORY_MAP *pMemoryMap, QList<XBinary::SIGNATURE_RECORD> *pListSignatureRecords, qint64 nOffset, PDSTRUCT *pPdStruct)
+bool XBinary::_compareMaskedSignature(const COMPILED_SIGNATURE &compiledSignature, qint64 nOffset, SIGNATURE_WINDOWS *pWindows)
+{
+    bool bResult = false;
+
+    qint64 nPatternSize = compiledSignature.baMaskedPattern.size();
+
+    if ((nPatternSize > 0) && (nOffset >= 0) && (nOffset + nPatternSize <= getSize())) {
+        if (m_pConstMemory || pWindows) {
+            const char *pData = _getSignatureWindowData(pWindows, nOffset, nPatternSize);
+
+            if (pData) {
+                bResult = compareMemoryMasked(pData, compiledSignature.baMaskedPattern.constData(), compiledSignature.baMask.constData(), nPatternSize);
+            }
+        } else {
+            QByteArray baData = read_array(nOffset, nPatternSize);
+
+            if (baData.size() == nPatternSize) {
+                bResult = compareMemoryMasked(baData.constData(), compiledSignature.baMaskedPattern.constData(), compiledSignature.baMask.constData(),
+                                              nPatternSize);
+            }
+        }
+    }
+
+    return bResult;
+}
+
+const char *XBinary::_getSignatureWindowData(SIGNATURE_WINDOWS *pWindows, qint64 nOffset, qint64 nSize)
+{
+    const char *pResult = nullptr;
+
+    qint64 nFileSize = getSize();
+
+    if ((nOffset >= 0) && (nSize > 0) && (nOffset + nSize <= nFileSize)) {
+        if (m_pConstMemory) {
+            pResult = ((const char *)m_pConstMemory) + nOffset;
+        } else if (pWindows) {
+            qint32 nNumberOfWindows = pWindows->listWindows.count();
+
+            for (qint32 i = 0; i < nNumberOfWindows; i++) {
+                const SIGNATURE_WINDOW &window = pWindows->listWindows.at(i);
+
+                if ((nOffset >= window.nOffset) && (nOffset + nSize <= window.nOffset + window.baData.size())) {
+                    pResult = window.baData.constData() + (nOffset - window.nOffset);
+                    break;
+                }
+            }
+
+            if (!pResult) {
+                SIGNATURE_WINDOW window = {};
+                window.nOffset = nOffset;
+                window.baData = read_array(nOffset, qMin(qMax(nSize, pWindows->nReadSize), nFileSize - nOffset));
+
+                if (window.baData.size() >= nSize) {
+                    pWindows->listWindows.append(window);
+                    pResult = pWindows->listWindows.last().baData.constData();
+                }
+            }
+        }
+    }
+
+    return pResult;
+}
+
+void XBinary::_readSignatureValue(SIGNATURE_WINDOWS *pWindows, qint64 nOffset, char *pBuffer, quint32 nSize)
+{
+    // Unreadable bytes stay zero, as with read_uint32() and friends
+    if (nSize <= 8) {
+        if (m_pConstMemory || pWindows) {
+            const char *pData = _getSignatureWindowData(pWindows, nOffset, nSize);
+
+            if (pData) {
+                memcpy(pBuffer, pData, nSize);
+            }
+        } else {
+            read_array(nOffset, pBuffer, nSize);
+        }
+    }
+}
+
+bool XBinary::_compareSignature(_MEMORY_MAP *pMemoryMap, const QList<XBinary::SIGNATURE_RECORD> *pListSignatureRecords, qint64 nOffset, PDSTRUCT *pPdStruct,
+                                SIGNATURE_WINDOWS *pWindows)
 {
     const qint64 fileSize = getSize();
 
@@ -14519,8 +17087,9 @@ bool XBinary::_compareSignature(_MEMORY_MAP *pMemoryMap, QList<XBinary::SIGNATUR
                 qint32 need = rec.baData.size();
                 if (need <= 0 || (nOffset < 0) || (nOffset + need > fileSize)) return false;
 
-                if (m_pConstMemory) {
-                    const char *src = ((const char *)m_pConstMemory) + nOffset;
+                if (m_pConstMemory || pWindows) {
+                    const char *src = _getSignatureWindowData(pWindows, nOffset, need);
+                    if (!src) return false;
                     if (memcmp(src, rec.baData.constData(), (size_t)need) != 0) return false;
                 } else {
                     QByteArray ba = read_array(nOffset, need);
@@ -14538,8 +17107,9 @@ bool XBinary::_compareSignature(_MEMORY_MAP *pMemoryMap, QList<XBinary::SIGNATUR
                 const int need = rec.nWindowSize;
                 if (need <= 0 || (nOffset < 0) || (nOffset + need > fileSize)) return false;
 
-                if (m_pConstMemory) {
-                    char *ptr = ((char *)m_pConstMemory) + nOffset;
+                if (m_pConstMemory || pWindows) {
+                    char *ptr = (char *)_getSignatureWindowData(pWindows, nOffset, need);
+                    if (!ptr) return false;
                     bool ok = true;
                     if (rec.st == ST_NOTNULL) ok = _isMemoryNotNull(ptr, need);
                     else if (rec.st == ST_ANSI) ok = _isMemoryAnsi(ptr, need);
@@ -14563,7 +17133,23 @@ bool XBinary::_compareSignature(_MEMORY_MAP *pMemoryMap, QList<XBinary::SIGNATUR
 
             case ST_FINDBYTES: {
                 const qint64 limit = rec.nFindDelta + rec.baData.size();
-                qint64 where = find_byteArray(nOffset, limit, rec.baData, pPdStruct);
+                qint64 where = -1;
+
+                if (pWindows) {
+                    // Clamped to the end of the file, as find_byteArray does
+                    const qint64 nWindowSize = (nOffset >= 0) ? qMin(limit, fileSize - nOffset) : 0;
+                    const char *ptr = (nWindowSize >= rec.baData.size()) ? _getSignatureWindowData(pWindows, nOffset, nWindowSize) : nullptr;
+                    if (!ptr) return false;
+                    for (qint64 j = 0; j + rec.baData.size() <= nWindowSize; j++) {
+                        if (memcmp(ptr + j, rec.baData.constData(), (size_t)rec.baData.size()) == 0) {
+                            where = nOffset + j;
+                            break;
+                        }
+                    }
+                } else {
+                    where = find_byteArray(nOffset, limit, rec.baData, pPdStruct);
+                }
+
                 if (where == -1) return false;
                 nOffset = where + rec.baData.size();
             } break;
@@ -14576,21 +17162,23 @@ bool XBinary::_compareSignature(_MEMORY_MAP *pMemoryMap, QList<XBinary::SIGNATUR
 
             case ST_RELOFFSET: {
                 qint64 nValue = 0;
+                char bufValue[8] = {};
+                _readSignatureValue(pWindows, nOffset, bufValue, rec.nSizeOfAddr);
 
                 if (pMemoryMap->fileType == FT_AMIGAHUNK) {
                     switch (rec.nSizeOfAddr) {
-                        case 1: nValue = 1 + read_int8(nOffset); break;
-                        case 2: nValue = read_uint16(nOffset, isBigEndian(pMemoryMap)); break;
-                        case 4: nValue = read_int32(nOffset, isBigEndian(pMemoryMap)); break;
-                        case 8: nValue = read_int64(nOffset, isBigEndian(pMemoryMap)); break;
+                        case 1: nValue = 1 + _read_int8(bufValue); break;
+                        case 2: nValue = _read_uint16(bufValue, isBigEndian(pMemoryMap)); break;
+                        case 4: nValue = _read_int32(bufValue, isBigEndian(pMemoryMap)); break;
+                        case 8: nValue = _read_int64(bufValue, isBigEndian(pMemoryMap)); break;
                         default: return false;
                     }
                 } else {
                     switch (rec.nSizeOfAddr) {
-                        case 1: nValue = 1 + read_int8(nOffset); break;
-                        case 2: nValue = 2 + read_uint16(nOffset, isBigEndian(pMemoryMap)); break;
-                        case 4: nValue = 4 + read_int32(nOffset, isBigEndian(pMemoryMap)); break;
-                        case 8: nValue = 8 + read_int64(nOffset, isBigEndian(pMemoryMap)); break;
+                        case 1: nValue = 1 + _read_int8(bufValue); break;
+                        case 2: nValue = 2 + _read_uint16(bufValue, isBigEndian(pMemoryMap)); break;
+                        case 4: nValue = 4 + _read_int32(bufValue, isBigEndian(pMemoryMap)); break;
+                        case 8: nValue = 8 + _read_int64(bufValue, isBigEndian(pMemoryMap)); break;
                         default: return false;
                     }
                 }
@@ -14608,11 +17196,13 @@ bool XBinary::_compareSignature(_MEMORY_MAP *pMemoryMap, QList<XBinary::SIGNATUR
 
             case ST_ADDRESS: {
                 XADDR _nAddress = 0;
+                char bufValue[8] = {};
+                _readSignatureValue(pWindows, nOffset, bufValue, rec.nSizeOfAddr);
                 switch (rec.nSizeOfAddr) {
-                    case 1: _nAddress = read_uint8(nOffset); break;
-                    case 2: _nAddress = read_uint16(nOffset, isBigEndian(pMemoryMap)); break;
-                    case 4: _nAddress = read_uint32(nOffset, isBigEndian(pMemoryMap)); break;
-                    case 8: _nAddress = read_uint64(nOffset, isBigEndian(pMemoryMap)); break;
+                    case 1: _nAddress = _read_uint8(bufValue); break;
+                    case 2: _nAddress = _read_uint16(bufValue, isBigEndian(pMemoryMap)); break;
+                    case 4: _nAddress = _read_uint32(bufValue, isBigEndian(pMemoryMap)); break;
+                    case 8: _nAddress = _read_uint64(bufValue, isBigEndian(pMemoryMap)); break;
                     default: return false;
                 }
 
@@ -15005,7 +17595,7 @@ bool XBinary::_isOffsetValid(qint64 nOffset)
 
 bool XBinary::isAddressPhysical(XADDR nAddress)
 {
-    _MEMORY_MAP memoryMap = getMemoryMap();
+    _MEMORY_MAP memoryMap = getCachedMemoryMap();
 
     return isAddressPhysical(&memoryMap, nAddress);
 }
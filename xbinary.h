@@ -21,6 +21,7 @@
 #ifndef XBINARY_H
 #define XBINARY_H
 
+#include <QBitArray>
 #include <QBuffer>
 #include <QCoreApplication>
 #include <QCryptographicHash>
@@ -31,6 +32,7 @@
 #include <QElapsedTimer>
 #include <QFile>
 #include <QFileInfo>
+#include <QHash>
 #include <QIODevice>
 #include <QMap>
 #include <QMutex>
@@ -38,7 +40,9 @@
 #include <QSet>
 #include <QTemporaryFile>
 #include <QTextStream>
+#include <QThreadPool>
 #include <QUuid>
+#include <QVector>
 #include <QXmlStreamReader>
 #include <QXmlStreamWriter>
 #include <QtEndian>
@@ -67,6 +71,9 @@
 #include <math.h>
 
 #include "subdevice.h"
+#include "xmappeddevice.h"
+#include "xoverlaydevice.h"
+#include "xpagecache.h"
 #include "xbinary_def.h"
 #include "xelf_def.h"
 #include "xle_def.h"
@@ -715,6 +722,14 @@ public:
         ENDIAN_BIG
     };
 
+    // Read-only window into the data; baHolder pins a cache page or keeps a private copy
+    struct VIEW {
+        const char *pData;
+        qint64 nOffset;
+        qint64 nSize;
+        QByteArray baHolder;
+    };
+
     struct FILEFORMATINFO {
         bool bIsValid;
         qint64 nSize;
@@ -735,6 +750,37 @@ public:
         QString sCompresionMethod;
     };
 
+    // Part of the offset or address space where the set of covering records does not change
+    struct _MEMORY_SEGMENT {
+        XADDR nStart;
+        XADDR nEnd;
+        qint32 nFirst;        // First record
+        qint32 nFirstMapped;  // First record with both offset and address
+        qint32 nLastMapped;   // Last record with both offset and address
+    };
+
+    // Structure-of-arrays copy of the fields of _MEMORY_MAP::listRecords that lookups and counters read; element i describes record i
+    struct _MEMORY_MAP_COMPACT {
+        QVector<qint64> listOffsets;
+        QVector<XADDR> listAddresses;
+        QVector<qint64> listSizes;
+        QVector<quint32> listFileParts;  // FILEPART
+        QVector<qint32> listFilePartNumbers;
+        QVector<qint32> listIndexes;
+        QBitArray baIsVirtual;
+    };
+
+    struct _MEMORY_INDEX {
+        _MEMORY_INDEX() : nNumberOfRecords(-1)
+        {
+        }
+
+        qint32 nNumberOfRecords;  // -1 if not built
+        QVector<_MEMORY_SEGMENT> listOffsetSegments;
+        QVector<_MEMORY_SEGMENT> listAddressSegments;
+        _MEMORY_MAP_COMPACT compact;
+    };
+
     struct _MEMORY_MAP {
         XADDR nModuleAddress;
         bool bIsImage;  // TODO fill
@@ -749,6 +795,7 @@ public:
         QString sArch;
         QString sType;
         QList<_MEMORY_RECORD> listRecords;
+        _MEMORY_INDEX index;  // Built once the map is final (_prepareMemoryIndex); lookups only read it. Call resetMemoryIndex after editing listRecords
     };
 
     enum SYMBOL_TYPE {
@@ -910,6 +957,13 @@ public:
         PDSTRUCT_CALLBACK pCallback;
         void *pCallbackUserData;
         qint64 nLastCallbackTime;
+        // I/O budget; counted while the struct is bound with beginReadBudget
+        qint64 nReadBudgetBytes;  // 0 => unlimited
+        qint64 nReadBudgetCalls;  // 0 => unlimited
+        qint64 nBytesRead;
+        qint64 nReadCalls;
+        bool bIsBudgetExceeded;
+        QList<FT> listSkippedChecks;
     };
 
     enum DHT {
@@ -1063,6 +1117,52 @@ public:
         qint32 nWindowSize;
     };
 
+    // Signature parsed once by compileSignature; copies share the record list
+    struct COMPILED_SIGNATURE {
+        QString sSignature;   // As given
+        QString sInfoString;  // Parse error, if any
+        bool bIsValid;
+        bool bIsPlain;        // Hex bytes only, searched with find_array
+        QByteArray baPlain;
+        bool bIsMasked;  // Hex bytes and ".." only, compared as pattern + mask in one pass
+        QByteArray baMaskedPattern;
+        QByteArray baMask;  // 0xFF => compare, 0x00 => wildcard
+        QList<SIGNATURE_RECORD> listRecords;
+        qint64 nResultSize;  // Reported by find_signature
+        // find_signature scans for the widest record in front of the first address record and verifies the rest
+        qint32 nSearchFirstIndex;
+        qint64 nSearchDelta;
+        ST stSearch;
+        qint64 nSearchMaxSize;
+    };
+
+    // Set of compiled signatures searched together in one pass.
+    // The longest literal run in front of the first variable-distance record of each signature ("anchor") goes into an
+    // Aho-Corasick automaton; every anchor hit is then verified with the full signature.
+    struct MULTISIGNATURE {
+        QVector<COMPILED_SIGNATURE> listSignatures;
+        QVector<qint64> listAnchorDeltas;  // Anchor offset from the start of the signature; -1 => no anchor
+        QVector<qint32> listAnchorSizes;
+        QVector<qint32> listUnanchored;  // Valid signatures without an anchor; searched one by one
+        // Automaton; state 0 is the root. Edges of a state are sorted by byte.
+        QVector<qint32> listRootNext;  // 256 entries
+        QVector<qint32> listEdgeFirst;
+        QVector<qint32> listEdgeCount;
+        QVector<quint8> listEdgeBytes;
+        QVector<qint32> listEdgeTargets;
+        QVector<qint32> listFail;
+        QVector<qint32> listOutputFirst;  // Signatures whose anchor ends in the state
+        QVector<qint32> listOutputCount;
+        QVector<qint32> listOutputSignatures;
+        QVector<qint32> listOutputLink;  // Nearest state on the fail chain with outputs; -1 => none
+    };
+
+    struct MULTISIGNATURE_MATCH {
+        qint32 nSignatureIndex;
+        qint64 nOffset;
+        qint64 nSize;
+    };
+
     explicit XBinary(QIODevice *pDevice = nullptr, bool bIsImage = false,
                      XADDR nModuleAddress = -1);  // mb TODO parent for signals/slot
     XBinary(const QString &sFileName);
@@ -1071,6 +1171,13 @@ public:
     void setData(QIODevice *pDevice = nullptr, bool bIsImage = false, XADDR nModuleAddress = -1);
     void setDevice(QIODevice *pDevice);
     void setReadWriteMutex(QMutex *pReadWriteMutex);
+    void setPageCache(XPageCache *pPageCache);  // Not used for devices open for writing (XPageCache::isDeviceCacheable)
+    XPageCache *getPageCache();
+
+    VIEW getView(qint64 nOffset, qint64 nSize);
+    bool isPrefetchEnabled();
+    void prefetch(const QList<OFFSETSIZE> &listRegions);
+    static const char *getViewData(const VIEW *pView, qint64 nOffset, qint64 nSize);
 
     void setFileName(const QString &sFileName);
 
@@ -1200,6 +1307,9 @@ public:
     qint32 read_int32(qint64 nOffset, bool bIsBigEndian = false);
     quint64 read_uint64(qint64 nOffset, bool bIsBigEndian = false);
     qint64 read_int64(qint64 nOffset, bool bIsBigEndian = false);
+    qint64 read_uint16_array(qint64 nOffset, quint16 *pBuffer, qint64 nCount, bool bIsBigEndian = false);
+    qint64 read_uint32_array(qint64 nOffset, quint32 *pBuffer, qint64 nCount, bool bIsBigEndian = false);
+    qint64 read_uint64_array(qint64 nOffset, quint64 *pBuffer, qint64 nCount, bool bIsBigEndian = false);
     float read_float16(qint64 nOffset, bool bIsBigEndian = false);  // TODO Check
     float read_float(qint64 nOffset, bool bIsBigEndian = false);    // TODO Check
     double read_double(qint64 nOffset, bool bIsBigEndian = false);  // TODO Check
@@ -1262,6 +1372,71 @@ public:
                                bool bIsBigEndian = false);  // TODO Check
 
     static quint64 _read_value(MODE mode, char *pData, bool bIsBigEndian = false);
+
+    static void _toHostEndian16(quint16 *pData, qint64 nCount, bool bIsBigEndian);
+    static void _toHostEndian32(quint32 *pData, qint64 nCount, bool bIsBigEndian);
+    static void _toHostEndian64(quint64 *pData, qint64 nCount, bool bIsBigEndian);
+
+    static void _swapStructFields(char *pData, qint32 nStructSize, qint32 nCount, const XBINARY_DEF::STRUCT_FIELD *pFields, qint32 nNumberOfFields,
+                                  bool bIsBigEndian);
+
+    // Reads nCount structures with one I/O and converts the described fields to host byte order
+    template <typename T, size_t N>
+    qint32 read_records(qint64 nOffset, T *pRecords, qint32 nCount, const XBINARY_DEF::STRUCT_FIELD (&fields)[N], bool bIsBigEndian)
+    {
+        qint32 nResult = 0;
+
+        if (nCount > 0) {
+            qint64 nTotalSize = (qint64)sizeof(T) * nCount;
+
+            // Only the bytes the data holds are read; the rest is zeroed
+            qint64 nDataSize = getSize();
+            qint64 nReadSize = ((nOffset >= 0) && (nOffset < nDataSize)) ? qMin(nTotalSize, nDataSize - nOffset) : 0;
+            qint32 nReadCount = (qint32)((nReadSize + (qint64)sizeof(T) - 1) / (qint64)sizeof(T));
+
+            qint64 nSize = 0;
+
+            if (nReadSize > 0) {
+                nSize = read_array(nOffset, (char *)pRecords, nReadSize);
+            }
+
+            if (nSize < 0) {
+                nSize = 0;
+            }
+
+            if (nSize < nTotalSize) {
+                memset(((char *)pRecords) + nSize, 0, (size_t)(nTotalSize - nSize));
+            }
+
+            _swapStructFields((char *)pRecords, sizeof(T), nReadCount, fields, N, bIsBigEndian);
+
+            nResult = (qint32)(nSize / (qint64)sizeof(T));
+        }
+
+        return nResult;
+    }
+
+    template <typename T, size_t N>
+    T read_record(qint64 nOffset, const XBINARY_DEF::STRUCT_FIELD (&fields)[N], bool bIsBigEndian)
+    {
+        T result = {};
+
+        read_records(nOffset, &result, 1, fields, bIsBigEndian);
+
+        return result;
+    }
+
+    template <typename T, size_t N>
+    static T _read_record(const char *pData, const XBINARY_DEF::STRUCT_FIELD (&fields)[N], bool bIsBigEndian)
+    {
+        T result = {};
+
+        memcpy(&result, pData, sizeof(T));
+
+        _swapStructFields((char *)&result, sizeof(T), 1, fields, N, bIsBigEndian);
+
+        return result;
+    }
     // TODO read uin64, freg
 
     static quint8 _read_uint8_safe(char *pBuffer, qint32 nBufferSize, qint32 nOffset);
@@ -1300,6 +1475,8 @@ public:
     qint64 _find_array(ST st, qint64 nOffset, qint64 nSize, const char *pArray, qint64 nArraySize, PDSTRUCT *pPdStruct = nullptr);
     qint64 find_array(qint64 nOffset, qint64 nSize, const char *pArray, qint64 nArraySize, PDSTRUCT *pPdStruct = nullptr);
     qint64 find_byteArray(qint64 nOffset, qint64 nSize, const QByteArray &baData, PDSTRUCT *pPdStruct = nullptr);
+    qint64 find_masked(qint64 nOffset, qint64 nSize, const char *pPattern, const char *pMask, qint64 nPatternSize, PDSTRUCT *pPdStruct = nullptr);
+    qint64 _find_parallel(ST st, qint64 nOffset, qint64 nSize, const char *pArray, const char *pMask, qint64 nArraySize, PDSTRUCT *pPdStruct = nullptr);
     qint64 find_uint8(qint64 nOffset, qint64 nSize, quint8 nValue, PDSTRUCT *pPdStruct = nullptr);
     qint64 find_int8(qint64 nOffset, qint64 nSize, qint8 nValue, PDSTRUCT *pPdStruct = nullptr);
     qint64 find_uint16(qint64 nOffset, qint64 nSize, quint16 nValue, bool bIsBigEndian = false, PDSTRUCT *pPdStruct = nullptr);
@@ -1320,6 +1497,8 @@ public:
     qint64 find_signature(qint64 nOffset, qint64 nSize, const QString &sSignature, qint64 *pnResultSize = 0, PDSTRUCT *pPdStruct = nullptr);
     qint64 find_signature(_MEMORY_MAP *pMemoryMap, qint64 nOffset, qint64 nSize, const QString &sSignature, qint64 *pnResultSize = nullptr,
                           PDSTRUCT *pPdStruct = nullptr);
+    qint64 find_signature(_MEMORY_MAP *pMemoryMap, qint64 nOffset, qint64 nSize, const COMPILED_SIGNATURE &compiledSignature, qint64 *pnResultSize = nullptr,
+                          PDSTRUCT *pPdStruct = nullptr);
     qint64 find_ansiStringI(qint64 nOffset, qint64 nSize, const QString &sString, PDSTRUCT *pPdStruct = nullptr);
     qint64 find_unicodeStringI(qint64 nOffset, qint64 nSize, const QString &sString, bool bIsBigEndian, PDSTRUCT *pPdStruct = nullptr);
     qint64 find_utf8StringI(qint64 nOffset, qint64 nSize, const QString &sString, PDSTRUCT *pPdStruct = nullptr);
@@ -1345,6 +1524,40 @@ public:
         bool bLinks;
     };
 
+    enum STRINGSCAN {
+        STRINGSCAN_ALL = 0,  // multiSearch_allStrings
+        STRINGSCAN_ANSI,     // multiSearch_ansiStrings
+        STRINGSCAN_UNICODE   // multiSearch_unicodeStrings
+    };
+
+    // Resumable multiSearch_allStrings; holds one read buffer and the strings in progress
+    struct STRINGSCAN_STATE {
+        _MEMORY_MAP *pMemoryMap;
+        STRINGSEARCH_OPTIONS ssOptions;
+        qint64 nOffset;
+        qint64 nSize;
+        qint64 nLimit;          // -1 - no limit
+        qint64 nCurrentOffset;  // Next byte to scan
+        QByteArray baBuffer;
+        qint64 nBufferOffset;
+        qint64 nBufferDataSize;
+        QByteArray baAnsi;
+        qint64 nCurrentAnsiSize;
+        qint64 nCurrentAnsiOffset;
+        QVector<quint16> listUnicode[2];  // Even/odd parity
+        qint64 nCurrentUnicodeSize[2];
+        qint64 nCurrentUnicodeOffset[2];
+        char cPrevSymbol;
+        bool bIsStart;
+        qint64 nNumberOfRecords;
+        bool bIsLimit;
+        bool bIsReadError;
+        bool bIsFinished;
+    };
+
+    // Returns false to stop the scan
+    typedef bool (*MS_RECORD_SINK)(void *pUserData, const QVector<MS_RECORD> &listRecords);
+
     struct SIGNATUREDB_RECORD {
         qint32 nNumber;
         QString sName;
@@ -1380,12 +1593,32 @@ public:
                                               QRegularExpression *pRegex);
 
     QVector<MS_RECORD> multiSearch_allStrings(_MEMORY_MAP *pMemoryMap, qint64 nOffset, qint64 nSize, STRINGSEARCH_OPTIONS ssOptions, PDSTRUCT *pPdStruct = nullptr);
+    // ssOptions.nLimit 0 - no limit
+    STRINGSCAN_STATE multiSearch_allStringsBegin(_MEMORY_MAP *pMemoryMap, qint64 nOffset, qint64 nSize, STRINGSEARCH_OPTIONS ssOptions);
+    // Appends up to nBatchSize records (a few more if one byte ends several strings; 0 - default) and scans one read buffer at most.
+    // Returns false when the scan is finished or stopped; the records of that call are still appended.
+    bool multiSearch_allStringsNext(STRINGSCAN_STATE *pState, QVector<MS_RECORD> *pListRecords, qint32 nBatchSize = 0, PDSTRUCT *pPdStruct = nullptr);
+    // Hands the records to pSink in batches of nBatchSize; returns the number of records delivered
+    qint64 multiSearch_allStringsToSink(_MEMORY_MAP *pMemoryMap, qint64 nOffset, qint64 nSize, STRINGSEARCH_OPTIONS ssOptions, MS_RECORD_SINK pSink,
+                                        void *pUserData, qint32 nBatchSize = 0, PDSTRUCT *pPdStruct = nullptr);
     QVector<MS_RECORD> multiSearch_allStrings2(_MEMORY_MAP *pMemoryMap, qint64 nOffset, qint64 nSize, STRINGSEARCH_OPTIONS ssOptions, PDSTRUCT *pPdStruct = nullptr);
     QVector<MS_RECORD> multiSearch_ansiStrings(_MEMORY_MAP *pMemoryMap, qint64 nOffset, qint64 nSize, STRINGSEARCH_OPTIONS ssOptions, PDSTRUCT *pPdStruct = nullptr);
     QVector<MS_RECORD> multiSearch_unicodeStrings(_MEMORY_MAP *pMemoryMap, qint64 nOffset, qint64 nSize, STRINGSEARCH_OPTIONS ssOptions, PDSTRUCT *pPdStruct = nullptr);
+    // Same records as the serial functions; the region is cut where no string can cross and the parts run on nNumberOfThreads (0 - ideal count)
+    QVector<MS_RECORD> multiSearch_allStringsParallel(_MEMORY_MAP *pMemoryMap, qint64 nOffset, qint64 nSize, STRINGSEARCH_OPTIONS ssOptions,
+                                                      qint32 nNumberOfThreads = 0, PDSTRUCT *pPdStruct = nullptr);
+    QVector<MS_RECORD> multiSearch_allStrings2Parallel(_MEMORY_MAP *pMemoryMap, qint64 nOffset, qint64 nSize, STRINGSEARCH_OPTIONS ssOptions,
+                                                       qint32 nNumberOfThreads = 0, PDSTRUCT *pPdStruct = nullptr);
+    QVector<MS_RECORD> _multiSearch_stringsParallel(STRINGSCAN stringScan, _MEMORY_MAP *pMemoryMap, qint64 nOffset, qint64 nSize, STRINGSEARCH_OPTIONS ssOptions,
+                                                    qint32 nNumberOfThreads = 0, PDSTRUCT *pPdStruct = nullptr);
     QVector<MS_RECORD> multiSearch_signature(qint64 nOffset, qint64 nSize, qint32 nLimit, const QString &sSignature, quint32 nInfo, PDSTRUCT *pPdStruct = nullptr);
     QVector<MS_RECORD> multiSearch_signature(_MEMORY_MAP *pMemoryMap, qint64 nOffset, qint64 nSize, qint32 nLimit, const QString &sSignature, quint32 nInfo,
                                              PDSTRUCT *pPdStruct = nullptr);
+    static MULTISIGNATURE createMultiSignature(const QList<COMPILED_SIGNATURE> &listSignatures);
+    static MULTISIGNATURE createMultiSignature(const QList<QString> &listSignatures);
+    // All matches of all signatures, sorted by offset; nLimit = -1 => no limit
+    QVector<MULTISIGNATURE_MATCH> multiSearch_signatures(_MEMORY_MAP *pMemoryMap, qint64 nOffset, qint64 nSize, const MULTISIGNATURE *pMultiSignature,
+                                                         qint32 nLimit = -1, PDSTRUCT *pPdStruct = nullptr);
     QVector<MS_RECORD> multiSearch_value(qint64 nOffset, qint64 nSize, qint32 nLimit, QVariant varValue, VT valueType, bool bIsBigEndian, PDSTRUCT *pPdStruct = nullptr);
     QVector<MS_RECORD> multiSearch_value(_MEMORY_MAP *pMemoryMap, qint64 nOffset, qint64 nSize, qint32 nLimit, QVariant varValue, VT valueType, bool bIsBigEndian,
                                          PDSTRUCT *pPdStruct = nullptr);
@@ -1408,8 +1641,14 @@ public:
     static QByteArray getStringData(VT valueType, const QString &sString, bool bAddNull);
 
     bool isSignaturePresent(_MEMORY_MAP *pMemoryMap, qint64 nOffset, qint64 nSize, const QString &sSignature, PDSTRUCT *pPdStruct = nullptr);
+    bool isSignaturePresent(_MEMORY_MAP *pMemoryMap, qint64 nOffset, qint64 nSize, const COMPILED_SIGNATURE &compiledSignature, PDSTRUCT *pPdStruct = nullptr);
     static bool isSignatureValid(const QString &sSignature, PDSTRUCT *pPdStruct = nullptr);
 
+    static COMPILED_SIGNATURE compileSignature(const QString &sSignature);
+    // Thread-safe; compiles on first use and then returns the shared result
+    static COMPILED_SIGNATURE getCompiledSignature(const QString &sSignature);
+    static void clearCompiledSignatureCache();
+
     static bool createFile(const QString &sFileName, qint64 nFileSize = 0);
     static bool isFileExists(const QString &sFileName, bool bTryToOpen = false);
     static bool removeFile(const QString &sFileName);
@@ -1441,6 +1680,7 @@ public:
     bool copyMemory(qint64 nSourceOffset, qint64 nDestOffset, qint64 nSize, quint32 nBufferSize = 1, bool bReverse = false);
     bool zeroFill(qint64 nOffset, qint64 nSize, PDSTRUCT *pPdStruct = nullptr);
     static bool compareMemory(char *pMemory1, const char *pMemory2, qint64 nSize);
+    static bool compareMemoryMasked(const char *pMemory, const char *pPattern, const char *pMask, qint64 nSize);
     // For strings compare
     static bool compareMemoryByteI(quint8 *pMemory, const quint8 *pMemoryU, const quint8 *pMemoryL,
                                    qint64 nSize);  // Ansi
@@ -1525,6 +1765,15 @@ public:
     virtual void _processMemoryMap(_MEMORY_MAP *pMemoryMap, QList<FPART> *pListFParts, PDSTRUCT *pPdStruct);
 
     virtual _MEMORY_MAP getMemoryMap(MAPMODE mapMode = MAPMODE_UNKNOWN, PDSTRUCT *pPdStruct = nullptr);
+    // Same as getMemoryMap(); the result is kept per mode until the data or the image settings change
+    _MEMORY_MAP getCachedMemoryMap(MAPMODE mapMode = MAPMODE_UNKNOWN, PDSTRUCT *pPdStruct = nullptr);
+    void setMemoryMapCacheEnabled(bool bState);
+    bool isMemoryMapCacheEnabled();
+    // Large _find_array/find_masked regions are split into overlapping chunks and scanned on this many threads.
+    // Only for constant memory and positional devices; 0 or 1 => sequential.
+    void setSearchThreads(qint32 nNumberOfThreads);
+    qint32 getSearchThreads();
+    void resetMemoryMapCache();
     _MEMORY_MAP _getMemoryMap(quint32 nFileParts, PDSTRUCT *pPdStruct = nullptr);
     _MEMORY_MAP _getMemoryMap(QList<FPART> *pListFParts, PDSTRUCT *pPdStruct = nullptr);
 
@@ -1540,6 +1789,8 @@ public:
     static qint32 getNumberOfMemoryMapFileParts(_MEMORY_MAP *pMemoryMap, FILEPART filePart);
     static qint64 getRecordsTotalRowSize(_MEMORY_MAP *pMemoryMap);
 
+    static void resetMemoryIndex(_MEMORY_MAP *pMemoryMap);
+
     virtual XADDR getBaseAddress();
     virtual void setBaseAddress(XADDR nBaseAddress);
     virtual qint64 getImageSize();
@@ -1571,6 +1822,7 @@ public:
     static bool isEmptyData(char *pBuffer, qint64 nSize);
     bool compareSignature(const QString &sSignature, qint64 nOffset = 0);
     bool compareSignature(_MEMORY_MAP *pMemoryMap, const QString &sSignature, qint64 nOffset = 0, PDSTRUCT *pPdStruct = nullptr);
+    bool compareSignature(_MEMORY_MAP *pMemoryMap, const COMPILED_SIGNATURE &compiledSignature, qint64 nOffset = 0, PDSTRUCT *pPdStruct = nullptr);
     static bool _compareByteArrayWithSignature(const QByteArray &baData, const QString &sSignature);
     static QString _createSignature(const QString &sSignature1, const QString &sSignature2);
 
@@ -1579,6 +1831,11 @@ public:
 
     bool compareEntryPoint(const QString &sSignature, qint64 nOffset = 0);
     bool compareEntryPoint(_MEMORY_MAP *pMemoryMap, const QString &sSignature, qint64 nOffset = 0);
+    bool compareEntryPoint(_MEMORY_MAP *pMemoryMap, const COMPILED_SIGNATURE &compiledSignature, qint64 nOffset = 0);
+    // Bit i is set if signature i matches at the entry point. The entry point is resolved once and the bytes for all
+    // signatures, including the targets of $ and # jumps, are read once.
+    QBitArray compareEntryPoints(_MEMORY_MAP *pMemoryMap, const QList<COMPILED_SIGNATURE> &listSignatures, qint64 nOffset = 0, PDSTRUCT *pPdStruct = nullptr);
+    QBitArray compareEntryPoints(_MEMORY_MAP *pMemoryMap, const QList<QString> &listSignatures, qint64 nOffset = 0, PDSTRUCT *pPdStruct = nullptr);
 
     bool moveMemory(qint64 nSourceOffset, qint64 nDestOffset, qint64 nSize);
     static bool moveMemory(QIODevice *pDevice, qint64 nSourceOffset, qint64 nDestOffset, qint64 nSize);
@@ -1803,7 +2060,8 @@ public:
     static QString get_uint16_version(quint16 nValue);
     static QString get_uint32_version(quint32 nValue);
     static bool isResizeEnable(QIODevice *pDevice);
-    static bool resize(QIODevice *pDevice, qint64 nSize);
+    static bool resize(QIODevice *pDevice, qint64 nSize);  // false for read-only QBuffer: its data is read directly from memory
+    bool resize(qint64 nSize);  // Own device; the size and the cached memory maps are refreshed
 
     struct PACKED_UINT {
         bool bIsValid;
@@ -2048,6 +2306,14 @@ public:
     static void setPdStructStopped(PDSTRUCT *pPdStruct);
     static qint32 getPdStructPercentage(PDSTRUCT *pPdStruct);  // 0-100
     static void invokePdStructCallback(PDSTRUCT *pPdStruct, qint32 nMinIntervalMs = 100);
+    static void setPdStructReadBudget(PDSTRUCT *pPdStruct, qint64 nBytes, qint64 nCalls);
+    static bool isPdStructBudgetExceeded(PDSTRUCT *pPdStruct);
+    // Reads on the calling thread are charged to the bound PDSTRUCT until endReadBudget; returns the previous binding
+    static PDSTRUCT *beginReadBudget(PDSTRUCT *pPdStruct);
+    static void endReadBudget(PDSTRUCT *pPrevious);
+    static PDSTRUCT *getReadBudget();
+    // false if the bound budget is exhausted; fileType is then recorded as a skipped check
+    static bool isReadBudgetAvailable(FT fileType);
 
     struct REGION_FILL {
         quint64 nSize;
@@ -2193,7 +2459,22 @@ private:
     static QString qcharToHex(QChar cSymbol);
 
     static QList<SIGNATURE_RECORD> getSignatureRecords(const QString &sSignature, bool *pbValid, PDSTRUCT *pPdStruct);
-    bool _compareSignature(_MEMORY_MAP *pMemoryMap, QList<SIGNATURE_RECORD> *pListSignatureRecords, qint64 nOffset, PDSTRUCT *pPdStruct);
+    // Bytes shared by a batch of signatures (see compareEntryPoints); each window is read once
+    struct SIGNATURE_WINDOW {
+        qint64 nOffset;
+        QByteArray baData;
+    };
+
+    struct SIGNATURE_WINDOWS {
+        qint64 nReadSize;  // Minimum size of a new window
+        QList<SIGNATURE_WINDOW> listWindows;
+    };
+
+    bool _compareSignature(_MEMORY_MAP *pMemoryMap, const QList<SIGNATURE_RECORD> *pListSignatureRecords, qint64 nOffset, PDSTRUCT *pPdStruct,
+                           SIGNATURE_WINDOWS *pWindows = nullptr);
+    bool _compareMaskedSignature(const COMPILED_SIGNATURE &compiledSignature, qint64 nOffset, SIGNATURE_WINDOWS *pWindows = nullptr);
+    const char *_getSignatureWindowData(SIGNATURE_WINDOWS *pWindows, qint64 nOffset, qint64 nSize);
+    void _readSignatureValue(SIGNATURE_WINDOWS *pWindows, qint64 nOffset, char *pBuffer, quint32 nSize);
 
     static qint32 _getSignatureSkip(QList<SIGNATURE_RECORD> *pListSignatureRecords, const QString &sSignature, qint32 nStartIndex);
     static qint32 _getSignatureNotNull(QList<SIGNATURE_RECORD> *pListSignatureRecords, const QString &sSignature, qint32 nStartIndex);
@@ -2212,17 +2493,47 @@ protected:
     void _infoMessage(const QString &sInfoMessage);
     qint64 _calculateRawSize(PDSTRUCT *pPdStruct);
     static qint64 _calculateRawSize(_MEMORY_MAP *pMemoryMap, PDSTRUCT *pPdStruct);
+    static bool _prepareMemoryIndex(_MEMORY_MAP *pMemoryMap);
 
 signals:
     void errorMessage(const QString &sErrorMessage);
     void infoMessage(const QString &sInfoMessage);
 
 private:
+    void _updateConstMemory();
+    qint64 _readDataConstMemory(qint64 nPos, char *pData, qint64 nMaxLen);
+    qint64 _readDataPageCache(qint64 nPos, char *pData, qint64 nMaxLen);
+    qint64 _readDataPositional(qint64 nPos, char *pData, qint64 nMaxLen);
+    static bool _chargeReadBudget(qint64 nSize);
+    bool _isConcurrentReadSafe();
+    bool _isParallelSearch(qint64 nSize, qint64 nArraySize);
+    QList<qint64> _getStringSplitPoints(STRINGSCAN stringScan, qint64 nOffset, qint64 nSize, const STRINGSEARCH_OPTIONS &ssOptions, PDSTRUCT *pPdStruct);
+
+    enum MEMORY_LOOKUP {
+        MEMORY_LOOKUP_FIRST = 0,
+        MEMORY_LOOKUP_FIRSTMAPPED,
+        MEMORY_LOOKUP_LASTMAPPED
+    };
+
+    static void _buildCompactMemoryMap(QList<_MEMORY_RECORD> *pListRecords, _MEMORY_MAP_COMPACT *pCompact);
+    static void _buildMemorySegments(QList<_MEMORY_RECORD> *pListRecords, bool bAddress, QVector<_MEMORY_SEGMENT> *pListSegments);
+    static bool _isMemoryIndexValid(const _MEMORY_MAP *pMemoryMap);
+    static const _MEMORY_MAP_COMPACT *_getCompactMemoryMap(const _MEMORY_MAP *pMemoryMap);  // nullptr if the map has no index
+    static qint32 _findMemoryRecord(const _MEMORY_MAP *pMemoryMap, XADDR nValue, bool bAddress, MEMORY_LOOKUP lookup);
+
     QIODevice *m_pDevice;
+    XIODevice *m_pPositionalDevice;
     const char *m_pConstMemory;
     QString m_sFileName;
     QFile *m_pFile;
     QMutex *m_pReadWriteMutex;
+    XPageCache *m_pPageCache;
+    bool m_bIsPageCacheable;  // XPageCache::isDeviceCacheable(m_pDevice)
+    bool m_bMemoryMapCache;
+    qint32 m_nSearchThreads;
+    QThreadPool *m_pSearchThreadPool;  // Created on first parallel search
+    QMap<MAPMODE, _MEMORY_MAP> m_mapMemoryMapCache;
+    QMutex m_memoryMapCacheMutex;
     bool m_bIsImage;
     XADDR m_nBaseAddress;
     qint64 m_nEntryPointOffset;
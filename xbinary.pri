@@ -7,12 +7,18 @@ HEADERS += \
     $$PWD/subdevice.h \
     $$PWD/xbinary.h \
     $$PWD/xbinary_def.h \
-    $$PWD/xiodevice.h
+    $$PWD/xiodevice.h \
+    $$PWD/xmappeddevice.h \
+    $$PWD/xoverlaydevice.h \
+    $$PWD/xpagecache.h
 
 SOURCES += \
     $$PWD/subdevice.cpp \
     $$PWD/xbinary.cpp \
-    $$PWD/xiodevice.cpp
+    $$PWD/xiodevice.cpp \
+    $$PWD/xmappeddevice.cpp \
+    $$PWD/xoverlaydevice.cpp \
+    $$PWD/xpagecache.cpp
 
 DISTFILES += \
     $$PWD/xbinary.cmake
@@ -23,6 +23,12 @@
 
 #include <QtGlobal>
 
+#include <stddef.h>
+
+// Describes one integer field of a structure whose in-memory layout matches the file layout
+#define XBINARY_STRUCT_FIELD(type, field) \
+    { (quint16)offsetof(type, field), (quint16)sizeof(((type *)nullptr)->field) }
+
 namespace XBINARY_DEF {
 struct XGUID  // size is 16
 {
@@ -32,5 +38,10 @@ struct XGUID  // size is 16
     quint8 Data4[8];
 };
 
+struct STRUCT_FIELD {
+    quint16 nOffset;
+    quint16 nSize;
+};
+
 }  // namespace XBINARY_DEF
 #endif  // XBINARY_DEF_H
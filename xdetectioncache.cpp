@@ -0,0 +1,670 @@
+/* Copyright (c) 2017-2026 hors<horsicq@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "xdetectioncache.h"
+
+#include <QDataStream>
+
+#ifndef Q_OS_WIN
+#include <sys/stat.h>
+#endif
+
+static const quint32 _XDETECTIONCACHE_MAGIC = 0x43445800;  // "XDC"
+static const quint32 _XDETECTIONCACHE_FORMAT_VERSION = 3;
+static const quint32 _XDETECTIONCACHE_INITIAL_SLOTS = 1024;
+static const qint64 _XDETECTIONCACHE_CONTENT_BLOCK_SIZE = 0x10000;
+static const quint64 _XDETECTIONCACHE_MIN_FREE_SIZE = 0x100000;
+
+XDetectionCache::XDetectionCache(QObject *pParent) : QObject(pParent)
+{
+    m_pMap = nullptr;
+    m_nMapSize = 0;
+    m_keyMode = KEYMODE_IDENTITY;
+    m_nUserVersion = 0;
+    m_nNumberOfHits = 0;
+    m_nNumberOfMisses = 0;
+}
+
+XDetectionCache::~XDetectionCache()
+{
+    close();
+}
+
+bool XDetectionCache::open(const QString &sFileName, KEYMODE keyMode, quint32 nUserVersion)
+{
+    QMutexLocker locker(&m_mutex);
+
+    bool bResult = false;
+
+    _unmap();
+
+    if (m_file.isOpen()) {
+        m_file.close();
+    }
+
+    m_keyMode = keyMode;
+    m_nUserVersion = nUserVersion;
+    m_nNumberOfHits = 0;
+    m_nNumberOfMisses = 0;
+
+    m_file.setFileName(sFileName);
+
+    if (m_file.open(QIODevice::ReadWrite)) {
+        bool bIsValid = false;
+
+        if ((m_file.size() >= (qint64)sizeof(HEADER)) && _map()) {
+            HEADER *pHeader = _getHeader();
+
+            qint64 nDataStart = (qint64)sizeof(HEADER) + (qint64)pHeader->nNumberOfSlots * (qint64)sizeof(SLOT);
+
+            bIsValid = (pHeader->nMagic == _XDETECTIONCACHE_MAGIC) && (pHeader->nFormatVersion == _XDETECTIONCACHE_FORMAT_VERSION) &&
+                       (pHeader->nLogicVersion == XDETECTIONCACHE_LOGIC_VERSION) && (pHeader->nUserVersion == m_nUserVersion) &&
+                       (pHeader->nKeyMode == (quint32)m_keyMode) && (pHeader->nNumberOfSlots != 0) &&
+                       (m_file.size() >= (nDataStart + (qint64)pHeader->nDataSize));
+        }
+
+        if (bIsValid) {
+            bResult = true;
+        } else {
+            // Unknown, damaged or written by another detection logic: start over
+            bResult = _create(_XDETECTIONCACHE_INITIAL_SLOTS);
+        }
+
+        if (!bResult) {
+            _unmap();
+            m_file.close();
+        }
+    }
+
+    return bResult;
+}
+
+void XDetectionCache::close()
+{
+    QMutexLocker locker(&m_mutex);
+
+    _unmap();
+
+    if (m_file.isOpen()) {
+        m_file.close();
+    }
+}
+
+bool XDetectionCache::isOpen()
+{
+    QMutexLocker locker(&m_mutex);
+
+    return (m_pMap != nullptr);
+}
+
+void XDetectionCache::clear()
+{
+    QMutexLocker locker(&m_mutex);
+
+    if (m_pMap) {
+        _create(_XDETECTIONCACHE_INITIAL_SLOTS);
+    }
+}
+
+QSet<XBinary::FT> XDetectionCache::getFileTypes(QFile *pFile, bool bExtra, XBinary::PDSTRUCT *pPdStruct)
+{
+    QSet<XBinary::FT> stResult;
+
+    SLOT key = {};
+    QByteArray baData;
+    bool bIsKeyValid = _getKey(pFile, bExtra ? QUERY_FILETYPES_EXTRA : QUERY_FILETYPES, &key, pPdStruct);
+
+    if (bIsKeyValid && _find(key, &baData)) {
+        stResult = _dataToFileTypes(baData);
+    } else {
+        stResult = XFormats::getFileTypes(pFile, bExtra, pPdStruct);
+
+        if (bIsKeyValid && XBinary::isPdStructNotCanceled(pPdStruct)) {
+            _insert(key, _fileTypesToData(stResult));
+        }
+    }
+
+    return stResult;
+}
+
+QSet<XBinary::FT> XDetectionCache::getFileTypes(const QString &sFileName, bool bExtra, XBinary::PDSTRUCT *pPdStruct)
+{
+    QSet<XBinary::FT> stResult;
+
+    QFile file;
+    file.setFileName(sFileName);
+
+    if (file.open(QIODevice::ReadOnly)) {
+        stResult = getFileTypes(&file, bExtra, pPdStruct);
+
+        file.close();
+    }
+
+    return stResult;
+}
+
+XBinary::FILEFORMATINFO XDetectionCache::getFileFormatInfo(XBinary::FT fileType, QFile *pFile, XBinary::PDSTRUCT *pPdStruct)
+{
+    XBinary::FILEFORMATINFO result = {};
+
+    SLOT key = {};
+    QByteArray baData;
+    bool bIsKeyValid = _getKey(pFile, (QUERY_FILEFORMATINFO << 16) | (quint16)fileType, &key, pPdStruct);
+
+    if (bIsKeyValid && _find(key, &baData)) {
+        result = _dataToFileFormatInfo(baData);
+    } else {
+        result = XFormats::getFileFormatInfo(fileType, pFile, false, -1, pPdStruct);
+
+        if (bIsKeyValid && XBinary::isPdStructNotCanceled(pPdStruct)) {
+            _insert(key, _fileFormatInfoToData(result));
+        }
+    }
+
+    return result;
+}
+
+XBinary::FILEFORMATINFO XDetectionCache::getFileFormatInfo(XBinary::FT fileType, const QString &sFileName, XBinary::PDSTRUCT *pPdStruct)
+{
+    XBinary::FILEFORMATINFO result = {};
+
+    QFile file;
+    file.setFileName(sFileName);
+
+    if (file.open(QIODevice::ReadOnly)) {
+        result = getFileFormatInfo(fileType, &file, pPdStruct);
+
+        file.close();
+    }
+
+    return result;
+}
+
+qint32 XDetectionCache::getNumberOfRecords()
+{
+    QMutexLocker locker(&m_mutex);
+
+    qint32 nResult = 0;
+
+    if (m_pMap) {
+        nResult = _getHeader()->nNumberOfRecords;
+    }
+
+    return nResult;
+}
+
+qint64 XDetectionCache::getNumberOfHits()
+{
+    QMutexLocker locker(&m_mutex);
+
+    return m_nNumberOfHits;
+}
+
+qint64 XDetectionCache::getNumberOfMisses()
+{
+    QMutexLocker locker(&m_mutex);
+
+    return m_nNumberOfMisses;
+}
+
+bool XDetectionCache::_getKey(QFile *pFile, quint32 nKind, SLOT *pKey, XBinary::PDSTRUCT *pPdStruct)
+{
+    bool bResult = false;
+
+    *pKey = {};
+    pKey->nKind = nKind;
+
+    if (m_keyMode == KEYMODE_IDENTITY) {
+#ifndef Q_OS_WIN
+        struct stat st = {};
+
+        if (fstat(pFile->handle(), &st) == 0) {
+            pKey->nDevice = (quint64)st.st_dev;
+            pKey->nInode = (quint64)st.st_ino;
+            pKey->nSize = (qint64)st.st_size;
+#if defined(Q_OS_MAC)
+            pKey->nMTime = (qint64)st.st_mtimespec.tv_sec * 1000000000 + st.st_mtimespec.tv_nsec;
+#elif defined(Q_OS_LINUX) || defined(Q_OS_FREEBSD)
+            pKey->nMTime = (qint64)st.st_mtim.tv_sec * 1000000000 + st.st_mtim.tv_nsec;
+#else
+            pKey->nMTime = (qint64)st.st_mtime * 1000000000;
+#endif
+            bResult = true;
+        }
+#else
+        // No inode numbers through Qt; the absolute path stands in for them
+        QFileInfo fi(pFile->fileName());
+
+        if (fi.exists()) {
+            QByteArray baPath = fi.absoluteFilePath().toLower().toUtf8();
+            quint64 nHash = 0xCBF29CE484222325ULL;
+
+            for (qint32 i = 0; i < baPath.size(); i++) {
+                nHash ^= (quint8)baPath.at(i);
+                nHash *= 0x100000001B3ULL;
+            }
+
+            pKey->nInode = nHash;
+            pKey->nSize = fi.size();
+            pKey->nMTime = fi.lastModified().toMSecsSinceEpoch() * 1000000;
+            bResult = true;
+        }
+#endif
+    } else if (m_keyMode == KEYMODE_CONTENT) {
+        qint64 nPos = pFile->pos();
+        qint64 nSize = pFile->size();
+
+        // A lookup must cost less than the detection it saves, so only the head and the tail are hashed (detection reads
+        // headers and overlays); a 32-bit checksum would collide too often between files of the same size
+        QList<XBinary::OFFSETSIZE> listParts;
+
+        if (nSize <= 2 * _XDETECTIONCACHE_CONTENT_BLOCK_SIZE) {
+            listParts.append({0, nSize});
+        } else {
+            listParts.append({0, _XDETECTIONCACHE_CONTENT_BLOCK_SIZE});
+            listParts.append({nSize - _XDETECTIONCACHE_CONTENT_BLOCK_SIZE, _XDETECTIONCACHE_CONTENT_BLOCK_SIZE});
+        }
+
+        XBinary binary(pFile);
+        QByteArray baDigest = QByteArray::fromHex(binary.getHash(XBinary::HASH_SHA1, &listParts, pPdStruct).toLatin1());
+
+        pFile->seek(nPos);
+
+        if ((baDigest.size() >= 16) && XBinary::isPdStructNotCanceled(pPdStruct)) {
+            pKey->nSize = nSize;
+            pKey->nDevice = qFromLittleEndian<quint64>((const uchar *)baDigest.constData());
+            pKey->nInode = qFromLittleEndian<quint64>((const uchar *)baDigest.constData() + 8);
+
+            bResult = true;
+        }
+    }
+
+    return bResult;
+}
+
+bool XDetectionCache::_find(const SLOT &key, QByteArray *pbaData)
+{
+    QMutexLocker locker(&m_mutex);
+
+    bool bResult = false;
+
+    if (m_pMap) {
+        qint32 nIndex = _findSlot(key);
+
+        if (nIndex != -1) {
+            SLOT *pSlot = _getSlots() + nIndex;
+
+            if (pSlot->nKind && _isSameEntry(*pSlot, key) && _isSlotDataValid(pSlot)) {
+                *pbaData = QByteArray((const char *)(m_pMap + pSlot->nDataOffset), pSlot->nDataSize);
+                bResult = true;
+            }
+        }
+
+        if (bResult) {
+            m_nNumberOfHits++;
+        } else {
+            m_nNumberOfMisses++;
+        }
+    }
+
+    return bResult;
+}
+
+void XDetectionCache::_insert(const SLOT &key, const QByteArray &baData)
+{
+    QMutexLocker locker(&m_mutex);
+
+    if (m_pMap) {
+        HEADER *pHeader = _getHeader();
+
+        // Keep the load factor under 3/4 so probe sequences stay short
+        if ((pHeader->nNumberOfRecords + 1) * 4 > pHeader->nNumberOfSlots * 3) {
+            _rehash(pHeader->nNumberOfSlots * 2);
+        }
+    }
+
+    if (m_pMap) {
+        qint32 nIndex = _findSlot(key);
+
+        if (nIndex != -1) {
+            SLOT *pSlot = _getSlots() + nIndex;
+            bool bIsNew = (pSlot->nKind == 0);
+            bool bIsOldDataValid = (!bIsNew) && _isSlotDataValid(pSlot);
+            quint32 nOldDataSize = pSlot->nDataSize;
+            quint64 nDataOffset = 0;
+
+            if (bIsOldDataValid && (nOldDataSize >= (quint32)baData.size())) {
+                // Same file, changed content: the old data block is big enough
+                nDataOffset = pSlot->nDataOffset;
+                _getHeader()->nFreeSize += nOldDataSize - (quint32)baData.size();
+            } else {
+                qint64 nDataStart = (qint64)sizeof(HEADER) + (qint64)_getHeader()->nNumberOfSlots * (qint64)sizeof(SLOT);
+                nDataOffset = nDataStart + _getHeader()->nDataSize;
+
+                qint64 nNewSize = nDataOffset + baData.size();
+
+                if (nNewSize > m_nMapSize) {
+                    // Grow by half so that a run of misses does not remap the file every time
+                    qint64 nFileSize = qMax(nNewSize, m_nMapSize + m_nMapSize / 2);
+
+                    _unmap();
+
+                    if (!(m_file.resize(nFileSize) && _map())) {
+                        _unmap();
+                        nIndex = -1;
+                    }
+                }
+
+                if (nIndex != -1) {
+                    _getHeader()->nDataSize += baData.size();
+
+                    if (bIsOldDataValid) {
+                        _getHeader()->nFreeSize += nOldDataSize;
+                    }
+                }
+            }
+
+            if ((nIndex != -1) && m_pMap) {
+                memcpy(m_pMap + nDataOffset, baData.constData(), baData.size());
+
+                pSlot = _getSlots() + nIndex;
+                *pSlot = key;
+                pSlot->nDataOffset = nDataOffset;
+                pSlot->nDataSize = baData.size();
+
+                if (bIsNew) {
+                    _getHeader()->nNumberOfRecords++;
+                }
+            }
+        }
+    }
+
+    if (m_pMap) {
+        HEADER *pHeader = _getHeader();
+
+        // Rewriting the data area drops the superseded blocks
+        if ((pHeader->nFreeSize >= _XDETECTIONCACHE_MIN_FREE_SIZE) && (pHeader->nFreeSize * 2 > pHeader->nDataSize)) {
+            _rehash(pHeader->nNumberOfSlots);
+        }
+    }
+}
+
+qint32 XDetectionCache::_findSlot(const SLOT &key)
+{
+    qint32 nResult = -1;
+
+    quint32 nNumberOfSlots = _getHeader()->nNumberOfSlots;
+    SLOT *pSlots = _getSlots();
+    quint32 nIndex = (quint32)(_getSlotHash(key) % nNumberOfSlots);
+
+    for (quint32 i = 0; i < nNumberOfSlots; i++) {
+        SLOT *pSlot = pSlots + nIndex;
+
+        if ((pSlot->nKind == 0) || ((pSlot->nKind == key.nKind) && (pSlot->nDevice == key.nDevice) && (pSlot->nInode == key.nInode))) {
+            nResult = nIndex;
+            break;
+        }
+
+        nIndex++;
+
+        if (nIndex == nNumberOfSlots) {
+            nIndex = 0;
+        }
+    }
+
+    return nResult;
+}
+
+bool XDetectionCache::_create(quint32 nNumberOfSlots)
+{
+    bool bResult = false;
+
+    _unmap();
+
+    qint64 nDataStart = (qint64)sizeof(HEADER) + (qint64)nNumberOfSlots * (qint64)sizeof(SLOT);
+
+    if (m_file.resize(0) && m_file.resize(nDataStart) && _map()) {
+        memset(m_pMap, 0, nDataStart);
+
+        HEADER *pHeader = _getHeader();
+        pHeader->nMagic = _XDETECTIONCACHE_MAGIC;
+        pHeader->nFormatVersion = _XDETECTIONCACHE_FORMAT_VERSION;
+        pHeader->nLogicVersion = XDETECTIONCACHE_LOGIC_VERSION;
+        pHeader->nUserVersion = m_nUserVersion;
+        pHeader->nKeyMode = m_keyMode;
+        pHeader->nNumberOfSlots = nNumberOfSlots;
+
+        bResult = true;
+    }
+
+    return bResult;
+}
+
+bool XDetectionCache::_map()
+{
+    m_nMapSize = m_file.size();
+    m_pMap = m_file.map(0, m_nMapSize);
+
+    return (m_pMap != nullptr);
+}
+
+void XDetectionCache::_unmap()
+{
+    if (m_pMap) {
+        m_file.unmap(m_pMap);
+        m_pMap = nullptr;
+        m_nMapSize = 0;
+    }
+}
+
+bool XDetectionCache::_rehash(quint32 nNumberOfSlots)
+{
+    QList<SLOT> listSlots;
+    QList<QByteArray> listData;
+
+    quint32 nOldNumberOfSlots = _getHeader()->nNumberOfSlots;
+    SLOT *pSlots = _getSlots();
+
+    for (quint32 i = 0; i < nOldNumberOfSlots; i++) {
+        if (pSlots[i].nKind && _isSlotDataValid(pSlots + i)) {
+            listSlots.append(pSlots[i]);
+            listData.append(QByteArray((const char *)(m_pMap + pSlots[i].nDataOffset), pSlots[i].nDataSize));
+        }
+    }
+
+    bool bResult = _create(nNumberOfSlots);
+
+    if (bResult) {
+        qint64 nDataStart = (qint64)sizeof(HEADER) + (qint64)nNumberOfSlots * (qint64)sizeof(SLOT);
+        qint64 nDataSize = 0;
+
+        qint32 nNumberOfRecords = listSlots.count();
+
+        for (qint32 i = 0; i < nNumberOfRecords; i++) {
+            nDataSize += listData.at(i).size();
+        }
+
+        _unmap();
+        bResult = m_file.resize(nDataStart + nDataSize) && _map();
+
+        if (bResult) {
+            qint64 nDataOffset = nDataStart;
+
+            for (qint32 i = 0; i < nNumberOfRecords; i++) {
+                qint32 nIndex = _findSlot(listSlots.at(i));
+
+                SLOT *pSlot = _getSlots() + nIndex;
+                *pSlot = listSlots.at(i);
+                pSlot->nDataOffset = nDataOffset;
+
+                memcpy(m_pMap + nDataOffset, listData.at(i).constData(), listData.at(i).size());
+
+                nDataOffset += listData.at(i).size();
+            }
+
+            _getHeader()->nNumberOfRecords = nNumberOfRecords;
+            _getHeader()->nDataSize = nDataSize;
+        }
+    }
+
+    return bResult;
+}
+
+XDetectionCache::HEADER *XDetectionCache::_getHeader()
+{
+    return (HEADER *)m_pMap;
+}
+
+XDetectionCache::SLOT *XDetectionCache::_getSlots()
+{
+    return (SLOT *)(m_pMap + sizeof(HEADER));
+}
+
+bool XDetectionCache::_isSlotDataValid(const SLOT *pSlot)
+{
+    // Damaged files can point anywhere; the data block has to be inside the data area of the mapping
+    quint64 nDataStart = (quint64)sizeof(HEADER) + (quint64)_getHeader()->nNumberOfSlots * (quint64)sizeof(SLOT);
+    quint64 nDataEnd = qMin((quint64)m_nMapSize, nDataStart + _getHeader()->nDataSize);
+
+    return (pSlot->nDataOffset >= nDataStart) && (pSlot->nDataOffset <= nDataEnd) && (pSlot->nDataSize <= (nDataEnd - pSlot->nDataOffset));
+}
+
+quint64 XDetectionCache::_getSlotHash(const SLOT &key)
+{
+    // splitmix64 finalizer over the identity fields
+    quint64 nResult = key.nDevice ^ (key.nInode * 0x9E3779B97F4A7C15ULL) ^ ((quint64)key.nKind << 48);
+
+    nResult ^= nResult >> 30;
+    nResult *= 0xBF58476D1CE4E5B9ULL;
+    nResult ^= nResult >> 27;
+    nResult *= 0x94D049BB133111EBULL;
+    nResult ^= nResult >> 31;
+
+    return nResult;
+}
+
+bool XDetectionCache::_isSameEntry(const SLOT &slot, const SLOT &key)
+{
+    return (slot.nKind == key.nKind) && (slot.nDevice == key.nDevice) && (slot.nInode == key.nInode) && (slot.nSize == key.nSize) && (slot.nMTime == key.nMTime);
+}
+
+QByteArray XDetectionCache::_fileTypesToData(const QSet<XBinary::FT> &stFileTypes)
+{
+    QByteArray baResult;
+
+    QDataStream ds(&baResult, QIODevice::WriteOnly);
+
+    ds << (quint32)stFileTypes.count();
+
+    QSetIterator<XBinary::FT> it(stFileTypes);
+
+    while (it.hasNext()) {
+        ds << (quint32)it.next();
+    }
+
+    return baResult;
+}
+
+QSet<XBinary::FT> XDetectionCache::_dataToFileTypes(const QByteArray &baData)
+{
+    QSet<XBinary::FT> stResult;
+
+    QDataStream ds(baData);
+
+    quint32 nNumberOfRecords = 0;
+    ds >> nNumberOfRecords;
+
+    for (quint32 i = 0; (i < nNumberOfRecords) && (ds.status() == QDataStream::Ok); i++) {
+        quint32 nValue = 0;
+        ds >> nValue;
+
+        stResult.insert((XBinary::FT)nValue);
+    }
+
+    return stResult;
+}
+
+QByteArray XDetectionCache::_fileFormatInfoToData(const XBinary::FILEFORMATINFO &fileFormatInfo)
+{
+    QByteArray baResult;
+
+    QDataStream ds(&baResult, QIODevice::WriteOnly);
+
+    ds << fileFormatInfo.bIsValid;
+    ds << fileFormatInfo.nSize;
+    ds << (quint32)fileFormatInfo.fileType;
+    ds << fileFormatInfo.sExt;
+    ds << fileFormatInfo.sVersion;
+    ds << fileFormatInfo.sInfo;
+    ds << fileFormatInfo.sType;
+    ds << (quint32)fileFormatInfo.endian;
+    ds << fileFormatInfo.sMIME;
+    ds << (quint32)fileFormatInfo.mode;
+    ds << fileFormatInfo.sArch;
+    ds << (quint32)fileFormatInfo.osName;
+    ds << fileFormatInfo.sOsVersion;
+    ds << fileFormatInfo.sOsBuild;
+    ds << fileFormatInfo.bIsVM;
+    ds << fileFormatInfo.bIsEncrypted;
+    ds << fileFormatInfo.sCompresionMethod;
+
+    return baResult;
+}
+
+XBinary::FILEFORMATINFO XDetectionCache::_dataToFileFormatInfo(const QByteArray &baData)
+{
+    XBinary::FILEFORMATINFO result = {};
+
+    QDataStream ds(baData);
+
+    quint32 nFileType = 0;
+    quint32 nEndian = 0;
+    quint32 nMode = 0;
+    quint32 nOsName = 0;
+
+    ds >> result.bIsValid;
+    ds >> result.nSize;
+    ds >> nFileType;
+    ds >> result.sExt;
+    ds >> result.sVersion;
+    ds >> result.sInfo;
+    ds >> result.sType;
+    ds >> nEndian;
+    ds >> result.sMIME;
+    ds >> nMode;
+    ds >> result.sArch;
+    ds >> nOsName;
+    ds >> result.sOsVersion;
+    ds >> result.sOsBuild;
+    ds >> result.bIsVM;
+    ds >> result.bIsEncrypted;
+    ds >> result.sCompresionMethod;
+
+    result.fileType = (XBinary::FT)nFileType;
+    result.endian = (XBinary::ENDIAN)nEndian;
+    result.mode = (XBinary::MODE)nMode;
+    result.osName = (XBinary::OSNAME)nOsName;
+
+    if (ds.status() != QDataStream::Ok) {
+        result = {};
+    }
+
+    return result;
+}
@@ -0,0 +1,121 @@
+/* Copyright (c) 2017-2026 hors<horsicq@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef XDETECTIONCACHE_H
+#define XDETECTIONCACHE_H
+
+#include <QMutex>
+
+#include "xformats.h"
+
+// Bump whenever getFileTypes/getFileFormatInfo can return something different for the same file.
+// Cache files written with another value are discarded on open.
+#define XDETECTIONCACHE_LOGIC_VERSION 1
+
+// Persistent cache in front of XFormats::getFileTypes and XFormats::getFileFormatInfo.
+// The cache file is a memory-mapped open-addressing hash table followed by a data area with the serialized results.
+// Entries are keyed on (device, inode) and validated against (size, mtime), or keyed on size and SHA-1 of the first and last 64 KiB.
+// Safe to share between threads of one process; not safe to share between processes.
+class XDetectionCache : public QObject {
+    Q_OBJECT
+
+public:
+    enum KEYMODE {
+        KEYMODE_IDENTITY = 0,
+        KEYMODE_CONTENT
+    };
+
+    explicit XDetectionCache(QObject *pParent = nullptr);
+    ~XDetectionCache();
+
+    bool open(const QString &sFileName, KEYMODE keyMode = KEYMODE_IDENTITY, quint32 nUserVersion = 0);
+    void close();
+    bool isOpen();
+    void clear();
+
+    QSet<XBinary::FT> getFileTypes(QFile *pFile, bool bExtra = false, XBinary::PDSTRUCT *pPdStruct = nullptr);
+    QSet<XBinary::FT> getFileTypes(const QString &sFileName, bool bExtra = false, XBinary::PDSTRUCT *pPdStruct = nullptr);
+    XBinary::FILEFORMATINFO getFileFormatInfo(XBinary::FT fileType, QFile *pFile, XBinary::PDSTRUCT *pPdStruct = nullptr);
+    XBinary::FILEFORMATINFO getFileFormatInfo(XBinary::FT fileType, const QString &sFileName, XBinary::PDSTRUCT *pPdStruct = nullptr);
+
+    qint32 getNumberOfRecords();
+    qint64 getNumberOfHits();
+    qint64 getNumberOfMisses();
+
+private:
+    enum QUERY {
+        QUERY_FILETYPES = 1,
+        QUERY_FILETYPES_EXTRA,
+        QUERY_FILEFORMATINFO
+    };
+
+    struct HEADER {
+        quint32 nMagic;
+        quint32 nFormatVersion;
+        quint32 nLogicVersion;
+        quint32 nUserVersion;
+        quint32 nKeyMode;
+        quint32 nNumberOfSlots;
+        quint32 nNumberOfRecords;
+        quint32 nReserved;
+        quint64 nDataSize;  // Used part of the data area; the file can be longer
+        quint64 nFreeSize;  // Superseded data blocks; reclaimed by _rehash
+    };
+
+    struct SLOT {
+        quint64 nDevice;  // KEYMODE_CONTENT: SHA-1 of head and tail, bytes 0-7
+        quint64 nInode;   // KEYMODE_CONTENT: SHA-1 of head and tail, bytes 8-15
+        qint64 nSize;
+        qint64 nMTime;  // KEYMODE_CONTENT: 0
+        quint32 nKind;  // 0 => empty slot
+        quint32 nDataSize;
+        quint64 nDataOffset;
+    };
+
+    bool _getKey(QFile *pFile, quint32 nKind, SLOT *pKey, XBinary::PDSTRUCT *pPdStruct);
+    bool _find(const SLOT &key, QByteArray *pbaData);
+    void _insert(const SLOT &key, const QByteArray &baData);
+    qint32 _findSlot(const SLOT &key);
+    bool _create(quint32 nNumberOfSlots);
+    bool _map();
+    void _unmap();
+    bool _rehash(quint32 nNumberOfSlots);
+    HEADER *_getHeader();
+    SLOT *_getSlots();
+    bool _isSlotDataValid(const SLOT *pSlot);
+    static quint64 _getSlotHash(const SLOT &key);
+    static bool _isSameEntry(const SLOT &slot, const SLOT &key);
+    static QByteArray _fileTypesToData(const QSet<XBinary::FT> &stFileTypes);
+    static QSet<XBinary::FT> _dataToFileTypes(const QByteArray &baData);
+    static QByteArray _fileFormatInfoToData(const XBinary::FILEFORMATINFO &fileFormatInfo);
+    static XBinary::FILEFORMATINFO _dataToFileFormatInfo(const QByteArray &baData);
+
+private:
+    QFile m_file;
+    uchar *m_pMap;
+    qint64 m_nMapSize;
+    KEYMODE m_keyMode;
+    quint32 m_nUserVersion;
+    qint64 m_nNumberOfHits;
+    qint64 m_nNumberOfMisses;
+    QMutex m_mutex;
+};
+
+#endif  // XDETECTIONCACHE_H
@@ -0,0 +1,334 @@
+/* Copyright (c) 2017-2026 hors<horsicq@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "xfiletypescanner.h"
+
+#include <QDirIterator>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRunnable>
+#include <QThread>
+#include <QThreadPool>
+#include <algorithm>
+
+// Files are handed out in small batches: one lock round-trip per batch instead of per file.
+static const qint32 _XFILETYPESCANNER_BATCH = 8;
+
+class _XFileTypeScannerWorker : public QRunnable {
+public:
+    _XFileTypeScannerWorker(XFileTypeScanner *pScanner, XBinary::PDSTRUCT *pPdStruct)
+    {
+        m_pScanner = pScanner;
+        m_pPdStruct = pPdStruct;
+    }
+
+    virtual void run()
+    {
+        QList<QString> listFileNames;
+
+        while (m_pScanner->_dequeue(&listFileNames, _XFILETYPESCANNER_BATCH)) {
+            qint32 nNumberOfFiles = listFileNames.count();
+
+            for (qint32 i = 0; (i < nNumberOfFiles) && (!XFileTypeScanner::_isStopped(m_pPdStruct)); i++) {
+                XFileTypeScanner::RESULT result = XFileTypeScanner::scanFile(listFileNames.at(i), m_pScanner->m_options);
+
+                m_pScanner->_writeResult(result);
+            }
+
+            listFileNames.clear();
+
+            if (XFileTypeScanner::_isStopped(m_pPdStruct)) {
+                break;
+            }
+        }
+    }
+
+private:
+    XFileTypeScanner *m_pScanner;
+    XBinary::PDSTRUCT *m_pPdStruct;
+};
+
+XFileTypeScanner::XFileTypeScanner(QObject *pParent) : QObject(pParent)
+{
+    m_options = getDefaultOptions();
+    m_pOutput = nullptr;
+    m_nQueueSize = 0;
+    m_bIsQueueFinished = false;
+    m_nNumberOfProcessed = 0;
+}
+
+XFileTypeScanner::OPTIONS XFileTypeScanner::getDefaultOptions()
+{
+    OPTIONS result = {};
+
+    result.bExtra = true;
+    result.bSubdirectories = true;
+    result.nNumberOfThreads = 0;
+    result.nQueueSize = 0;
+    result.pDetectionCache = nullptr;
+    result.nReadBudgetBytes = 0;
+    result.nReadBudgetCalls = 0;
+
+    return result;
+}
+
+void XFileTypeScanner::setOptions(const OPTIONS &options)
+{
+    m_options = options;
+}
+
+XFileTypeScanner::OPTIONS XFileTypeScanner::getOptions()
+{
+    return m_options;
+}
+
+qint64 XFileTypeScanner::scan(const QList<QString> &listPaths, QIODevice *pOutput, XBinary::PDSTRUCT *pPdStruct)
+{
+    qint32 nNumberOfThreads = m_options.nNumberOfThreads;
+
+    if (nNumberOfThreads <= 0) {
+        nNumberOfThreads = qMax(1, QThread::idealThreadCount());
+    }
+
+    m_pOutput = pOutput;
+    m_queue.clear();
+    m_nQueueSize = m_options.nQueueSize;
+
+    if (m_nQueueSize <= 0) {
+        m_nQueueSize = nNumberOfThreads * 64;
+    }
+
+    m_bIsQueueFinished = false;
+    m_nNumberOfProcessed = 0;
+
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(nNumberOfThreads);
+
+    for (qint32 i = 0; i < nNumberOfThreads; i++) {
+        threadPool.start(new _XFileTypeScannerWorker(this, pPdStruct));
+    }
+
+    // The calling thread walks the paths and feeds the queue
+    qint32 nNumberOfPaths = listPaths.count();
+
+    for (qint32 i = 0; (i < nNumberOfPaths) && (!_isStopped(pPdStruct)); i++) {
+        _enqueuePath(listPaths.at(i), pPdStruct);
+    }
+
+    m_queueMutex.lock();
+    m_bIsQueueFinished = true;
+    m_queueNotEmpty.wakeAll();
+    m_queueMutex.unlock();
+
+    threadPool.waitForDone();
+
+    m_pOutput = nullptr;
+
+    return m_nNumberOfProcessed;
+}
+
+qint64 XFileTypeScanner::scanToDevice(const QList<QString> &listPaths, QIODevice *pOutput, const OPTIONS &options, XBinary::PDSTRUCT *pPdStruct)
+{
+    XFileTypeScanner scanner;
+    scanner.setOptions(options);
+
+    return scanner.scan(listPaths, pOutput, pPdStruct);
+}
+
+qint64 XFileTypeScanner::scanToFile(const QList<QString> &listPaths, const QString &sResultFileName, const OPTIONS &options, XBinary::PDSTRUCT *pPdStruct)
+{
+    qint64 nResult = -1;
+
+    QFile file;
+    file.setFileName(sResultFileName);
+
+    if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        nResult = scanToDevice(listPaths, &file, options, pPdStruct);
+
+        file.close();
+    }
+
+    return nResult;
+}
+
+XFileTypeScanner::RESULT XFileTypeScanner::scanFile(const QString &sFileName, const OPTIONS &options)
+{
+    RESULT result = {};
+    result.sFileName = sFileName;
+
+    XBinary::PDSTRUCT pdStruct = XBinary::createPdStruct();
+    XBinary::setPdStructReadBudget(&pdStruct, options.nReadBudgetBytes, options.nReadBudgetCalls);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QFile file;
+    file.setFileName(sFileName);
+
+    if (file.open(QIODevice::ReadOnly)) {
+        result.nSize = file.size();
+
+        if (options.pDetectionCache) {
+            result.stFileTypes = options.pDetectionCache->getFileTypes(&file, options.bExtra, &pdStruct);
+        } else {
+            result.stFileTypes = XFormats::getFileTypes(&file, options.bExtra, &pdStruct);
+        }
+
+        result.bIsValid = true;
+
+        file.close();
+    }
+
+    result.nElapsedUs = timer.nsecsElapsed() / 1000;
+    result.nBytesRead = pdStruct.nBytesRead;
+    result.nReadCalls = pdStruct.nReadCalls;
+    result.bIsBudgetExceeded = pdStruct.bIsBudgetExceeded;
+    result.listSkippedChecks = pdStruct.listSkippedChecks;
+
+    return result;
+}
+
+QByteArray XFileTypeScanner::resultToJson(const RESULT &result)
+{
+    QList<XBinary::FT> listFileTypes = result.stFileTypes.values();
+    std::sort(listFileTypes.begin(), listFileTypes.end());
+
+    QJsonArray jsArrayTypes;
+
+    qint32 nNumberOfTypes = listFileTypes.count();
+
+    for (qint32 i = 0; i < nNumberOfTypes; i++) {
+        jsArrayTypes.append(XBinary::fileTypeIdToFtString(listFileTypes.at(i)));
+    }
+
+    QJsonObject jsObject;
+    jsObject.insert("path", result.sFileName);
+    jsObject.insert("size", result.nSize);
+    jsObject.insert("types", jsArrayTypes);
+    jsObject.insert("elapsed_us", result.nElapsedUs);
+    jsObject.insert("bytes_read", result.nBytesRead);
+    jsObject.insert("read_calls", result.nReadCalls);
+
+    if (result.bIsBudgetExceeded) {
+        QJsonArray jsArraySkipped;
+
+        qint32 nNumberOfSkipped = result.listSkippedChecks.count();
+
+        for (qint32 i = 0; i < nNumberOfSkipped; i++) {
+            jsArraySkipped.append(XBinary::fileTypeIdToFtString(result.listSkippedChecks.at(i)));
+        }
+
+        jsObject.insert("budget_exceeded", true);
+        jsObject.insert("skipped", jsArraySkipped);
+    }
+
+    if (!result.bIsValid) {
+        jsObject.insert("error", QString("Cannot open file"));
+    }
+
+    QByteArray baResult = QJsonDocument(jsObject).toJson(QJsonDocument::Compact);
+    baResult.append('\n');
+
+    return baResult;
+}
+
+void XFileTypeScanner::_enqueue(const QString &sFileName, XBinary::PDSTRUCT *pPdStruct)
+{
+    m_queueMutex.lock();
+
+    // Backpressure: the walker sleeps while the queue is full. The timeout lets it notice a stop request.
+    while ((m_queue.count() >= m_nQueueSize) && (!_isStopped(pPdStruct))) {
+        m_queueNotFull.wait(&m_queueMutex, 100);
+    }
+
+    if (!_isStopped(pPdStruct)) {
+        m_queue.enqueue(sFileName);
+        m_queueNotEmpty.wakeOne();
+    }
+
+    m_queueMutex.unlock();
+}
+
+void XFileTypeScanner::_enqueuePath(const QString &sPath, XBinary::PDSTRUCT *pPdStruct)
+{
+    QFileInfo fi(sPath);
+
+    if (fi.isFile()) {
+        _enqueue(fi.absoluteFilePath(), pPdStruct);
+    } else if (fi.isDir()) {
+        QDirIterator::IteratorFlags flags = QDirIterator::NoIteratorFlags;
+
+        if (m_options.bSubdirectories) {
+            flags = QDirIterator::Subdirectories;
+        }
+
+        QDirIterator it(fi.absoluteFilePath(), QDir::Files | QDir::Hidden | QDir::System | QDir::NoDotAndDotDot, flags);
+
+        while (it.hasNext() && (!_isStopped(pPdStruct))) {
+            _enqueue(it.next(), pPdStruct);
+        }
+    }
+}
+
+qint32 XFileTypeScanner::_dequeue(QList<QString> *pListFileNames, qint32 nMaxCount)
+{
+    qint32 nResult = 0;
+
+    m_queueMutex.lock();
+
+    while (m_queue.isEmpty() && (!m_bIsQueueFinished)) {
+        m_queueNotEmpty.wait(&m_queueMutex);
+    }
+
+    while ((nResult < nMaxCount) && (!m_queue.isEmpty())) {
+        pListFileNames->append(m_queue.dequeue());
+        nResult++;
+    }
+
+    if (nResult) {
+        m_queueNotFull.wakeOne();
+    }
+
+    m_queueMutex.unlock();
+
+    return nResult;
+}
+
+void XFileTypeScanner::_writeResult(const RESULT &result)
+{
+    // Serialize outside the lock; only the write itself is ordered
+    QByteArray baLine = resultToJson(result);
+
+    m_outputMutex.lock();
+
+    if (m_pOutput) {
+        m_pOutput->write(baLine);
+    }
+
+    m_nNumberOfProcessed++;
+
+    m_outputMutex.unlock();
+}
+
+bool XFileTypeScanner::_isStopped(XBinary::PDSTRUCT *pPdStruct)
+{
+    return (pPdStruct && pPdStruct->bIsStop);
+}
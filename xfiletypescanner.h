@@ -0,0 +1,97 @@
+/* Copyright (c) 2017-2026 hors<horsicq@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef XFILETYPESCANNER_H
+#define XFILETYPESCANNER_H
+
+#include <QMutex>
+#include <QQueue>
+#include <QWaitCondition>
+
+#include "xdetectioncache.h"
+
+// Identifies file types of many files in parallel and streams one NDJSON line per file as soon as it is done:
+// {"path":"...","size":123,"types":["PE32","MSDOS"],"elapsed_us":42,"bytes_read":4096,"read_calls":9}
+// With a read budget, files that ran out of it also get "budget_exceeded":true and the "skipped" checks.
+// Directories are walked lazily into a bounded queue, so memory stays flat and the walker waits when the workers fall behind.
+class XFileTypeScanner : public QObject {
+    Q_OBJECT
+
+public:
+    struct OPTIONS {
+        bool bExtra;
+        bool bSubdirectories;
+        qint32 nNumberOfThreads;  // 0 => QThread::idealThreadCount()
+        qint32 nQueueSize;        // 0 => nNumberOfThreads * 64
+        XDetectionCache *pDetectionCache;  // Optional
+        qint64 nReadBudgetBytes;           // Per file; 0 => unlimited
+        qint64 nReadBudgetCalls;           // Per file; 0 => unlimited
+    };
+
+    struct RESULT {
+        QString sFileName;
+        qint64 nSize;
+        QSet<XBinary::FT> stFileTypes;
+        qint64 nElapsedUs;
+        qint64 nBytesRead;
+        qint64 nReadCalls;
+        bool bIsBudgetExceeded;
+        QList<XBinary::FT> listSkippedChecks;
+        bool bIsValid;
+    };
+
+    explicit XFileTypeScanner(QObject *pParent = nullptr);
+
+    static OPTIONS getDefaultOptions();
+
+    void setOptions(const OPTIONS &options);
+    OPTIONS getOptions();
+
+    qint64 scan(const QList<QString> &listPaths, QIODevice *pOutput, XBinary::PDSTRUCT *pPdStruct = nullptr);
+
+    static qint64 scanToDevice(const QList<QString> &listPaths, QIODevice *pOutput, const OPTIONS &options, XBinary::PDSTRUCT *pPdStruct = nullptr);
+    static qint64 scanToFile(const QList<QString> &listPaths, const QString &sResultFileName, const OPTIONS &options, XBinary::PDSTRUCT *pPdStruct = nullptr);
+
+    static RESULT scanFile(const QString &sFileName, const OPTIONS &options);
+    static QByteArray resultToJson(const RESULT &result);
+
+private:
+    friend class _XFileTypeScannerWorker;
+
+    void _enqueue(const QString &sFileName, XBinary::PDSTRUCT *pPdStruct);
+    void _enqueuePath(const QString &sPath, XBinary::PDSTRUCT *pPdStruct);
+    qint32 _dequeue(QList<QString> *pListFileNames, qint32 nMaxCount);
+    void _writeResult(const RESULT &result);
+    static bool _isStopped(XBinary::PDSTRUCT *pPdStruct);
+
+private:
+    OPTIONS m_options;
+    QIODevice *m_pOutput;
+    QQueue<QString> m_queue;
+    qint32 m_nQueueSize;
+    bool m_bIsQueueFinished;
+    QMutex m_queueMutex;
+    QWaitCondition m_queueNotEmpty;
+    QWaitCondition m_queueNotFull;
+    QMutex m_outputMutex;
+    qint64 m_nNumberOfProcessed;
+};
+
+#endif  // XFILETYPESCANNER_H
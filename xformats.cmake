@@ -40,6 +40,16 @@ set(XFORMATS_SOURCES
     ${CMAKE_CURRENT_LIST_DIR}/xbinary_def.h
     ${CMAKE_CURRENT_LIST_DIR}/subdevice.cpp
     ${CMAKE_CURRENT_LIST_DIR}/subdevice.h
+    ${CMAKE_CURRENT_LIST_DIR}/xmappeddevice.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/xmappeddevice.h
+    ${CMAKE_CURRENT_LIST_DIR}/xoverlaydevice.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/xoverlaydevice.h
+    ${CMAKE_CURRENT_LIST_DIR}/xpagecache.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/xpagecache.h
+    ${CMAKE_CURRENT_LIST_DIR}/xdetectioncache.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/xdetectioncache.h
+    ${CMAKE_CURRENT_LIST_DIR}/xfiletypescanner.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/xfiletypescanner.h
     ${CMAKE_CURRENT_LIST_DIR}/xformats.cpp
     ${CMAKE_CURRENT_LIST_DIR}/xformats.h
     ${CMAKE_CURRENT_LIST_DIR}/audio/xmp3.cpp
@@ -115,10 +115,14 @@ bool XFormats::isValid(XBinary::FT fileType, QIODevice *pDevice, bool bIsImage,
 {
     bool bResult = false;
 
+    XBinary::PDSTRUCT *pReadBudget = XBinary::beginReadBudget(pPdStruct);
+
     XBinary *pBinary = XFormats::getClass(fileType, pDevice, bIsImage, nModuleAddress);
     bResult = pBinary->isValid(pPdStruct);
     delete pBinary;
 
+    XBinary::endReadBudget(pReadBudget);
+
     return bResult;
 }
 
@@ -282,7 +286,13 @@ QSet<XBinary::FT> XFormats::getFileTypes(QIODevice *pDevice, bool bExtra, XBinar
         pPdStruct = &pdStructEmpty;
     }
 
-    return _getFileTypes(pDevice, bExtra, pPdStruct);
+    XBinary::PDSTRUCT *pReadBudget = XBinary::beginReadBudget(pPdStruct);
+
+    QSet<XBinary::FT> stResult = _getFileTypes(pDevice, bExtra, pPdStruct);
+
+    XBinary::endReadBudget(pReadBudget);
+
+    return stResult;
 }
 
 bool XFormats::saveAllPEIconsToDirectory(QIODevice *pDevice, const QString &sDirectoryName)
@@ -470,6 +480,8 @@ XBinary::FILEFORMATINFO XFormats::getFileFormatInfo(XBinary::FT fileType, QIODev
 {
     XBinary::FILEFORMATINFO result = {};
 
+    XBinary::PDSTRUCT *pReadBudget = XBinary::beginReadBudget(pPdStruct);
+
     QIODevice *_pDevice = nullptr;
     SubDevice *pSubDevice = nullptr;
 
@@ -490,6 +502,8 @@ XBinary::FILEFORMATINFO XFormats::getFileFormatInfo(XBinary::FT fileType, QIODev
         delete pSubDevice;
     }
 
+    XBinary::endReadBudget(pReadBudget);
+
     return result;
 }
 
@@ -746,7 +760,7 @@ QSet<XBinary::FT> XFormats::_getFileTypes(QIODevice *pDevice, bool bExtra, XBina
             }
         }
     } else {
-        if (stResult.contains(XBinary::FT_ZIP)) {
+        if (stResult.contains(XBinary::FT_ZIP) && XBinary::isReadBudgetAvailable(XBinary::FT_ZIP)) {
             XZip xzip(pDevice);
 
             if (xzip.isValid(pPdStruct)) {
@@ -755,7 +769,7 @@ QSet<XBinary::FT> XFormats::_getFileTypes(QIODevice *pDevice, bool bExtra, XBina
                 // stResult += getFileTypesZIP(pDevice, &listArchiveRecords, pPdStruct);
                 stResult += getFileTypesZIP(pDevice, pPdStruct);
             }
-        } else if (stResult.contains(XBinary::FT_AR)) {
+        } else if (stResult.contains(XBinary::FT_AR) && XBinary::isReadBudgetAvailable(XBinary::FT_AR)) {
             X_Ar xar(pDevice);
 
             if (xar.isValid(pPdStruct)) {
@@ -763,7 +777,7 @@ QSet<XBinary::FT> XFormats::_getFileTypes(QIODevice *pDevice, bool bExtra, XBina
 
                 stResult += getFileTypesAR(pDevice, &listArchiveRecords, pPdStruct);
             }
-        } else if (stResult.contains(XBinary::FT_GZIP)) {
+        } else if (stResult.contains(XBinary::FT_GZIP) && XBinary::isReadBudgetAvailable(XBinary::FT_GZIP)) {
             // TODO Check
             if (pDevice->size() < 100000000) {
                 XGzip xgzip(pDevice);
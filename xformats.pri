@@ -18,9 +18,13 @@ contains(QT_ARCH, x86_64)|contains(QT_ARCH, i386) {
 }
 
 HEADERS += \
+    $$PWD/xdetectioncache.h \
+    $$PWD/xfiletypescanner.h \
     $$PWD/xformats.h
 
 SOURCES += \
+    $$PWD/xdetectioncache.cpp \
+    $$PWD/xfiletypescanner.cpp \
     $$PWD/xformats.cpp
 
 !contains(XCONFIG, xbinary) {
@@ -20,6 +20,10 @@
  */
 #include "xiodevice.h"
 
+#if defined(Q_OS_LINUX) || defined(Q_OS_FREEBSD) || defined(Q_OS_MAC)
+#include <fcntl.h>
+#endif
+
 XIODevice::XIODevice(QObject *pParent) : QIODevice(pParent)
 {
     m_nSize = 0;
@@ -36,7 +40,7 @@ void XIODevice::setInitLocation(quint64 nLocation)
     m_nInitLocation = nLocation;
 }
 
-quint64 XIODevice::getInitLocation()
+quint64 XIODevice::getInitLocation() const
 {
     return m_nInitLocation;
 }
@@ -102,6 +106,95 @@ qint64 XIODevice::pos() const
     return QIODevice::pos();
 }
 
+bool XIODevice::isPositional() const
+{
+    return false;
+}
+
+qint64 XIODevice::readAt(qint64 nPos, char *pData, qint64 nMaxSize)
+{
+    Q_UNUSED(nPos)
+    Q_UNUSED(pData)
+    Q_UNUSED(nMaxSize)
+
+    return -1;
+}
+
+XIODevice *XIODevice::getPositionalDevice(QIODevice *pDevice)
+{
+    XIODevice *pResult = dynamic_cast<XIODevice *>(pDevice);
+
+    if (pResult && (!pResult->isPositional())) {
+        pResult = nullptr;
+    }
+
+    return pResult;
+}
+
+const char *XIODevice::getMemory() const
+{
+    return nullptr;
+}
+
+const char *XIODevice::getDeviceMemory(QIODevice *pDevice)
+{
+    const char *pResult = nullptr;
+
+    XIODevice *pXDevice = dynamic_cast<XIODevice *>(pDevice);
+
+    if (pXDevice) {
+        pResult = pXDevice->getMemory();
+    } else {
+        QBuffer *pBuffer = dynamic_cast<QBuffer *>(pDevice);
+
+        // A writable buffer can be resized (XBinary::resize), which moves its data
+        if (pBuffer && (!pBuffer->isWritable())) {
+            pResult = pBuffer->data().data();
+        }
+    }
+
+    return pResult;
+}
+
+void XIODevice::prefetch(qint64 nPos, qint64 nSize)
+{
+    Q_UNUSED(nPos)
+    Q_UNUSED(nSize)
+}
+
+void XIODevice::prefetchFile(QFile *pFile, qint64 nPos, qint64 nSize)
+{
+    if (pFile && pFile->isOpen() && (nPos >= 0) && (nSize > 0)) {
+        int nHandle = pFile->handle();
+
+        if (nHandle != -1) {
+#if defined(Q_OS_LINUX) || defined(Q_OS_FREEBSD)
+            posix_fadvise(nHandle, (off_t)nPos, (off_t)nSize, POSIX_FADV_WILLNEED);
+#elif defined(Q_OS_MAC)
+            struct radvisory advisory = {};
+            advisory.ra_offset = (off_t)nPos;
+            advisory.ra_count = (int)qMin(nSize, (qint64)0x7FFFFFFF);
+            fcntl(nHandle, F_RDADVISE, &advisory);
+#endif
+        }
+    }
+}
+
+void XIODevice::prefetchDevice(QIODevice *pDevice, qint64 nPos, qint64 nSize)
+{
+    XIODevice *pXDevice = dynamic_cast<XIODevice *>(pDevice);
+
+    if (pXDevice) {
+        pXDevice->prefetch(nPos, nSize);
+    } else {
+        QFile *pFile = dynamic_cast<QFile *>(pDevice);
+
+        if (pFile) {
+            prefetchFile(pFile, nPos, nSize);
+        }
+    }
+}
+
 qint64 XIODevice::readData(char *pData, qint64 nMaxSize)
 {
     Q_UNUSED(pData)
@@ -21,6 +21,8 @@
 #ifndef XIODEVICE_H
 #define XIODEVICE_H
 
+#include <QBuffer>
+#include <QFile>
 #include <QIODevice>
 
 class XIODevice : public QIODevice {
@@ -31,7 +33,7 @@ public:
 
     void setSize(qint64 nSize);
     void setInitLocation(quint64 nLocation);
-    quint64 getInitLocation();
+    quint64 getInitLocation() const;
 
     static quint64 getInitLocation(QIODevice *pDevice);
 
@@ -44,6 +46,24 @@ public:
     virtual void close();
     virtual qint64 pos() const;
 
+    // Positional reads do not touch pos() and are safe to call from several threads
+    virtual bool isPositional() const;
+    virtual qint64 readAt(qint64 nPos, char *pData, qint64 nMaxSize);
+
+    static XIODevice *getPositionalDevice(QIODevice *pDevice);
+
+    // Pointer to the device data if it is resident in memory and cannot be resized, otherwise nullptr
+    virtual const char *getMemory() const;
+
+    // Also the data of a read-only QBuffer; writable QBuffers are read through the device
+    static const char *getDeviceMemory(QIODevice *pDevice);
+
+    // Hints that the range will be read soon; the data is loaded in the background
+    virtual void prefetch(qint64 nPos, qint64 nSize);
+
+    static void prefetchFile(QFile *pFile, qint64 nPos, qint64 nSize);
+    static void prefetchDevice(QIODevice *pDevice, qint64 nPos, qint64 nSize);
+
 protected:
     virtual qint64 readData(char *pData, qint64 nMaxSize);
     virtual qint64 writeData(const char *pData, qint64 nMaxSize);
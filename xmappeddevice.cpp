@@ -0,0 +1,199 @@
+/* Copyright (c) 2017-2026 hors<horsicq@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "xmappeddevice.h"
+
+#ifdef Q_OS_WIN
+#include <io.h>
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+XMappedDevice::XMappedDevice(const QString &sFileName, QObject *pParent) : XIODevice(pParent), m_file(sFileName)
+{
+    m_pMemory = nullptr;
+}
+
+XMappedDevice::~XMappedDevice()
+{
+    if (isOpen()) {
+        close();
+    }
+}
+
+QString XMappedDevice::getFileName() const
+{
+    return m_file.fileName();
+}
+
+const char *XMappedDevice::getMemory() const
+{
+    return (const char *)m_pMemory;
+}
+
+bool XMappedDevice::isMapped() const
+{
+    return (m_pMemory != nullptr);
+}
+
+bool XMappedDevice::open(OpenMode mode)
+{
+    bool bResult = false;
+
+    if (isOpen()) {
+        close();
+    }
+
+    // Mapping is read-only
+    if (!(mode & QIODevice::WriteOnly)) {
+        if (m_file.open(QIODevice::ReadOnly)) {
+            qint64 nSize = m_file.size();
+
+            setSize(nSize);
+
+            if (nSize > 0) {
+                m_pMemory = m_file.map(0, nSize);
+
+#ifdef QT_DEBUG
+                if (!m_pMemory) {
+                    qDebug("XMappedDevice::open(): cannot map %s", m_file.fileName().toUtf8().data());
+                }
+#endif
+            }
+
+            bResult = XIODevice::open(mode | QIODevice::Unbuffered);
+        } else {
+            setErrorString(m_file.errorString());
+        }
+    }
+
+    return bResult;
+}
+
+void XMappedDevice::close()
+{
+    if (m_pMemory) {
+        m_file.unmap(m_pMemory);
+        m_pMemory = nullptr;
+    }
+
+    m_file.close();
+    setSize(0);
+
+    XIODevice::close();
+}
+
+bool XMappedDevice::isPositional() const
+{
+    return true;
+}
+
+qint64 XMappedDevice::readAt(qint64 nPos, char *pData, qint64 nMaxSize)
+{
+    qint64 nResult = 0;
+
+    if (nPos >= 0) {
+        nMaxSize = qMin(nMaxSize, size() - nPos);
+    } else {
+        nMaxSize = 0;
+    }
+
+    if (nMaxSize > 0) {
+        if (m_pMemory) {
+            memcpy(pData, m_pMemory + nPos, (size_t)nMaxSize);
+            nResult = nMaxSize;
+        } else if (m_file.isOpen()) {
+            int nHandle = m_file.handle();
+#ifdef Q_OS_WIN
+            HANDLE hFile = (HANDLE)_get_osfhandle(nHandle);
+            OVERLAPPED overlapped = {};
+            overlapped.Offset = (DWORD)(nPos & 0xFFFFFFFF);
+            overlapped.OffsetHigh = (DWORD)(nPos >> 32);
+            DWORD nNumberOfBytesRead = 0;
+
+            if (ReadFile(hFile, pData, (DWORD)qMin(nMaxSize, (qint64)0x7FFFFFFF), &nNumberOfBytesRead, &overlapped)) {
+                nResult = nNumberOfBytesRead;
+            }
+#else
+            while (nMaxSize > 0) {
+                ssize_t nCurrent = pread(nHandle, pData, (size_t)nMaxSize, (off_t)nPos);
+
+                if (nCurrent <= 0) {
+                    break;
+                }
+
+                pData += nCurrent;
+                nPos += nCurrent;
+                nMaxSize -= nCurrent;
+                nResult += nCurrent;
+            }
+#endif
+        }
+    }
+
+    return nResult;
+}
+
+void XMappedDevice::prefetch(qint64 nPos, qint64 nSize)
+{
+    if (nPos >= 0) {
+        nSize = qMin(nSize, size() - nPos);
+    } else {
+        nSize = 0;
+    }
+
+    if (nSize > 0) {
+        if (m_pMemory) {
+#ifndef Q_OS_WIN
+            // madvise needs a page aligned address
+            qint64 nPageSize = sysconf(_SC_PAGESIZE);
+
+            if (nPageSize > 0) {
+                qint64 nDelta = nPos % nPageSize;
+
+                madvise(m_pMemory + nPos - nDelta, (size_t)(nSize + nDelta), MADV_WILLNEED);
+            }
+#endif
+        } else {
+            XIODevice::prefetchFile(&m_file, nPos, nSize);
+        }
+    }
+}
+
+qint64 XMappedDevice::readData(char *pData, qint64 nMaxSize)
+{
+    qint64 nResult = readAt(pos(), pData, nMaxSize);
+
+    if (nResult < 0) {
+        nResult = 0;
+    }
+
+    return nResult;
+}
+
+qint64 XMappedDevice::writeData(const char *pData, qint64 nMaxSize)
+{
+    Q_UNUSED(pData)
+    Q_UNUSED(nMaxSize)
+
+    return -1;
+}
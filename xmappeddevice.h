@@ -0,0 +1,57 @@
+/* Copyright (c) 2017-2026 hors<horsicq@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef XMAPPEDDEVICE_H
+#define XMAPPEDDEVICE_H
+
+#include <QFile>
+
+#include "xiodevice.h"
+
+// Read-only file device backed by a memory mapping.
+// If the file cannot be mapped, reads fall back to positional reads on the file handle.
+class XMappedDevice : public XIODevice {
+    Q_OBJECT
+
+public:
+    explicit XMappedDevice(const QString &sFileName, QObject *pParent = nullptr);
+    ~XMappedDevice();
+
+    QString getFileName() const;
+    virtual const char *getMemory() const;
+    bool isMapped() const;
+
+    virtual bool open(OpenMode mode);
+    virtual void close();
+
+    virtual bool isPositional() const;
+    virtual qint64 readAt(qint64 nPos, char *pData, qint64 nMaxSize);
+    virtual void prefetch(qint64 nPos, qint64 nSize);
+
+protected:
+    virtual qint64 readData(char *pData, qint64 nMaxSize);
+    virtual qint64 writeData(const char *pData, qint64 nMaxSize);
+
+private:
+    QFile m_file;
+    uchar *m_pMemory;
+};
+
+#endif  // XMAPPEDDEVICE_H
@@ -0,0 +1,367 @@
+/* Copyright (c) 2017-2026 hors<horsicq@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "xoverlaydevice.h"
+
+XOverlayDevice::XOverlayDevice(QIODevice *pBaseDevice, QObject *pParent) : XIODevice(pParent)
+{
+    m_pBaseDevice = pBaseDevice;
+    m_nBaseSize = pBaseDevice->size();
+
+    setSize(m_nBaseSize);
+}
+
+XOverlayDevice::~XOverlayDevice()
+{
+    if (isOpen()) {
+        close();
+    }
+}
+
+QIODevice *XOverlayDevice::getBaseDevice()
+{
+    return m_pBaseDevice;
+}
+
+bool XOverlayDevice::open(OpenMode mode)
+{
+    bool bResult = false;
+
+    if (isOpen()) {
+        close();
+    }
+
+    if (m_pBaseDevice->isReadable()) {
+        // Writes must reach writeData() immediately so that readAt() sees them
+        bResult = XIODevice::open(mode | QIODevice::Unbuffered);
+    }
+
+    return bResult;
+}
+
+bool XOverlayDevice::isPositional() const
+{
+    return (XIODevice::getDeviceMemory(m_pBaseDevice) || XIODevice::getPositionalDevice(m_pBaseDevice));
+}
+
+qint64 XOverlayDevice::readAt(qint64 nPos, char *pData, qint64 nMaxSize)
+{
+    qint64 nResult = -1;
+
+    if (nPos >= 0) {
+        QReadLocker locker(&m_lock);
+
+        nMaxSize = qMin(nMaxSize, size() - nPos);
+
+        if (nMaxSize > 0) {
+            qint64 nBaseSize = qMax(qMin(nMaxSize, m_nBaseSize - nPos), (qint64)0);
+
+            if ((nBaseSize == 0) || (_readBase(nPos, pData, nBaseSize) == nBaseSize)) {
+                // Space added by resize() reads as zeros
+                if (nBaseSize < nMaxSize) {
+                    memset(pData + nBaseSize, 0, nMaxSize - nBaseSize);
+                }
+
+                const QMap<qint64, QByteArray> &mapExtents = m_mapExtents;
+
+                QMap<qint64, QByteArray>::const_iterator iExtent = mapExtents.upperBound(nPos);
+
+                if (iExtent != mapExtents.constBegin()) {
+                    iExtent--;
+                }
+
+                qint64 nEnd = nPos + nMaxSize;
+
+                for (; (iExtent != mapExtents.constEnd()) && (iExtent.key() < nEnd); iExtent++) {
+                    qint64 nStart = qMax(iExtent.key(), nPos);
+                    qint64 nStop = qMin(iExtent.key() + iExtent.value().size(), nEnd);
+
+                    if (nStart < nStop) {
+                        memcpy(pData + (nStart - nPos), iExtent.value().constData() + (nStart - iExtent.key()), nStop - nStart);
+                    }
+                }
+
+                nResult = nMaxSize;
+            }
+        } else {
+            nResult = 0;
+        }
+    }
+
+    return nResult;
+}
+
+void XOverlayDevice::prefetch(qint64 nPos, qint64 nSize)
+{
+    if (nPos >= 0) {
+        nSize = qMin(nSize, m_nBaseSize - nPos);
+
+        if (nSize > 0) {
+            XIODevice::prefetchDevice(m_pBaseDevice, nPos, nSize);
+        }
+    }
+}
+
+bool XOverlayDevice::resize(qint64 nSize)
+{
+    bool bResult = false;
+
+    if (nSize >= 0) {
+        QWriteLocker locker(&m_lock);
+
+        if (nSize < size()) {
+            m_nBaseSize = qMin(m_nBaseSize, nSize);
+
+            QMap<qint64, QByteArray>::iterator iExtent = m_mapExtents.lowerBound(nSize);
+
+            while (iExtent != m_mapExtents.end()) {
+                iExtent = m_mapExtents.erase(iExtent);
+            }
+
+            if (!m_mapExtents.isEmpty()) {
+                iExtent = m_mapExtents.end();
+                iExtent--;
+
+                if (iExtent.key() + iExtent.value().size() > nSize) {
+                    iExtent.value().truncate(nSize - iExtent.key());
+                }
+            }
+        }
+
+        setSize(nSize);
+
+        bResult = true;
+    }
+
+    return bResult;
+}
+
+bool XOverlayDevice::isModified()
+{
+    QReadLocker locker(&m_lock);
+
+    return (!m_mapExtents.isEmpty()) || (m_nBaseSize != m_pBaseDevice->size()) || (size() != m_pBaseDevice->size());
+}
+
+qint32 XOverlayDevice::getNumberOfExtents()
+{
+    QReadLocker locker(&m_lock);
+
+    return m_mapExtents.count();
+}
+
+qint64 XOverlayDevice::getPatchSize()
+{
+    qint64 nResult = 0;
+
+    QReadLocker locker(&m_lock);
+
+    const QMap<qint64, QByteArray> &mapExtents = m_mapExtents;
+
+    for (QMap<qint64, QByteArray>::const_iterator iExtent = mapExtents.constBegin(); iExtent != mapExtents.constEnd(); iExtent++) {
+        nResult += iExtent.value().size();
+    }
+
+    return nResult;
+}
+
+qint32 XOverlayDevice::createSnapshot()
+{
+    QWriteLocker locker(&m_lock);
+
+    SNAPSHOT snapshot = {};
+    snapshot.mapExtents = m_mapExtents;  // Implicitly shared, copied only on the next write
+    snapshot.nSize = size();
+    snapshot.nBaseSize = m_nBaseSize;
+
+    m_listSnapshots.append(snapshot);
+
+    return m_listSnapshots.count() - 1;
+}
+
+bool XOverlayDevice::rollback(qint32 nSnapshot)
+{
+    bool bResult = false;
+
+    QWriteLocker locker(&m_lock);
+
+    if ((nSnapshot >= 0) && (nSnapshot < m_listSnapshots.count())) {
+        SNAPSHOT snapshot = m_listSnapshots.at(nSnapshot);
+
+        m_mapExtents = snapshot.mapExtents;
+        m_nBaseSize = snapshot.nBaseSize;
+        setSize(snapshot.nSize);
+
+        // Later snapshots are discarded; the restored one can be used again
+        while (m_listSnapshots.count() > nSnapshot + 1) {
+            m_listSnapshots.removeLast();
+        }
+
+        bResult = true;
+    }
+
+    return bResult;
+}
+
+void XOverlayDevice::discardChanges()
+{
+    QWriteLocker locker(&m_lock);
+
+    m_mapExtents.clear();
+    m_listSnapshots.clear();
+    m_nBaseSize = m_pBaseDevice->size();
+    setSize(m_nBaseSize);
+}
+
+bool XOverlayDevice::saveToDevice(QIODevice *pDevice)
+{
+    bool bResult = true;
+
+    const qint64 N_BUFFER_SIZE = 0x10000;
+
+    char *pBuffer = new char[N_BUFFER_SIZE];
+
+    qint64 nTotalSize = size();
+
+    for (qint64 nOffset = 0; (nOffset < nTotalSize) && bResult; nOffset += N_BUFFER_SIZE) {
+        qint64 nCurrentSize = qMin(N_BUFFER_SIZE, nTotalSize - nOffset);
+
+        if ((readAt(nOffset, pBuffer, nCurrentSize) != nCurrentSize) || (pDevice->write(pBuffer, nCurrentSize) != nCurrentSize)) {
+            bResult = false;
+        }
+    }
+
+    delete[] pBuffer;
+
+    return bResult;
+}
+
+bool XOverlayDevice::saveToFile(const QString &sFileName)
+{
+    bool bResult = false;
+
+    // The file must not be the base device: it is read while being written
+    QFile file(sFileName);
+
+    if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        bResult = saveToDevice(&file);
+
+        file.close();
+    }
+
+    return bResult;
+}
+
+qint64 XOverlayDevice::readData(char *pData, qint64 nMaxSize)
+{
+    qint64 nResult = readAt(pos(), pData, nMaxSize);
+
+    return nResult;
+}
+
+qint64 XOverlayDevice::writeData(const char *pData, qint64 nMaxSize)
+{
+    qint64 nResult = -1;
+
+    nMaxSize = qMin(nMaxSize, size() - pos());
+
+    if (nMaxSize > 0) {
+        _writeExtent(pos(), pData, nMaxSize);
+
+        nResult = nMaxSize;
+    } else if (nMaxSize == 0) {
+        nResult = 0;
+    }
+
+    return nResult;
+}
+
+qint64 XOverlayDevice::_readBase(qint64 nPos, char *pData, qint64 nSize)
+{
+    qint64 nResult = -1;
+
+    const char *pMemory = XIODevice::getDeviceMemory(m_pBaseDevice);
+
+    if (pMemory) {
+        memcpy(pData, pMemory + nPos, nSize);
+        nResult = nSize;
+    } else {
+        XIODevice *pPositionalDevice = XIODevice::getPositionalDevice(m_pBaseDevice);
+
+        if (pPositionalDevice) {
+            nResult = pPositionalDevice->readAt(nPos, pData, nSize);
+        } else if (m_pBaseDevice->seek(nPos)) {
+            nResult = m_pBaseDevice->read(pData, nSize);
+        }
+    }
+
+    return nResult;
+}
+
+void XOverlayDevice::_writeExtent(qint64 nPos, const char *pData, qint64 nSize)
+{
+    QWriteLocker locker(&m_lock);
+
+    qint64 nStart = nPos;
+    qint64 nEnd = nPos + nSize;
+
+    // Extents that overlap or touch the new data are merged into one
+    QList<qint64> listMerge;
+
+    const QMap<qint64, QByteArray> &mapExtents = m_mapExtents;
+
+    QMap<qint64, QByteArray>::const_iterator iExtent = mapExtents.upperBound(nPos);
+
+    if (iExtent != mapExtents.constBegin()) {
+        iExtent--;
+    }
+
+    for (; (iExtent != mapExtents.constEnd()) && (iExtent.key() <= nEnd); iExtent++) {
+        qint64 nExtentEnd = iExtent.key() + iExtent.value().size();
+
+        if (nExtentEnd >= nPos) {
+            listMerge.append(iExtent.key());
+            nStart = qMin(nStart, iExtent.key());
+            nEnd = qMax(nEnd, nExtentEnd);
+        }
+    }
+
+    if ((listMerge.count() == 1) && (listMerge.at(0) == nStart) && (nEnd == nStart + mapExtents.value(nStart).size())) {
+        // Inside an existing extent: patch in place
+        QByteArray &baExtent = m_mapExtents[nStart];
+
+        memcpy(baExtent.data() + (nPos - nStart), pData, nSize);
+    } else {
+        QByteArray baExtent;
+        baExtent.resize(nEnd - nStart);
+
+        qint32 nNumberOfExtents = listMerge.count();
+
+        for (qint32 i = 0; i < nNumberOfExtents; i++) {
+            QByteArray baOld = m_mapExtents.take(listMerge.at(i));
+
+            memcpy(baExtent.data() + (listMerge.at(i) - nStart), baOld.constData(), baOld.size());
+        }
+
+        memcpy(baExtent.data() + (nPos - nStart), pData, nSize);
+
+        m_mapExtents.insert(nStart, baExtent);
+    }
+}
@@ -0,0 +1,84 @@
+/* Copyright (c) 2017-2026 hors<horsicq@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef XOVERLAYDEVICE_H
+#define XOVERLAYDEVICE_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QList>
+#include <QMap>
+#include <QReadWriteLock>
+
+#include "xiodevice.h"
+
+// Copy-on-write device over an immutable base device.
+// Writes are kept as sorted, non-overlapping extents; the base device is never modified.
+// Snapshots share extent data with the current state, so taking one costs O(number of extents).
+class XOverlayDevice : public XIODevice {
+    Q_OBJECT
+
+public:
+    explicit XOverlayDevice(QIODevice *pBaseDevice, QObject *pParent = nullptr);
+    ~XOverlayDevice();
+
+    QIODevice *getBaseDevice();
+
+    virtual bool open(OpenMode mode);
+
+    virtual bool isPositional() const;
+    virtual qint64 readAt(qint64 nPos, char *pData, qint64 nMaxSize);
+    virtual void prefetch(qint64 nPos, qint64 nSize);
+
+    bool resize(qint64 nSize);
+
+    bool isModified();
+    qint32 getNumberOfExtents();
+    qint64 getPatchSize();
+
+    qint32 createSnapshot();
+    bool rollback(qint32 nSnapshot);
+    void discardChanges();
+
+    bool saveToDevice(QIODevice *pDevice);
+    bool saveToFile(const QString &sFileName);
+
+protected:
+    virtual qint64 readData(char *pData, qint64 nMaxSize);
+    virtual qint64 writeData(const char *pData, qint64 nMaxSize);
+
+private:
+    struct SNAPSHOT {
+        QMap<qint64, QByteArray> mapExtents;
+        qint64 nSize;
+        qint64 nBaseSize;
+    };
+
+    qint64 _readBase(qint64 nPos, char *pData, qint64 nSize);
+    void _writeExtent(qint64 nPos, const char *pData, qint64 nSize);
+
+    QIODevice *m_pBaseDevice;
+    qint64 m_nBaseSize;  // Bytes of the base device that are still visible after resize()
+    QMap<qint64, QByteArray> m_mapExtents;  // offset -> data
+    QList<SNAPSHOT> m_listSnapshots;
+    QReadWriteLock m_lock;
+};
+
+#endif  // XOVERLAYDEVICE_H
@@ -0,0 +1,329 @@
+/* Copyright (c) 2017-2026 hors<horsicq@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "xpagecache.h"
+
+struct _XPAGECACHE_REGISTRY {
+    QMutex mutex;
+    QList<XPageCache *> listCaches;
+};
+
+static _XPAGECACHE_REGISTRY *_x_getPageCacheRegistry()
+{
+    static _XPAGECACHE_REGISTRY registry;
+
+    return &registry;
+}
+
+XPageCache::XPageCache(qint32 nPageSize, qint32 nMaxPages)
+{
+    if (nPageSize <= 0) {
+        nPageSize = 0x10000;
+    }
+
+    if (nMaxPages <= 0) {
+        nMaxPages = 1;
+    }
+
+    m_nPageSize = nPageSize;
+    m_nMaxPages = nMaxPages;
+    m_nTick = 0;
+    m_nLastPage = -1;
+    m_stats = {};
+
+    _XPAGECACHE_REGISTRY *pRegistry = _x_getPageCacheRegistry();
+
+    pRegistry->mutex.lock();
+    pRegistry->listCaches.append(this);
+    pRegistry->mutex.unlock();
+}
+
+XPageCache::~XPageCache()
+{
+    _XPAGECACHE_REGISTRY *pRegistry = _x_getPageCacheRegistry();
+
+    pRegistry->mutex.lock();
+    pRegistry->listCaches.removeOne(this);
+    pRegistry->mutex.unlock();
+}
+
+qint32 XPageCache::getPageSize() const
+{
+    return m_nPageSize;
+}
+
+qint32 XPageCache::getMaxPages() const
+{
+    return m_nMaxPages;
+}
+
+qint64 XPageCache::read(QIODevice *pDevice, qint64 nPos, char *pData, qint64 nMaxLen)
+{
+    qint64 nResult = 0;
+
+    if (pDevice && (nPos >= 0) && (nMaxLen > 0) && isDeviceCacheable(pDevice)) {
+        m_mutex.lock();
+
+        while (nMaxLen > 0) {
+            qint64 nIndex = nPos / m_nPageSize;
+            qint64 nDelta = nPos % m_nPageSize;
+
+            qint32 nPage = _getPage(pDevice, nIndex);
+
+            if (nPage == -1) {
+                break;
+            }
+
+            const PAGE &page = m_listPages.at(nPage);
+
+            qint64 nCurrentSize = qMin(nMaxLen, page.nSize - nDelta);
+
+            if (nCurrentSize <= 0) {
+                break;
+            }
+
+            memcpy(pData, page.baData.constData() + nDelta, (size_t)nCurrentSize);
+
+            nPos += nCurrentSize;
+            pData += nCurrentSize;
+            nMaxLen -= nCurrentSize;
+            nResult += nCurrentSize;
+
+            if (page.nSize < m_nPageSize) {
+                // EOF
+                break;
+            }
+        }
+
+        m_mutex.unlock();
+    }
+
+    return nResult;
+}
+
+bool XPageCache::getPage(QIODevice *pDevice, qint64 nPos, qint64 nSize, QByteArray *pbaPage, qint64 *pnDelta)
+{
+    bool bResult = false;
+
+    if (pDevice && (nPos >= 0) && (nSize > 0) && isDeviceCacheable(pDevice)) {
+        qint64 nIndex = nPos / m_nPageSize;
+        qint64 nDelta = nPos % m_nPageSize;
+
+        if (nDelta + nSize <= m_nPageSize) {
+            m_mutex.lock();
+
+            qint32 nPage = _getPage(pDevice, nIndex);
+
+            if ((nPage != -1) && (nDelta + nSize <= m_listPages.at(nPage).nSize)) {
+                // Shared copy keeps the page alive after eviction
+                *pbaPage = m_listPages.at(nPage).baData;
+                *pnDelta = nDelta;
+
+                bResult = true;
+            }
+
+            m_mutex.unlock();
+        }
+    }
+
+    return bResult;
+}
+
+void XPageCache::invalidate(QIODevice *pDevice, qint64 nPos, qint64 nSize)
+{
+    m_mutex.lock();
+
+    qint64 nFirst = nPos / m_nPageSize;
+    qint64 nLast = (nPos + qMax(nSize, (qint64)1) - 1) / m_nPageSize;
+
+    for (qint32 i = m_listPages.count() - 1; i >= 0; i--) {
+        const PAGE &page = m_listPages.at(i);
+
+        if ((page.pDevice == pDevice) && (page.nIndex >= nFirst) && (page.nIndex <= nLast)) {
+            m_listPages.remove(i);
+        }
+    }
+
+    m_nLastPage = -1;
+
+    m_mutex.unlock();
+}
+
+void XPageCache::invalidate(QIODevice *pDevice)
+{
+    m_mutex.lock();
+
+    for (qint32 i = m_listPages.count() - 1; i >= 0; i--) {
+        if (m_listPages.at(i).pDevice == pDevice) {
+            m_listPages.remove(i);
+        }
+    }
+
+    m_stDevices.remove(pDevice);
+
+    m_nLastPage = -1;
+
+    m_mutex.unlock();
+}
+
+void XPageCache::clear()
+{
+    m_mutex.lock();
+
+    m_listPages.clear();
+    m_nLastPage = -1;
+
+    m_mutex.unlock();
+}
+
+void XPageCache::removeDevice(QIODevice *pDevice)
+{
+    // A new device can get the address of a destroyed one, and a resized device has other data
+    _XPAGECACHE_REGISTRY *pRegistry = _x_getPageCacheRegistry();
+
+    pRegistry->mutex.lock();
+
+    qint32 nNumberOfCaches = pRegistry->listCaches.count();
+
+    for (qint32 i = 0; i < nNumberOfCaches; i++) {
+        pRegistry->listCaches.at(i)->invalidate(pDevice);
+    }
+
+    pRegistry->mutex.unlock();
+}
+
+bool XPageCache::isDeviceCacheable(QIODevice *pDevice)
+{
+    bool bResult = false;
+
+    // A subdevice shows the data of its parents, so they must not be writable either
+    while (pDevice && (!pDevice->isWritable())) {
+        SubDevice *pSubDevice = dynamic_cast<SubDevice *>(pDevice);
+
+        if (pSubDevice) {
+            pDevice = pSubDevice->getOrigDevice();
+        } else {
+            bResult = true;
+            break;
+        }
+    }
+
+    return bResult;
+}
+
+XPageCache::STATS XPageCache::getStats()
+{
+    m_mutex.lock();
+
+    STATS result = m_stats;
+
+    m_mutex.unlock();
+
+    return result;
+}
+
+void XPageCache::resetStats()
+{
+    m_mutex.lock();
+
+    m_stats = {};
+
+    m_mutex.unlock();
+}
+
+qint32 XPageCache::_getPage(QIODevice *pDevice, qint64 nIndex)
+{
+    qint32 nResult = -1;
+
+    if ((m_nLastPage != -1) && (m_listPages.at(m_nLastPage).pDevice == pDevice) && (m_listPages.at(m_nLastPage).nIndex == nIndex)) {
+        nResult = m_nLastPage;
+    } else {
+        qint32 nNumberOfPages = m_listPages.count();
+
+        for (qint32 i = 0; i < nNumberOfPages; i++) {
+            if ((m_listPages.at(i).pDevice == pDevice) && (m_listPages.at(i).nIndex == nIndex)) {
+                nResult = i;
+                break;
+            }
+        }
+    }
+
+    if (nResult != -1) {
+        m_stats.nHits++;
+    } else {
+        m_stats.nMisses++;
+
+        if (!m_stDevices.contains(pDevice)) {
+            m_stDevices.insert(pDevice);
+
+            QObject::connect(pDevice, &QObject::destroyed, [](QObject *pObject) { XPageCache::removeDevice((QIODevice *)pObject); });
+        }
+
+        PAGE page = {};
+        page.pDevice = pDevice;
+        page.nIndex = nIndex;
+
+        qint64 nOffset = nIndex * m_nPageSize;
+        qint64 nSize = qMin((qint64)m_nPageSize, pDevice->size() - nOffset);
+
+        XIODevice *pPositionalDevice = XIODevice::getPositionalDevice(pDevice);
+
+        if ((nSize > 0) && (pPositionalDevice || pDevice->seek(nOffset))) {
+            page.baData.resize((qint32)nSize);
+
+            if (pPositionalDevice) {
+                page.nSize = pPositionalDevice->readAt(nOffset, page.baData.data(), nSize);
+            } else {
+                page.nSize = pDevice->read(page.baData.data(), nSize);
+            }
+
+            m_stats.nDeviceReads++;
+
+            if (page.nSize > 0) {
+                m_stats.nDeviceBytes += page.nSize;
+
+                if (m_listPages.count() < m_nMaxPages) {
+                    m_listPages.append(page);
+                    nResult = m_listPages.count() - 1;
+                } else {
+                    // Evict the least recently used page
+                    qint32 nNumberOfPages = m_listPages.count();
+                    nResult = 0;
+
+                    for (qint32 i = 1; i < nNumberOfPages; i++) {
+                        if (m_listPages.at(i).nTick < m_listPages.at(nResult).nTick) {
+                            nResult = i;
+                        }
+                    }
+
+                    m_listPages[nResult] = page;
+                }
+            }
+        }
+    }
+
+    if (nResult != -1) {
+        m_listPages[nResult].nTick = ++m_nTick;
+    }
+
+    m_nLastPage = nResult;
+
+    return nResult;
+}
@@ -0,0 +1,84 @@
+/* Copyright (c) 2017-2026 hors<horsicq@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef XPAGECACHE_H
+#define XPAGECACHE_H
+
+#include <QByteArray>
+#include <QIODevice>
+#include <QMutex>
+#include <QSet>
+#include <QVector>
+
+#include "subdevice.h"
+
+// Small LRU block cache for devices that cannot be mapped.
+// One instance can be shared by several XBinary objects.
+// Pages of a device are dropped from all caches when it is destroyed or resized (removeDevice).
+// Only devices that are not open for writing are cached (isDeviceCacheable); writes through other objects would not be seen.
+class XPageCache {
+public:
+    struct STATS {
+        quint64 nHits;
+        quint64 nMisses;
+        quint64 nDeviceReads;
+        quint64 nDeviceBytes;
+    };
+
+    explicit XPageCache(qint32 nPageSize = 0x10000, qint32 nMaxPages = 16);
+    ~XPageCache();
+
+    qint32 getPageSize() const;
+    qint32 getMaxPages() const;
+
+    qint64 read(QIODevice *pDevice, qint64 nPos, char *pData, qint64 nMaxLen);
+    bool getPage(QIODevice *pDevice, qint64 nPos, qint64 nSize, QByteArray *pbaPage, qint64 *pnDelta);
+    void invalidate(QIODevice *pDevice, qint64 nPos, qint64 nSize);
+    void invalidate(QIODevice *pDevice);
+    void clear();
+
+    static void removeDevice(QIODevice *pDevice);
+    static bool isDeviceCacheable(QIODevice *pDevice);
+
+    STATS getStats();
+    void resetStats();
+
+private:
+    struct PAGE {
+        QIODevice *pDevice;
+        qint64 nIndex;
+        qint64 nSize;
+        quint64 nTick;
+        QByteArray baData;
+    };
+
+    qint32 _getPage(QIODevice *pDevice, qint64 nIndex);
+
+    qint32 m_nPageSize;
+    qint32 m_nMaxPages;
+    quint64 m_nTick;
+    qint32 m_nLastPage;
+    QVector<PAGE> m_listPages;
+    QSet<QIODevice *> m_stDevices;  // Devices watched for destruction
+    STATS m_stats;
+    QMutex m_mutex;
+};
+
+#endif  // XPAGECACHE_H
@@ -965,6 +965,43 @@ xsimd_int64 xsimd_find_null_byte(const void* pBuffer, xsimd_int64 nSize)
     return -1;
 }
 
+xsimd_int64 xsimd_find_null_word(const void* pBuffer, xsimd_int64 nSize)
+{
+    const xsimd_uint8* pData = (const xsimd_uint8*)pBuffer;
+    xsimd_int64 i = 0;
+    
+    nSize &= ~(xsimd_int64)1;
+    
+    if (!g_bInitialized) {
+        xsimd_init();
+    }
+    
+#ifdef XSIMD_X86
+    xsimd_int64 nResult;
+    
+    if (g_nEnabledFeatures & XSIMD_FEATURE_AVX2) {
+        nResult = _xsimd_find_null_word_AVX2(pData, nSize, &i);
+        if (nResult != -1) {
+            return nResult;
+        }
+    } else if (g_nEnabledFeatures & XSIMD_FEATURE_SSE2) {
+        nResult = _xsimd_find_null_word_SSE2(pData, nSize, &i);
+        if (nResult != -1) {
+            return nResult;
+        }
+    }
+#endif
+    
+    /* Scalar fallback */
+    for (; i < nSize; i += 2) {
+        if ((pData[i] == 0) && (pData[i + 1] == 0)) {
+            return i;
+        }
+    }
+    
+    return -1;
+}
+
 xsimd_int64 xsimd_count_unicode_prefix(const void* pBuffer, xsimd_int64 nSize)
 {
     const xsimd_uint16* pData = (const xsimd_uint16*)pBuffer;
@@ -1015,6 +1052,202 @@ int xsimd_is_valid_unicode(const void* pBuffer, xsimd_int64 nSize)
     return (nValidBytes == nSize) ? 1 : 0;
 }
 
+static int _xsimd_is_unicode_symbol(const xsimd_uint8* pData, xsimd_uint8 nMinChar, int bIsBigEndian)
+{
+    xsimd_uint8 nLow = bIsBigEndian ? pData[1] : pData[0];
+    xsimd_uint8 nHigh = bIsBigEndian ? pData[0] : pData[1];
+    
+    return ((nHigh == 0) && (nLow >= nMinChar)) || (nHigh == 0x04);
+}
+
+xsimd_int64 xsimd_find_unicode_symbol(const void* pBuffer, xsimd_int64 nSize, xsimd_uint8 nMinChar, int bIsBigEndian)
+{
+    const xsimd_uint8* pData = (const xsimd_uint8*)pBuffer;
+    xsimd_int64 i = 0;
+    
+    if (!g_bInitialized) {
+        xsimd_init();
+    }
+    
+#ifdef XSIMD_X86
+    xsimd_int64 nResult = -1;
+    
+    if (g_nEnabledFeatures & XSIMD_FEATURE_AVX2) {
+        nResult = _xsimd_find_unicode_symbol_AVX2(pData, nSize, nMinChar, bIsBigEndian, &i);
+    } else if (g_nEnabledFeatures & XSIMD_FEATURE_SSE2) {
+        nResult = _xsimd_find_unicode_symbol_SSE2(pData, nSize, nMinChar, bIsBigEndian, &i);
+    }
+    
+    if (nResult != -1) {
+        return nResult;
+    }
+#endif
+    
+    /* Scalar fallback */
+    for (; i + 2 <= nSize; i++) {
+        if (_xsimd_is_unicode_symbol(pData + i, nMinChar, bIsBigEndian)) {
+            return i;
+        }
+    }
+    
+    return -1;
+}
+
+xsimd_int64 xsimd_count_unicode_run(const void* pBuffer, xsimd_int64 nSize, xsimd_uint8 nMinChar, int bIsBigEndian)
+{
+    const xsimd_uint8* pData = (const xsimd_uint8*)pBuffer;
+    xsimd_int64 i = 0;
+    
+    if (!g_bInitialized) {
+        xsimd_init();
+    }
+    
+#ifdef XSIMD_X86
+    xsimd_int64 nResult = -1;
+    
+    if (g_nEnabledFeatures & XSIMD_FEATURE_AVX2) {
+        nResult = _xsimd_count_unicode_run_AVX2(pData, nSize, nMinChar, bIsBigEndian, &i);
+    } else if (g_nEnabledFeatures & XSIMD_FEATURE_SSE2) {
+        nResult = _xsimd_count_unicode_run_SSE2(pData, nSize, nMinChar, bIsBigEndian, &i);
+    }
+    
+    if (nResult != -1) {
+        return nResult;
+    }
+#endif
+    
+    /* Scalar fallback; the code unit at i + 1 needs byte i + 2 */
+    for (; i + 3 <= nSize; i += 2) {
+        if ((!_xsimd_is_unicode_symbol(pData + i, nMinChar, bIsBigEndian)) || _xsimd_is_unicode_symbol(pData + i + 1, nMinChar, bIsBigEndian)) {
+            break;
+        }
+    }
+    
+    return i / 2;
+}
+
+/* Size of the well-formed UTF-8 sequence at pData, 0 if it is invalid or cut by the end of buffer */
+static xsimd_int64 _xsimd_get_utf8_sequence_size(const xsimd_uint8* pData, xsimd_int64 nSize)
+{
+    xsimd_uint8 nLead = pData[0];
+    xsimd_uint8 nSecondMin = 0x80;
+    xsimd_uint8 nSecondMax = 0xBF;
+    xsimd_int64 nSequenceSize = 0;
+    xsimd_int64 j;
+    
+    if (nLead >= 0xC2 && nLead <= 0xDF) {
+        nSequenceSize = 2;
+    } else if (nLead >= 0xE0 && nLead <= 0xEF) {
+        nSequenceSize = 3;
+        
+        if (nLead == 0xE0) {
+            nSecondMin = 0xA0;  /* Overlong */
+        } else if (nLead == 0xED) {
+            nSecondMax = 0x9F;  /* Surrogates */
+        }
+    } else if (nLead >= 0xF0 && nLead <= 0xF4) {
+        nSequenceSize = 4;
+        
+        if (nLead == 0xF0) {
+            nSecondMin = 0x90;  /* Overlong */
+        } else if (nLead == 0xF4) {
+            nSecondMax = 0x8F;  /* Above 0x10FFFF */
+        }
+    } else {
+        return 0;
+    }
+    
+    if (nSequenceSize > nSize) {
+        return 0;
+    }
+    
+    if (pData[1] < nSecondMin || pData[1] > nSecondMax) {
+        return 0;
+    }
+    
+    for (j = 2; j < nSequenceSize; j++) {
+        if ((pData[j] & 0xC0) != 0x80) {
+            return 0;
+        }
+    }
+    
+    return nSequenceSize;
+}
+
+xsimd_int64 xsimd_count_utf8_prefix(const void* pBuffer, xsimd_int64 nSize, xsimd_int64* pnChars, xsimd_int64* pnMultiByteChars, xsimd_int64* pnControlChars)
+{
+    const xsimd_uint8* pData = (const xsimd_uint8*)pBuffer;
+    xsimd_int64 nChars = 0;
+    xsimd_int64 nMultiByteChars = 0;
+    xsimd_int64 nControlChars = 0;
+    xsimd_int64 i = 0;
+    int bIsValid = 1;
+    
+    if (!g_bInitialized) {
+        xsimd_init();
+    }
+    
+    while (bIsValid && (i < nSize)) {
+        /* ASCII blocks with SIMD, then up to one block of mixed text byte by byte */
+        xsimd_int64 nBlockEnd;
+        
+#ifdef XSIMD_X86
+        xsimd_int64 nStart = i;
+        
+        if (g_nEnabledFeatures & XSIMD_FEATURE_AVX2) {
+            _xsimd_skip_ascii_text_AVX2(pData, nSize, &i, &nControlChars);
+        } else if (g_nEnabledFeatures & XSIMD_FEATURE_SSE2) {
+            _xsimd_skip_ascii_text_SSE2(pData, nSize, &i, &nControlChars);
+        }
+        
+        nChars += i - nStart;
+#endif
+        
+        nBlockEnd = (nSize - i > 32) ? (i + 32) : nSize;
+        
+        while (i < nBlockEnd) {
+            xsimd_uint8 nByte = pData[i];
+            
+            if (nByte == 0) {
+                bIsValid = 0;
+                break;
+            } else if (nByte < 0x80) {
+                if (nByte < 0x20 && nByte != 0x09 && nByte != 0x0A && nByte != 0x0D) {
+                    nControlChars++;
+                }
+                
+                nChars++;
+                i++;
+            } else {
+                xsimd_int64 nSequenceSize = _xsimd_get_utf8_sequence_size(pData + i, nSize - i);
+                
+                if (nSequenceSize == 0) {
+                    bIsValid = 0;
+                    break;
+                }
+                
+                nChars++;
+                nMultiByteChars++;
+                i += nSequenceSize;
+            }
+        }
+    }
+    
+    if (pnChars) {
+        *pnChars = nChars;
+    }
+    
+    if (pnMultiByteChars) {
+        *pnMultiByteChars = nMultiByteChars;
+    }
+    
+    if (pnControlChars) {
+        *pnControlChars = nControlChars;
+    }
+    
+    return i;
+}
+
 xsimd_int64 xsimd_count_char(const void* pBuffer, xsimd_int64 nSize, xsimd_uint8 nByte)
 {
     const xsimd_uint8* pData = (const xsimd_uint8*)pBuffer;
@@ -1088,6 +1321,190 @@ xsimd_int64 xsimd_create_ansi_mask(const void* pBuffer, xsimd_int64 nSize, void*
     return nAnsiCount;
 }
 
+void xsimd_bswap16(void* pBuffer, xsimd_int64 nCount)
+{
+    xsimd_uint8* pData = (xsimd_uint8*)pBuffer;
+    xsimd_int64 i = 0;
+    
+    if (!g_bInitialized) {
+        xsimd_init();
+    }
+    
+#ifdef XSIMD_X86
+    if (g_nEnabledFeatures & XSIMD_FEATURE_AVX2) {
+        _xsimd_bswap16_AVX2(pData, nCount, &i);
+    } else if (g_nEnabledFeatures & XSIMD_FEATURE_SSE2) {
+        _xsimd_bswap16_SSE2(pData, nCount, &i);
+    }
+#endif
+    
+    /* Scalar fallback */
+    for (; i < nCount; i++) {
+        xsimd_uint8* p = pData + i * 2;
+        xsimd_uint8 nTemp = p[0];
+        p[0] = p[1];
+        p[1] = nTemp;
+    }
+}
+
+void xsimd_bswap32(void* pBuffer, xsimd_int64 nCount)
+{
+    xsimd_uint8* pData = (xsimd_uint8*)pBuffer;
+    xsimd_int64 i = 0;
+    
+    if (!g_bInitialized) {
+        xsimd_init();
+    }
+    
+#ifdef XSIMD_X86
+    if (g_nEnabledFeatures & XSIMD_FEATURE_AVX2) {
+        _xsimd_bswap32_AVX2(pData, nCount, &i);
+    } else if (g_nEnabledFeatures & XSIMD_FEATURE_SSE2) {
+        _xsimd_bswap32_SSE2(pData, nCount, &i);
+    }
+#endif
+    
+    /* Scalar fallback */
+    for (; i < nCount; i++) {
+        xsimd_uint8* p = pData + i * 4;
+        xsimd_uint8 nTemp = p[0];
+        p[0] = p[3];
+        p[3] = nTemp;
+        nTemp = p[1];
+        p[1] = p[2];
+        p[2] = nTemp;
+    }
+}
+
+void xsimd_bswap64(void* pBuffer, xsimd_int64 nCount)
+{
+    xsimd_uint8* pData = (xsimd_uint8*)pBuffer;
+    xsimd_int64 i = 0;
+    
+    if (!g_bInitialized) {
+        xsimd_init();
+    }
+    
+#ifdef XSIMD_X86
+    if (g_nEnabledFeatures & XSIMD_FEATURE_AVX2) {
+        _xsimd_bswap64_AVX2(pData, nCount, &i);
+    } else if (g_nEnabledFeatures & XSIMD_FEATURE_SSE2) {
+        _xsimd_bswap64_SSE2(pData, nCount, &i);
+    }
+#endif
+    
+    /* Scalar fallback */
+    for (; i < nCount; i++) {
+        xsimd_uint8* p = pData + i * 8;
+        int j;
+        for (j = 0; j < 4; j++) {
+            xsimd_uint8 nTemp = p[j];
+            p[j] = p[7 - j];
+            p[7 - j] = nTemp;
+        }
+    }
+}
+
+int xsimd_compare_masked(const void* pBuffer, const void* pPattern, const void* pMask, xsimd_int64 nSize)
+{
+    const xsimd_uint8* pData = (const xsimd_uint8*)pBuffer;
+    const xsimd_uint8* pPatternData = (const xsimd_uint8*)pPattern;
+    const xsimd_uint8* pMaskData = (const xsimd_uint8*)pMask;
+    xsimd_int64 i = 0;
+    
+    if (!g_bInitialized) {
+        xsimd_init();
+    }
+    
+#ifdef XSIMD_X86
+    if (g_nEnabledFeatures & XSIMD_FEATURE_AVX2) {
+        if (!_xsimd_compare_masked_AVX2(pData, pPatternData, pMaskData, nSize, &i)) {
+            return 0;
+        }
+    } else if (g_nEnabledFeatures & XSIMD_FEATURE_SSE2) {
+        if (!_xsimd_compare_masked_SSE2(pData, pPatternData, pMaskData, nSize, &i)) {
+            return 0;
+        }
+    }
+#endif
+    
+    /* Scalar fallback */
+    for (; i < nSize; i++) {
+        if ((pData[i] ^ pPatternData[i]) & pMaskData[i]) {
+            return 0;
+        }
+    }
+    
+    return 1;
+}
+
+xsimd_int64 xsimd_find_pattern_masked(const void* pBuffer, xsimd_int64 nBufferSize, const void* pPattern, const void* pMask, xsimd_int64 nPatternSize,
+                                      xsimd_int64 nOffset)
+{
+    if (nPatternSize == 0 || nBufferSize < nPatternSize) {
+        return -1;
+    }
+    
+    const xsimd_uint8* pData = (const xsimd_uint8*)pBuffer;
+    const xsimd_uint8* pPatternData = (const xsimd_uint8*)pPattern;
+    const xsimd_uint8* pMaskData = (const xsimd_uint8*)pMask;
+    const xsimd_int64 nLimit = nBufferSize - nPatternSize;
+    xsimd_int64 nFirst = -1;
+    xsimd_int64 nLast = -1;
+    xsimd_int64 i = 0;
+    xsimd_int64 j = 0;
+    
+    if (!g_bInitialized) {
+        xsimd_init();
+    }
+    
+    /* Anchor bytes: the first and the last byte that are compared without a wildcard */
+    for (j = 0; j < nPatternSize; j++) {
+        if (pMaskData[j] == 0xFF) {
+            if (nFirst == -1) {
+                nFirst = j;
+            }
+            nLast = j;
+        }
+    }
+    
+#ifdef XSIMD_X86
+    if (nFirst != -1) {
+        xsimd_int64 nResult = -1;
+        
+        if (g_nEnabledFeatures & XSIMD_FEATURE_AVX2) {
+            nResult = _xsimd_find_pattern_masked_AVX2(pData, nBufferSize, pPatternData, pMaskData, nPatternSize, nFirst, nLast, &i);
+        } else if (g_nEnabledFeatures & XSIMD_FEATURE_SSE2) {
+            nResult = _xsimd_find_pattern_masked_SSE2(pData, nBufferSize, pPatternData, pMaskData, nPatternSize, nFirst, nLast, &i);
+        }
+        
+        if (nResult != -1) {
+            return nOffset + nResult;
+        }
+        /* SIMD didn't find it, continue with scalar fallback from position i */
+    }
+#endif
+    
+    /* Scalar fallback */
+    for (; i <= nLimit; i++) {
+        if ((nFirst != -1) && (pData[i + nFirst] != pPatternData[nFirst])) {
+            continue;
+        }
+        
+        for (j = 0; j < nPatternSize; j++) {
+            if ((pData[i + j] ^ pPatternData[j]) & pMaskData[j]) {
+                break;
+            }
+        }
+        
+        if (j == nPatternSize) {
+            return nOffset + i;
+        }
+    }
+    
+    return -1;
+}
+
 void xsimd_cleanup(void)
 {
     g_bInitialized = 0;
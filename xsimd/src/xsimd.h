@@ -285,6 +285,15 @@ xsimd_int64 xsimd_count_ansi_prefix(const void* pBuffer, xsimd_int64 nSize);
  */
 xsimd_int64 xsimd_find_null_byte(const void* pBuffer, xsimd_int64 nSize);
 
+/**
+ * Find first null 16-bit code unit (0x0000) in buffer (optimized with SIMD)
+ * Useful for finding null-termination in UTF-16 strings
+ * @param pBuffer Buffer to search in
+ * @param nSize Size of buffer in bytes (odd trailing byte is ignored)
+ * @return Byte offset of first null code unit (always even), or -1 if not found
+ */
+xsimd_int64 xsimd_find_null_word(const void* pBuffer, xsimd_int64 nSize);
+
 /**
  * Count consecutive valid Unicode characters from start of buffer (UTF-16 LE)
  * Validates 16-bit characters: 0x0020-0x00FF and Cyrillic 0x0400-0x04FF
@@ -304,6 +313,42 @@ xsimd_int64 xsimd_count_unicode_prefix(const void* pBuffer, xsimd_int64 nSize);
  */
 int xsimd_is_valid_unicode(const void* pBuffer, xsimd_int64 nSize);
 
+/**
+ * Find the first UTF-16 string symbol starting at any byte offset (optimized with SIMD)
+ * A symbol is a code unit in nMinChar-0x00FF or Cyrillic 0x0400-0x04FF
+ * @param pBuffer Buffer to search in (no alignment required)
+ * @param nSize Size of buffer in bytes
+ * @param nMinChar Lowest accepted code unit below 0x0100
+ * @param bIsBigEndian 1 for UTF-16 BE, 0 for UTF-16 LE
+ * @return Byte offset of the first symbol, or -1 if not found
+ */
+xsimd_int64 xsimd_find_unicode_symbol(const void* pBuffer, xsimd_int64 nSize, xsimd_uint8 nMinChar, int bIsBigEndian);
+
+/**
+ * Count leading UTF-16 symbols that cannot be read as symbols at the odd byte offsets in between
+ * Code units at even offsets 0, 2, ... must be symbols (as in xsimd_find_unicode_symbol)
+ * and the code units at odd offsets 1, 3, ... must not be; this is a plain UTF-16 string of one byte parity
+ * @param pBuffer Buffer to scan (no alignment required)
+ * @param nSize Size of buffer in bytes
+ * @param nMinChar Lowest accepted code unit below 0x0100
+ * @param bIsBigEndian 1 for UTF-16 BE, 0 for UTF-16 LE
+ * @return Number of code units; the last counted unit is followed by at least one more byte
+ */
+xsimd_int64 xsimd_count_unicode_run(const void* pBuffer, xsimd_int64 nSize, xsimd_uint8 nMinChar, int bIsBigEndian);
+
+/**
+ * Validate UTF-8 text (optimized with SIMD for ASCII blocks)
+ * Accepts well-formed sequences only (RFC 3629: no overlong forms, surrogates or code points above 0x10FFFF)
+ * and stops at the first null byte, invalid sequence or sequence cut by the end of buffer
+ * @param pBuffer Buffer to scan
+ * @param nSize Size of buffer
+ * @param pnChars Output: number of characters in the valid prefix (can be NULL)
+ * @param pnMultiByteChars Output: number of multi-byte characters in the valid prefix (can be NULL)
+ * @param pnControlChars Output: number of ASCII control characters other than TAB, LF and CR (can be NULL)
+ * @return Size of the valid prefix in bytes (nSize if the whole buffer is valid)
+ */
+xsimd_int64 xsimd_count_utf8_prefix(const void* pBuffer, xsimd_int64 nSize, xsimd_int64* pnChars, xsimd_int64* pnMultiByteChars, xsimd_int64* pnControlChars);
+
 /**
  * Count occurrences of specific byte value in buffer (optimized with SIMD)
  * @param pBuffer Buffer to scan
@@ -323,6 +368,52 @@ xsimd_int64 xsimd_count_char(const void* pBuffer, xsimd_int64 nSize, xsimd_uint8
  */
 xsimd_int64 xsimd_create_ansi_mask(const void* pBuffer, xsimd_int64 nSize, void* pMask);
 
+/**
+ * Reverse byte order of 16-bit values in place (optimized with SIMD)
+ * @param pBuffer Buffer of values (no alignment required)
+ * @param nCount Number of 16-bit values
+ */
+void xsimd_bswap16(void* pBuffer, xsimd_int64 nCount);
+
+/**
+ * Reverse byte order of 32-bit values in place (optimized with SIMD)
+ * @param pBuffer Buffer of values (no alignment required)
+ * @param nCount Number of 32-bit values
+ */
+void xsimd_bswap32(void* pBuffer, xsimd_int64 nCount);
+
+/**
+ * Reverse byte order of 64-bit values in place (optimized with SIMD)
+ * @param pBuffer Buffer of values (no alignment required)
+ * @param nCount Number of 64-bit values
+ */
+void xsimd_bswap64(void* pBuffer, xsimd_int64 nCount);
+
+/**
+ * Compare memory with a masked pattern (optimized with SIMD)
+ * A byte matches when (buffer ^ pattern) & mask is zero, so a 0x00 mask byte is a wildcard
+ * @param pBuffer Buffer to check
+ * @param pPattern Pattern bytes
+ * @param pMask Mask bytes (same size as pattern)
+ * @param nSize Size to compare
+ * @return 1 if equal under the mask, 0 if different
+ */
+int xsimd_compare_masked(const void* pBuffer, const void* pPattern, const void* pMask, xsimd_int64 nSize);
+
+/**
+ * Find masked pattern (optimized with SIMD)
+ * Candidates are filtered on the first and last fully masked bytes, then verified with one masked vector compare
+ * @param pBuffer Haystack buffer
+ * @param nBufferSize Haystack size
+ * @param pPattern Pattern bytes
+ * @param pMask Mask bytes (same size as pattern, 0x00 is a wildcard)
+ * @param nPatternSize Pattern size
+ * @param nOffset Base offset (added to result)
+ * @return Offset of first occurrence, or -1 if not found
+ */
+xsimd_int64 xsimd_find_pattern_masked(const void* pBuffer, xsimd_int64 nBufferSize, const void* pPattern, const void* pMask, xsimd_int64 nPatternSize,
+                                      xsimd_int64 nOffset);
+
 /**
  * Cleanup library resources
  */
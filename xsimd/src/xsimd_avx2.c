@@ -1208,6 +1208,33 @@ xsimd_int64 _xsimd_find_null_byte_AVX2(const xsimd_uint8* pData, xsimd_int64 nSi
     return -1;
 }
 
+xsimd_int64 _xsimd_find_null_word_AVX2(const xsimd_uint8* pData, xsimd_int64 nSize, xsimd_int64* pi)
+{
+#ifdef XSIMD_X86
+    __m256i vZero = _mm256_setzero_si256();
+    xsimd_int64 i = *pi;
+    
+    for (; i + 32 <= nSize; i += 32) {
+        __m256i vData = _mm256_loadu_si256((const __m256i*)(pData + i));
+        __m256i vCmp = _mm256_cmpeq_epi16(vData, vZero);
+        xsimd_uint32 nMask = _mm256_movemask_epi8(vCmp);
+        
+        if (nMask != 0) {
+            unsigned long nBitPos;
+#ifdef _MSC_VER
+            _BitScanForward(&nBitPos, nMask);
+#else
+            nBitPos = __builtin_ctz(nMask);
+#endif
+            return i + nBitPos;
+        }
+    }
+    
+    *pi = i;
+#endif
+    return -1;
+}
+
 xsimd_int64 _xsimd_count_unicode_prefix_AVX2(const xsimd_uint16* pData, xsimd_int64 nChars, xsimd_int64* pi)
 {
 #ifdef XSIMD_X86
@@ -1305,3 +1332,267 @@ void _xsimd_create_ansi_mask_AVX2(const xsimd_uint8* pData, xsimd_int64 nSize, x
 #endif
 }
 
+
+#ifdef XSIMD_X86
+static void _xsimd_bswap_AVX2(xsimd_uint8* pData, xsimd_int64 nSize, __m256i vMask, xsimd_int64* pnProcessed)
+{
+    xsimd_int64 i = 0;
+    
+    for (; i + 32 <= nSize; i += 32) {
+        __m256i vData = _mm256_loadu_si256((const __m256i*)(pData + i));
+        _mm256_storeu_si256((__m256i*)(pData + i), _mm256_shuffle_epi8(vData, vMask));
+    }
+    
+    *pnProcessed = i;
+}
+#endif
+
+void _xsimd_bswap16_AVX2(xsimd_uint8* pData, xsimd_int64 nCount, xsimd_int64* pi)
+{
+#ifdef XSIMD_X86
+    xsimd_int64 nProcessed = 0;
+    __m256i vMask = _mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14, 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+    
+    _xsimd_bswap_AVX2(pData + *pi * 2, (nCount - *pi) * 2, vMask, &nProcessed);
+    
+    *pi += nProcessed / 2;
+#endif
+}
+
+void _xsimd_bswap32_AVX2(xsimd_uint8* pData, xsimd_int64 nCount, xsimd_int64* pi)
+{
+#ifdef XSIMD_X86
+    xsimd_int64 nProcessed = 0;
+    __m256i vMask = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    
+    _xsimd_bswap_AVX2(pData + *pi * 4, (nCount - *pi) * 4, vMask, &nProcessed);
+    
+    *pi += nProcessed / 4;
+#endif
+}
+
+void _xsimd_bswap64_AVX2(xsimd_uint8* pData, xsimd_int64 nCount, xsimd_int64* pi)
+{
+#ifdef XSIMD_X86
+    xsimd_int64 nProcessed = 0;
+    __m256i vMask = _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+    
+    _xsimd_bswap_AVX2(pData + *pi * 8, (nCount - *pi) * 8, vMask, &nProcessed);
+    
+    *pi += nProcessed / 8;
+#endif
+}
+
+#ifdef XSIMD_X86
+static int _xsimd_match_masked_AVX2(const xsimd_uint8* pData, const xsimd_uint8* pPattern, const xsimd_uint8* pMask, xsimd_int64 nSize)
+{
+    xsimd_int64 i = 0;
+    
+    for (; i + 32 <= nSize; i += 32) {
+        __m256i vData = _mm256_loadu_si256((const __m256i*)(pData + i));
+        __m256i vPattern = _mm256_loadu_si256((const __m256i*)(pPattern + i));
+        __m256i vMask = _mm256_loadu_si256((const __m256i*)(pMask + i));
+        __m256i vDiff = _mm256_and_si256(_mm256_xor_si256(vData, vPattern), vMask);
+        
+        if (!_mm256_testz_si256(vDiff, vDiff)) {
+            return 0;
+        }
+    }
+    
+    for (; i < nSize; i++) {
+        if ((pData[i] ^ pPattern[i]) & pMask[i]) {
+            return 0;
+        }
+    }
+    
+    return 1;
+}
+#endif
+
+int _xsimd_compare_masked_AVX2(const xsimd_uint8* pData, const xsimd_uint8* pPattern, const xsimd_uint8* pMask, xsimd_int64 nSize, xsimd_int64* pi)
+{
+#ifdef XSIMD_X86
+    xsimd_int64 i = *pi;
+    
+    /* Process 32 bytes per iteration, the tail is left to the caller */
+    for (; i + 32 <= nSize; i += 32) {
+        __m256i vData = _mm256_loadu_si256((const __m256i*)(pData + i));
+        __m256i vPattern = _mm256_loadu_si256((const __m256i*)(pPattern + i));
+        __m256i vMask = _mm256_loadu_si256((const __m256i*)(pMask + i));
+        __m256i vDiff = _mm256_and_si256(_mm256_xor_si256(vData, vPattern), vMask);
+        
+        if (!_mm256_testz_si256(vDiff, vDiff)) {
+            *pi = i;
+            return 0;
+        }
+    }
+    
+    *pi = i;
+#endif
+    return 1;
+}
+
+xsimd_int64 _xsimd_find_pattern_masked_AVX2(const xsimd_uint8* pData, xsimd_int64 nBufferSize, const xsimd_uint8* pPattern, const xsimd_uint8* pMask,
+                                            xsimd_int64 nPatternSize, xsimd_int64 nFirst, xsimd_int64 nLast, xsimd_int64* pi)
+{
+#ifdef XSIMD_X86
+    xsimd_int64 i = *pi;
+    const xsimd_int64 nLimit = nBufferSize - nPatternSize;
+    __m256i vFirst = _mm256_set1_epi8((char)pPattern[nFirst]);
+    __m256i vLast = _mm256_set1_epi8((char)pPattern[nLast]);
+    __m256i vPattern = _mm256_setzero_si256();
+    __m256i vMask = _mm256_setzero_si256();
+    int bIsWhole = (nPatternSize <= 32);
+    
+    if (bIsWhole) {
+        /* Signatures up to one vector are verified with a single compare; padding bytes are wildcards */
+        xsimd_uint8 bufPattern[32] = {0};
+        xsimd_uint8 bufMask[32] = {0};
+        memcpy(bufPattern, pPattern, (size_t)nPatternSize);
+        memcpy(bufMask, pMask, (size_t)nPatternSize);
+        vPattern = _mm256_loadu_si256((const __m256i*)bufPattern);
+        vMask = _mm256_loadu_si256((const __m256i*)bufMask);
+    }
+    
+    /* Candidates must match both anchor bytes; the last load ends at nLimit + 31 + nLast < nBufferSize + 31 */
+    for (; i + 31 <= nLimit; i += 32) {
+        __m256i vCmpFirst = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(pData + i + nFirst)), vFirst);
+        __m256i vCmpLast = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(pData + i + nLast)), vLast);
+        xsimd_uint32 nTempMask = (xsimd_uint32)_mm256_movemask_epi8(_mm256_and_si256(vCmpFirst, vCmpLast));
+        
+        while (nTempMask != 0) {
+#ifdef _MSC_VER
+            unsigned long bit;
+            _BitScanForward(&bit, nTempMask);
+#else
+            unsigned bit = __builtin_ctz(nTempMask);
+#endif
+            xsimd_int64 nCheckPos = i + (xsimd_int64)bit;
+            int bIsMatch = 0;
+            
+            if (bIsWhole && (nCheckPos + 32 <= nBufferSize)) {
+                __m256i vData = _mm256_loadu_si256((const __m256i*)(pData + nCheckPos));
+                __m256i vDiff = _mm256_and_si256(_mm256_xor_si256(vData, vPattern), vMask);
+                bIsMatch = _mm256_testz_si256(vDiff, vDiff);
+            } else {
+                bIsMatch = _xsimd_match_masked_AVX2(pData + nCheckPos, pPattern, pMask, nPatternSize);
+            }
+            
+            if (bIsMatch) {
+                *pi = nCheckPos;
+                return nCheckPos;
+            }
+            
+            nTempMask &= nTempMask - 1;
+        }
+    }
+    
+    *pi = i;
+#endif
+    return -1;
+}
+
+#ifdef XSIMD_X86
+/* Marks the byte offsets k where the code unit formed by bytes k and k + 1 is a string symbol */
+static __m256i _xsimd_unicode_symbols_AVX2(const xsimd_uint8* pData, __m256i vMin, __m256i vZero, __m256i vFour, int bIsBigEndian)
+{
+    __m256i vFirst = _mm256_loadu_si256((const __m256i*)pData);
+    __m256i vSecond = _mm256_loadu_si256((const __m256i*)(pData + 1));
+    __m256i vLow = bIsBigEndian ? vSecond : vFirst;
+    __m256i vHigh = bIsBigEndian ? vFirst : vSecond;
+    __m256i vLatin = _mm256_and_si256(_mm256_cmpeq_epi8(vHigh, vZero), _mm256_cmpeq_epi8(_mm256_max_epu8(vLow, vMin), vLow));
+    
+    return _mm256_or_si256(vLatin, _mm256_cmpeq_epi8(vHigh, vFour));
+}
+#endif
+
+xsimd_int64 _xsimd_find_unicode_symbol_AVX2(const xsimd_uint8* pData, xsimd_int64 nSize, xsimd_uint8 nMinChar, int bIsBigEndian, xsimd_int64* pi)
+{
+#ifdef XSIMD_X86
+    __m256i vMin = _mm256_set1_epi8((char)nMinChar);
+    __m256i vZero = _mm256_setzero_si256();
+    __m256i vFour = _mm256_set1_epi8(4);
+    xsimd_int64 i = *pi;
+    
+    /* The second load reads one byte ahead */
+    for (; i + 32 + 1 <= nSize; i += 32) {
+        xsimd_uint32 nMask = (xsimd_uint32)_mm256_movemask_epi8(_xsimd_unicode_symbols_AVX2(pData + i, vMin, vZero, vFour, bIsBigEndian));
+        
+        if (nMask) {
+#ifdef _MSC_VER
+            unsigned long nBitPos;
+            _BitScanForward(&nBitPos, (unsigned long)nMask);
+            return i + nBitPos;
+#else
+            return i + __builtin_ctz((unsigned int)nMask);
+#endif
+        }
+    }
+    
+    *pi = i;
+#endif
+    return -1;
+}
+
+xsimd_int64 _xsimd_count_unicode_run_AVX2(const xsimd_uint8* pData, xsimd_int64 nSize, xsimd_uint8 nMinChar, int bIsBigEndian, xsimd_int64* pi)
+{
+#ifdef XSIMD_X86
+    __m256i vMin = _mm256_set1_epi8((char)nMinChar);
+    __m256i vZero = _mm256_setzero_si256();
+    __m256i vFour = _mm256_set1_epi8(4);
+    xsimd_int64 i = *pi;
+    
+    /* Even offsets must be symbols and odd offsets must not; i stays even */
+    for (; i + 32 + 1 <= nSize; i += 32) {
+        xsimd_uint32 nMask = (xsimd_uint32)_mm256_movemask_epi8(_xsimd_unicode_symbols_AVX2(pData + i, vMin, vZero, vFour, bIsBigEndian));
+        xsimd_uint32 nDiff = nMask ^ 0x55555555;
+        
+        if (nDiff) {
+#ifdef _MSC_VER
+            unsigned long nBitPos;
+            _BitScanForward(&nBitPos, (unsigned long)nDiff);
+            return (i + nBitPos) / 2;
+#else
+            return (i + __builtin_ctz((unsigned int)nDiff)) / 2;
+#endif
+        }
+    }
+    
+    *pi = i;
+#endif
+    return -1;
+}
+
+void _xsimd_skip_ascii_text_AVX2(const xsimd_uint8* pData, xsimd_int64 nSize, xsimd_int64* pi, xsimd_int64* pnControlChars)
+{
+#ifdef XSIMD_X86
+    __m256i vZero = _mm256_setzero_si256();
+    __m256i vSpace = _mm256_set1_epi8(0x20);
+    __m256i vTab = _mm256_set1_epi8(0x09);
+    __m256i vLF = _mm256_set1_epi8(0x0A);
+    __m256i vCR = _mm256_set1_epi8(0x0D);
+    xsimd_int64 i = *pi;
+    xsimd_int64 nControlChars = *pnControlChars;
+    
+    /* Stops at the first block with a byte >= 0x80 or a null byte */
+    for (; i + 32 <= nSize; i += 32) {
+        __m256i vData = _mm256_loadu_si256((const __m256i*)(pData + i));
+        
+        if (_mm256_movemask_epi8(_mm256_or_si256(vData, _mm256_cmpeq_epi8(vData, vZero)))) {
+            break;
+        }
+        
+        /* All bytes are below 0x80 here, so the signed compare is exact */
+        __m256i vWhite = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(vData, vTab), _mm256_cmpeq_epi8(vData, vLF)), _mm256_cmpeq_epi8(vData, vCR));
+        xsimd_uint32 nControl = (xsimd_uint32)_mm256_movemask_epi8(_mm256_andnot_si256(vWhite, _mm256_cmpgt_epi8(vSpace, vData)));
+        
+        while (nControl) {
+            nControl &= nControl - 1;
+            nControlChars++;
+        }
+    }
+    
+    *pi = i;
+    *pnControlChars = nControlChars;
+#endif
+}
@@ -50,9 +50,19 @@ xsimd_int64 _xsimd_find_ansi_number_AVX2(const unsigned char* hay, xsimd_int64 h
 int _xsimd_is_ansi_number_AVX2(const char* ptr, xsimd_int64 nSize);
 xsimd_int64 _xsimd_find_first_non_ansi_AVX2(const xsimd_uint8* pData, xsimd_int64 i, xsimd_int64 nSize);
 xsimd_int64 _xsimd_find_null_byte_AVX2(const xsimd_uint8* pData, xsimd_int64 nSize, xsimd_int64* pi);
+xsimd_int64 _xsimd_find_null_word_AVX2(const xsimd_uint8* pData, xsimd_int64 nSize, xsimd_int64* pi);
 xsimd_int64 _xsimd_count_unicode_prefix_AVX2(const xsimd_uint16* pData, xsimd_int64 nChars, xsimd_int64* pi);
 void _xsimd_count_char_AVX2(const xsimd_uint8* pData, xsimd_int64 nSize, xsimd_uint8 nByte, xsimd_int64* pi, xsimd_int64* pnCount);
 void _xsimd_create_ansi_mask_AVX2(const xsimd_uint8* pData, xsimd_int64 nSize, xsimd_uint8* pMaskData, xsimd_int64* pi, xsimd_int64* pnAnsiCount);
+void _xsimd_bswap16_AVX2(xsimd_uint8* pData, xsimd_int64 nCount, xsimd_int64* pi);
+void _xsimd_bswap32_AVX2(xsimd_uint8* pData, xsimd_int64 nCount, xsimd_int64* pi);
+void _xsimd_bswap64_AVX2(xsimd_uint8* pData, xsimd_int64 nCount, xsimd_int64* pi);
+int _xsimd_compare_masked_AVX2(const xsimd_uint8* pData, const xsimd_uint8* pPattern, const xsimd_uint8* pMask, xsimd_int64 nSize, xsimd_int64* pi);
+xsimd_int64 _xsimd_find_pattern_masked_AVX2(const xsimd_uint8* pData, xsimd_int64 nBufferSize, const xsimd_uint8* pPattern, const xsimd_uint8* pMask,
+                                            xsimd_int64 nPatternSize, xsimd_int64 nFirst, xsimd_int64 nLast, xsimd_int64* pi);
+xsimd_int64 _xsimd_find_unicode_symbol_AVX2(const xsimd_uint8* pData, xsimd_int64 nSize, xsimd_uint8 nMinChar, int bIsBigEndian, xsimd_int64* pi);
+xsimd_int64 _xsimd_count_unicode_run_AVX2(const xsimd_uint8* pData, xsimd_int64 nSize, xsimd_uint8 nMinChar, int bIsBigEndian, xsimd_int64* pi);
+void _xsimd_skip_ascii_text_AVX2(const xsimd_uint8* pData, xsimd_int64 nSize, xsimd_int64* pi, xsimd_int64* pnControlChars);
 
 #ifdef __cplusplus
 }
@@ -1449,6 +1449,33 @@ xsimd_int64 _xsimd_find_null_byte_SSE2(const xsimd_uint8* pData, xsimd_int64 nSi
     return -1;
 }
 
+xsimd_int64 _xsimd_find_null_word_SSE2(const xsimd_uint8* pData, xsimd_int64 nSize, xsimd_int64* pi)
+{
+#ifdef XSIMD_X86
+    __m128i vZero = _mm_setzero_si128();
+    xsimd_int64 i = *pi;
+    
+    for (; i + 16 <= nSize; i += 16) {
+        __m128i vData = _mm_loadu_si128((const __m128i*)(pData + i));
+        __m128i vCmp = _mm_cmpeq_epi16(vData, vZero);
+        xsimd_uint16 nMask = _mm_movemask_epi8(vCmp);
+        
+        if (nMask != 0) {
+            unsigned long nBitPos;
+#ifdef _MSC_VER
+            _BitScanForward(&nBitPos, nMask);
+#else
+            nBitPos = __builtin_ctz(nMask);
+#endif
+            return i + nBitPos;
+        }
+    }
+    
+    *pi = i;
+#endif
+    return -1;
+}
+
 xsimd_int64 _xsimd_count_unicode_prefix_SSE2(const xsimd_uint16* pData, xsimd_int64 nChars, xsimd_int64* pi)
 {
 #ifdef XSIMD_X86
@@ -1544,3 +1571,274 @@ void _xsimd_create_ansi_mask_SSE2(const xsimd_uint8* pData, xsimd_int64 nSize, x
 #endif
 }
 
+
+#ifdef XSIMD_X86
+/* SSE2 has no byte shuffle, so values are swapped with 16-bit shuffles and shifts */
+static __inline __m128i _xsimd_bswap16_vector_SSE2(__m128i vData)
+{
+    return _mm_or_si128(_mm_slli_epi16(vData, 8), _mm_srli_epi16(vData, 8));
+}
+#endif
+
+void _xsimd_bswap16_SSE2(xsimd_uint8* pData, xsimd_int64 nCount, xsimd_int64* pi)
+{
+#ifdef XSIMD_X86
+    xsimd_int64 i = *pi;
+    
+    for (; i + 8 <= nCount; i += 8) {
+        __m128i vData = _mm_loadu_si128((const __m128i*)(pData + i * 2));
+        _mm_storeu_si128((__m128i*)(pData + i * 2), _xsimd_bswap16_vector_SSE2(vData));
+    }
+    
+    *pi = i;
+#endif
+}
+
+void _xsimd_bswap32_SSE2(xsimd_uint8* pData, xsimd_int64 nCount, xsimd_int64* pi)
+{
+#ifdef XSIMD_X86
+    xsimd_int64 i = *pi;
+    
+    for (; i + 4 <= nCount; i += 4) {
+        __m128i vData = _mm_loadu_si128((const __m128i*)(pData + i * 4));
+        vData = _mm_shufflelo_epi16(vData, 0xB1);
+        vData = _mm_shufflehi_epi16(vData, 0xB1);
+        _mm_storeu_si128((__m128i*)(pData + i * 4), _xsimd_bswap16_vector_SSE2(vData));
+    }
+    
+    *pi = i;
+#endif
+}
+
+void _xsimd_bswap64_SSE2(xsimd_uint8* pData, xsimd_int64 nCount, xsimd_int64* pi)
+{
+#ifdef XSIMD_X86
+    xsimd_int64 i = *pi;
+    
+    for (; i + 2 <= nCount; i += 2) {
+        __m128i vData = _mm_loadu_si128((const __m128i*)(pData + i * 8));
+        vData = _mm_shufflelo_epi16(vData, 0x1B);
+        vData = _mm_shufflehi_epi16(vData, 0x1B);
+        _mm_storeu_si128((__m128i*)(pData + i * 8), _xsimd_bswap16_vector_SSE2(vData));
+    }
+    
+    *pi = i;
+#endif
+}
+
+#ifdef XSIMD_X86
+static int _xsimd_match_masked_SSE2(const xsimd_uint8* pData, const xsimd_uint8* pPattern, const xsimd_uint8* pMask, xsimd_int64 nSize)
+{
+    xsimd_int64 i = 0;
+    __m128i vZero = _mm_setzero_si128();
+    
+    for (; i + 16 <= nSize; i += 16) {
+        __m128i vData = _mm_loadu_si128((const __m128i*)(pData + i));
+        __m128i vPattern = _mm_loadu_si128((const __m128i*)(pPattern + i));
+        __m128i vMask = _mm_loadu_si128((const __m128i*)(pMask + i));
+        __m128i vDiff = _mm_and_si128(_mm_xor_si128(vData, vPattern), vMask);
+        
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(vDiff, vZero)) != 0xFFFF) {
+            return 0;
+        }
+    }
+    
+    for (; i < nSize; i++) {
+        if ((pData[i] ^ pPattern[i]) & pMask[i]) {
+            return 0;
+        }
+    }
+    
+    return 1;
+}
+#endif
+
+int _xsimd_compare_masked_SSE2(const xsimd_uint8* pData, const xsimd_uint8* pPattern, const xsimd_uint8* pMask, xsimd_int64 nSize, xsimd_int64* pi)
+{
+#ifdef XSIMD_X86
+    xsimd_int64 i = *pi;
+    __m128i vZero = _mm_setzero_si128();
+    
+    /* Process 16 bytes per iteration, the tail is left to the caller */
+    for (; i + 16 <= nSize; i += 16) {
+        __m128i vData = _mm_loadu_si128((const __m128i*)(pData + i));
+        __m128i vPattern = _mm_loadu_si128((const __m128i*)(pPattern + i));
+        __m128i vMask = _mm_loadu_si128((const __m128i*)(pMask + i));
+        __m128i vDiff = _mm_and_si128(_mm_xor_si128(vData, vPattern), vMask);
+        
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(vDiff, vZero)) != 0xFFFF) {
+            *pi = i;
+            return 0;
+        }
+    }
+    
+    *pi = i;
+#endif
+    return 1;
+}
+
+xsimd_int64 _xsimd_find_pattern_masked_SSE2(const xsimd_uint8* pData, xsimd_int64 nBufferSize, const xsimd_uint8* pPattern, const xsimd_uint8* pMask,
+                                            xsimd_int64 nPatternSize, xsimd_int64 nFirst, xsimd_int64 nLast, xsimd_int64* pi)
+{
+#ifdef XSIMD_X86
+    xsimd_int64 i = *pi;
+    const xsimd_int64 nLimit = nBufferSize - nPatternSize;
+    __m128i vZero = _mm_setzero_si128();
+    __m128i vFirst = _mm_set1_epi8((char)pPattern[nFirst]);
+    __m128i vLast = _mm_set1_epi8((char)pPattern[nLast]);
+    __m128i vPattern = vZero;
+    __m128i vMask = vZero;
+    int bIsWhole = (nPatternSize <= 16);
+    
+    if (bIsWhole) {
+        /* Signatures up to one vector are verified with a single compare; padding bytes are wildcards */
+        xsimd_uint8 bufPattern[16] = {0};
+        xsimd_uint8 bufMask[16] = {0};
+        memcpy(bufPattern, pPattern, (size_t)nPatternSize);
+        memcpy(bufMask, pMask, (size_t)nPatternSize);
+        vPattern = _mm_loadu_si128((const __m128i*)bufPattern);
+        vMask = _mm_loadu_si128((const __m128i*)bufMask);
+    }
+    
+    /* Candidates must match both anchor bytes; the last load ends at nLimit + 15 + nLast < nBufferSize + 15 */
+    for (; i + 15 <= nLimit; i += 16) {
+        __m128i vCmpFirst = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(pData + i + nFirst)), vFirst);
+        __m128i vCmpLast = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(pData + i + nLast)), vLast);
+        xsimd_uint32 nTempMask = (xsimd_uint32)_mm_movemask_epi8(_mm_and_si128(vCmpFirst, vCmpLast));
+        
+        while (nTempMask != 0) {
+#ifdef _MSC_VER
+            unsigned long bit;
+            _BitScanForward(&bit, nTempMask);
+#else
+            unsigned bit = __builtin_ctz(nTempMask);
+#endif
+            xsimd_int64 nCheckPos = i + (xsimd_int64)bit;
+            int bIsMatch = 0;
+            
+            if (bIsWhole && (nCheckPos + 16 <= nBufferSize)) {
+                __m128i vData = _mm_loadu_si128((const __m128i*)(pData + nCheckPos));
+                __m128i vDiff = _mm_and_si128(_mm_xor_si128(vData, vPattern), vMask);
+                bIsMatch = (_mm_movemask_epi8(_mm_cmpeq_epi8(vDiff, vZero)) == 0xFFFF);
+            } else {
+                bIsMatch = _xsimd_match_masked_SSE2(pData + nCheckPos, pPattern, pMask, nPatternSize);
+            }
+            
+            if (bIsMatch) {
+                *pi = nCheckPos;
+                return nCheckPos;
+            }
+            
+            nTempMask &= nTempMask - 1;
+        }
+    }
+    
+    *pi = i;
+#endif
+    return -1;
+}
+
+#ifdef XSIMD_X86
+/* Marks the byte offsets k where the code unit formed by bytes k and k + 1 is a string symbol */
+static __m128i _xsimd_unicode_symbols_SSE2(const xsimd_uint8* pData, __m128i vMin, __m128i vZero, __m128i vFour, int bIsBigEndian)
+{
+    __m128i vFirst = _mm_loadu_si128((const __m128i*)pData);
+    __m128i vSecond = _mm_loadu_si128((const __m128i*)(pData + 1));
+    __m128i vLow = bIsBigEndian ? vSecond : vFirst;
+    __m128i vHigh = bIsBigEndian ? vFirst : vSecond;
+    __m128i vLatin = _mm_and_si128(_mm_cmpeq_epi8(vHigh, vZero), _mm_cmpeq_epi8(_mm_max_epu8(vLow, vMin), vLow));
+    
+    return _mm_or_si128(vLatin, _mm_cmpeq_epi8(vHigh, vFour));
+}
+#endif
+
+xsimd_int64 _xsimd_find_unicode_symbol_SSE2(const xsimd_uint8* pData, xsimd_int64 nSize, xsimd_uint8 nMinChar, int bIsBigEndian, xsimd_int64* pi)
+{
+#ifdef XSIMD_X86
+    __m128i vMin = _mm_set1_epi8((char)nMinChar);
+    __m128i vZero = _mm_setzero_si128();
+    __m128i vFour = _mm_set1_epi8(4);
+    xsimd_int64 i = *pi;
+    
+    /* The second load reads one byte ahead */
+    for (; i + 16 + 1 <= nSize; i += 16) {
+        xsimd_uint32 nMask = (xsimd_uint32)_mm_movemask_epi8(_xsimd_unicode_symbols_SSE2(pData + i, vMin, vZero, vFour, bIsBigEndian));
+        
+        if (nMask) {
+#ifdef _MSC_VER
+            unsigned long nBitPos;
+            _BitScanForward(&nBitPos, (unsigned long)nMask);
+            return i + nBitPos;
+#else
+            return i + __builtin_ctz((unsigned int)nMask);
+#endif
+        }
+    }
+    
+    *pi = i;
+#endif
+    return -1;
+}
+
+xsimd_int64 _xsimd_count_unicode_run_SSE2(const xsimd_uint8* pData, xsimd_int64 nSize, xsimd_uint8 nMinChar, int bIsBigEndian, xsimd_int64* pi)
+{
+#ifdef XSIMD_X86
+    __m128i vMin = _mm_set1_epi8((char)nMinChar);
+    __m128i vZero = _mm_setzero_si128();
+    __m128i vFour = _mm_set1_epi8(4);
+    xsimd_int64 i = *pi;
+    
+    /* Even offsets must be symbols and odd offsets must not; i stays even */
+    for (; i + 16 + 1 <= nSize; i += 16) {
+        xsimd_uint32 nMask = (xsimd_uint32)_mm_movemask_epi8(_xsimd_unicode_symbols_SSE2(pData + i, vMin, vZero, vFour, bIsBigEndian));
+        xsimd_uint32 nDiff = nMask ^ 0x5555;
+        
+        if (nDiff) {
+#ifdef _MSC_VER
+            unsigned long nBitPos;
+            _BitScanForward(&nBitPos, (unsigned long)nDiff);
+            return (i + nBitPos) / 2;
+#else
+            return (i + __builtin_ctz((unsigned int)nDiff)) / 2;
+#endif
+        }
+    }
+    
+    *pi = i;
+#endif
+    return -1;
+}
+
+void _xsimd_skip_ascii_text_SSE2(const xsimd_uint8* pData, xsimd_int64 nSize, xsimd_int64* pi, xsimd_int64* pnControlChars)
+{
+#ifdef XSIMD_X86
+    __m128i vZero = _mm_setzero_si128();
+    __m128i vSpace = _mm_set1_epi8(0x20);
+    __m128i vTab = _mm_set1_epi8(0x09);
+    __m128i vLF = _mm_set1_epi8(0x0A);
+    __m128i vCR = _mm_set1_epi8(0x0D);
+    xsimd_int64 i = *pi;
+    xsimd_int64 nControlChars = *pnControlChars;
+    
+    /* Stops at the first block with a byte >= 0x80 or a null byte */
+    for (; i + 16 <= nSize; i += 16) {
+        __m128i vData = _mm_loadu_si128((const __m128i*)(pData + i));
+        
+        if (_mm_movemask_epi8(_mm_or_si128(vData, _mm_cmpeq_epi8(vData, vZero)))) {
+            break;
+        }
+        
+        /* All bytes are below 0x80 here, so the signed compare is exact */
+        __m128i vWhite = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(vData, vTab), _mm_cmpeq_epi8(vData, vLF)), _mm_cmpeq_epi8(vData, vCR));
+        xsimd_uint32 nControl = (xsimd_uint32)_mm_movemask_epi8(_mm_andnot_si128(vWhite, _mm_cmpgt_epi8(vSpace, vData)));
+        
+        while (nControl) {
+            nControl &= nControl - 1;
+            nControlChars++;
+        }
+    }
+    
+    *pi = i;
+    *pnControlChars = nControlChars;
+#endif
+}
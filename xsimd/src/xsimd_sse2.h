@@ -50,9 +50,19 @@ xsimd_int64 _xsimd_find_ansi_number_SSE2(const unsigned char* hay, xsimd_int64 h
 int _xsimd_is_ansi_number_SSE2(const char* ptr, xsimd_int64 nSize);
 xsimd_int64 _xsimd_find_first_non_ansi_SSE2(const xsimd_uint8* pData, xsimd_int64 i, xsimd_int64 nSize);
 xsimd_int64 _xsimd_find_null_byte_SSE2(const xsimd_uint8* pData, xsimd_int64 nSize, xsimd_int64* pi);
+xsimd_int64 _xsimd_find_null_word_SSE2(const xsimd_uint8* pData, xsimd_int64 nSize, xsimd_int64* pi);
 xsimd_int64 _xsimd_count_unicode_prefix_SSE2(const xsimd_uint16* pData, xsimd_int64 nChars, xsimd_int64* pi);
 void _xsimd_count_char_SSE2(const xsimd_uint8* pData, xsimd_int64 nSize, xsimd_uint8 nByte, xsimd_int64* pi, xsimd_int64* pnCount);
 void _xsimd_create_ansi_mask_SSE2(const xsimd_uint8* pData, xsimd_int64 nSize, xsimd_uint8* pMaskData, xsimd_int64* pi, xsimd_int64* pnAnsiCount);
+void _xsimd_bswap16_SSE2(xsimd_uint8* pData, xsimd_int64 nCount, xsimd_int64* pi);
+void _xsimd_bswap32_SSE2(xsimd_uint8* pData, xsimd_int64 nCount, xsimd_int64* pi);
+void _xsimd_bswap64_SSE2(xsimd_uint8* pData, xsimd_int64 nCount, xsimd_int64* pi);
+int _xsimd_compare_masked_SSE2(const xsimd_uint8* pData, const xsimd_uint8* pPattern, const xsimd_uint8* pMask, xsimd_int64 nSize, xsimd_int64* pi);
+xsimd_int64 _xsimd_find_pattern_masked_SSE2(const xsimd_uint8* pData, xsimd_int64 nBufferSize, const xsimd_uint8* pPattern, const xsimd_uint8* pMask,
+                                            xsimd_int64 nPatternSize, xsimd_int64 nFirst, xsimd_int64 nLast, xsimd_int64* pi);
+xsimd_int64 _xsimd_find_unicode_symbol_SSE2(const xsimd_uint8* pData, xsimd_int64 nSize, xsimd_uint8 nMinChar, int bIsBigEndian, xsimd_int64* pi);
+xsimd_int64 _xsimd_count_unicode_run_SSE2(const xsimd_uint8* pData, xsimd_int64 nSize, xsimd_uint8 nMinChar, int bIsBigEndian, xsimd_int64* pi);
+void _xsimd_skip_ascii_text_SSE2(const xsimd_uint8* pData, xsimd_int64 nSize, xsimd_int64* pi, xsimd_int64* pnControlChars);
 
 #ifdef __cplusplus
 }